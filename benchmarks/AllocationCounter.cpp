@@ -0,0 +1,51 @@
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "AllocationCounter.hpp"
+
+namespace {
+
+std::atomic<std::size_t> allocations { 0 };
+
+} // namespace
+
+auto operator new(std::size_t size) -> void*
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+
+    throw std::bad_alloc {};
+}
+
+auto operator delete(void* ptr) noexcept -> void
+{
+    std::free(ptr);
+}
+
+auto operator delete(void* ptr, std::size_t) noexcept -> void
+{
+    std::free(ptr);
+}
+
+namespace Oasis::Benchmarks {
+
+auto AllocationCount() -> std::size_t
+{
+    return allocations.load(std::memory_order_relaxed);
+}
+
+AllocationScope::AllocationScope()
+    : start(AllocationCount())
+{
+}
+
+auto AllocationScope::Count() const -> std::size_t
+{
+    return AllocationCount() - start;
+}
+
+} // Oasis::Benchmarks
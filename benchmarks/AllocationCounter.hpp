@@ -0,0 +1,35 @@
+#ifndef OASIS_ALLOCATIONCOUNTER_HPP
+#define OASIS_ALLOCATIONCOUNTER_HPP
+
+#include <cstddef>
+
+namespace Oasis::Benchmarks {
+
+/**
+ * Gets the number of calls made to the global `operator new` since the program started.
+ *
+ * @return The number of allocations made so far.
+ */
+auto AllocationCount() -> std::size_t;
+
+/**
+ * Counts the allocations made during its lifetime.
+ */
+class AllocationScope {
+public:
+    AllocationScope();
+
+    /**
+     * Gets the number of allocations made since this scope was created.
+     *
+     * @return The number of allocations made since this scope was created.
+     */
+    [[nodiscard]] auto Count() const -> std::size_t;
+
+private:
+    std::size_t start;
+};
+
+} // Oasis::Benchmarks
+
+#endif // OASIS_ALLOCATIONCOUNTER_HPP
@@ -0,0 +1,405 @@
+#include <array>
+#include <memory>
+#include <string>
+
+#include "catch2/benchmark/catch_benchmark.hpp"
+#include "catch2/catch_test_macros.hpp"
+
+#include "Oasis/Add.hpp"
+#include "Oasis/CompiledExpression.hpp"
+#include "Oasis/Divide.hpp"
+#include "Oasis/Exponent.hpp"
+#include "Oasis/ExpressionArena.hpp"
+#include "Oasis/ExpressionStore.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Negate.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Runtime.hpp"
+#include "Oasis/SimplifyCache.hpp"
+#include "Oasis/Subtract.hpp"
+#include "Oasis/Variable.hpp"
+
+#include "AllocationCounter.hpp"
+
+namespace {
+
+// Builds c_0 + c_1 * x^1 + ... + c_n * x^n as a balanced tree.
+auto MakePolynomial(int terms) -> std::unique_ptr<Oasis::Expression>
+{
+    std::vector<std::unique_ptr<Oasis::Expression>> ops;
+
+    for (int i = 0; i < terms; ++i) {
+        ops.emplace_back(Oasis::Multiply {
+            Oasis::Real { static_cast<double>(i + 1) },
+            Oasis::Exponent { Oasis::Variable { "x" }, Oasis::Real { static_cast<double>(i) } } }
+                             .Copy());
+    }
+
+    return Oasis::BuildFromVector<Oasis::Add>(ops);
+}
+
+} // namespace
+
+TEST_CASE("Copy Benchmarks", "[Benchmark]")
+{
+    const auto polynomial = MakePolynomial(256);
+
+    Oasis::Benchmarks::AllocationScope scope;
+    const auto copy = polynomial->Copy();
+    WARN("Copy of a 256 term polynomial made " << scope.Count() << " allocations");
+
+    BENCHMARK("Copy")
+    {
+        return polynomial->Copy();
+    };
+
+    BENCHMARK("Generalize")
+    {
+        return polynomial->Generalize();
+    };
+}
+
+TEST_CASE("Intern Benchmarks", "[Benchmark]")
+{
+    const auto polynomial = MakePolynomial(256);
+
+    BENCHMARK("Intern")
+    {
+        Oasis::ExpressionStore store;
+        return store.Intern(*polynomial);
+    };
+
+    Oasis::ExpressionStore store;
+    const auto interned = store.Intern(*polynomial);
+
+    BENCHMARK("Intern Again")
+    {
+        return store.Intern(*interned);
+    };
+}
+
+TEST_CASE("Simplify Benchmarks", "[Benchmark]")
+{
+    const auto polynomial = MakePolynomial(64);
+
+    Oasis::Benchmarks::AllocationScope scope;
+    const auto simplified = polynomial->Simplify();
+    WARN("Simplify of a 64 term polynomial made " << scope.Count() << " allocations");
+
+    BENCHMARK("Simplify")
+    {
+        return polynomial->Simplify();
+    };
+}
+
+TEST_CASE("Like Term Benchmarks", "[Benchmark]")
+{
+    // Sums of like terms should simplify in close to linear time as they grow.
+    for (const int terms : { 256, 1024, 4096 }) {
+        std::vector<std::unique_ptr<Oasis::Expression>> ops;
+
+        for (int i = 0; i < terms; ++i) {
+            ops.emplace_back(Oasis::Multiply { Oasis::Real { static_cast<double>(i) }, Oasis::Variable { i % 2 == 0 ? "x" : "y" } }.Copy());
+        }
+
+        const auto sum = Oasis::BuildFromVector<Oasis::Add>(ops);
+
+        BENCHMARK("Simplify Sum of " + std::to_string(terms) + " Terms")
+        {
+            return sum->Simplify();
+        };
+    }
+
+    // Terms that do not combine are rebuilt into the result at every level of the sum.
+    for (const int terms : { 256, 1024, 4096 }) {
+        std::vector<std::unique_ptr<Oasis::Expression>> ops;
+
+        for (int i = 0; i < terms; ++i) {
+            ops.emplace_back(Oasis::Multiply { Oasis::Real { static_cast<double>(i + 1) }, Oasis::Variable { "x" + std::to_string(i) } }.Copy());
+        }
+
+        const auto sum = Oasis::BuildFromVector<Oasis::Add>(ops);
+
+        BENCHMARK("Simplify Sum of " + std::to_string(terms) + " Distinct Terms")
+        {
+            return sum->Simplify();
+        };
+    }
+}
+
+TEST_CASE("Arena Benchmarks", "[Benchmark]")
+{
+    const auto polynomial = MakePolynomial(64);
+
+    std::size_t allocations = 0;
+    {
+        Oasis::ExpressionArena arena;
+        Oasis::Benchmarks::AllocationScope scope;
+        const auto simplified = polynomial->Simplify();
+        allocations = scope.Count();
+    }
+    WARN("Simplify of a 64 term polynomial in an arena made " << allocations << " allocations");
+
+    BENCHMARK("Simplify in Arena")
+    {
+        Oasis::ExpressionArena arena;
+        return arena.Evaluate([&] { return polynomial->Simplify(); });
+    };
+}
+
+TEST_CASE("Simplify Cache Benchmarks", "[Benchmark]")
+{
+    const auto polynomial = MakePolynomial(64);
+
+    const auto cache = std::make_shared<Oasis::SimplifyCache>();
+    Oasis::SimplifyCache::Install(cache);
+
+    BENCHMARK("Simplify with Cold Cache")
+    {
+        cache->Clear();
+        return polynomial->Simplify();
+    };
+
+    BENCHMARK("Simplify with Warm Cache")
+    {
+        return polynomial->Simplify();
+    };
+
+    Oasis::SimplifyCache::Install(nullptr);
+}
+
+TEST_CASE("Async Benchmarks", "[Benchmark]")
+{
+    // With the sequential cutoff, SimplifyAsync should never lose to Simplify by more than the cost
+    // of scheduling a single task, and should win on large expressions.
+    for (const int terms : { 4, 16, 64, 256 }) {
+        const auto polynomial = MakePolynomial(terms);
+
+        BENCHMARK("Simplify " + std::to_string(terms) + " Terms")
+        {
+            return polynomial->Simplify();
+        };
+
+        BENCHMARK("SimplifyAsync " + std::to_string(terms) + " Terms")
+        {
+            return polynomial->SimplifyAsync();
+        };
+    }
+}
+
+TEST_CASE("Async Scaling Benchmarks", "[Benchmark]")
+{
+    // Simplifies the same large expressions with an increasing number of workers. Each doubling of
+    // the workers should shorten SimplifyAsync until the workers outnumber the hardware threads.
+    const auto small = MakePolynomial(256);
+    const auto large = MakePolynomial(1024);
+
+    for (const std::size_t workers : { 1U, 2U, 4U, 8U }) {
+        Oasis::Runtime runtime { workers };
+
+        BENCHMARK("SimplifyAsync 256 Terms On " + std::to_string(workers) + " Workers")
+        {
+            return small->SimplifyAsync(runtime);
+        };
+
+        BENCHMARK("SimplifyAsync 1024 Terms On " + std::to_string(workers) + " Workers")
+        {
+            return large->SimplifyAsync(runtime);
+        };
+    }
+}
+
+TEST_CASE("Batch Benchmarks", "[Benchmark]")
+{
+    std::vector<std::unique_ptr<Oasis::Expression>> owned;
+    std::vector<const Oasis::Expression*> batch;
+
+    for (int i = 0; i < 1024; ++i) {
+        owned.emplace_back(Oasis::Add {
+            Oasis::Multiply { Oasis::Real { static_cast<double>(i) }, Oasis::Variable { "x" } },
+            Oasis::Multiply { Oasis::Real { 2.0 }, Oasis::Variable { "x" } } }
+                               .Copy());
+        batch.push_back(owned.back().get());
+    }
+
+    BENCHMARK("SimplifyAsync Each of 1024")
+    {
+        std::vector<std::unique_ptr<Oasis::Expression>> results;
+
+        for (const Oasis::Expression* expression : batch) {
+            results.emplace_back(expression->SimplifyAsync());
+        }
+
+        return results;
+    };
+
+    BENCHMARK("SimplifyMany 1024")
+    {
+        return Oasis::SimplifyMany(batch);
+    };
+}
+
+TEST_CASE("Evaluate Benchmarks", "[Benchmark]")
+{
+    const auto polynomial = MakePolynomial(16);
+    const Oasis::CompiledExpression compiled { *polynomial, { "x" } };
+
+    BENCHMARK("Substitute 16 Terms")
+    {
+        return polynomial->Copy()->Substitute(Oasis::Variable { "x" }, Oasis::Real { 0.5 })->Simplify();
+    };
+
+    BENCHMARK("Evaluate 16 Terms")
+    {
+        return compiled.Evaluate(std::array { 0.5 });
+    };
+}
+
+TEST_CASE("Evaluate Many Benchmarks", "[Benchmark]")
+{
+    const auto polynomial = MakePolynomial(16);
+    const Oasis::CompiledExpression compiled { *polynomial, { "x" } };
+
+    std::vector<double> xs(4096), results(4096);
+
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        xs[i] = static_cast<double>(i) / static_cast<double>(xs.size());
+    }
+
+    BENCHMARK("Evaluate 16 Terms At 4096 Points")
+    {
+        for (std::size_t i = 0; i < xs.size(); ++i) {
+            results[i] = compiled.Evaluate(std::array { xs[i] });
+        }
+
+        return results.back();
+    };
+
+    BENCHMARK("EvaluateMany 16 Terms At 4096 Points")
+    {
+        compiled.EvaluateMany(std::array<std::span<const double>, 1> { xs }, results);
+        return results.back();
+    };
+}
+
+TEST_CASE("Evaluate Grid Benchmarks", "[Benchmark]")
+{
+    const auto polynomial = MakePolynomial(16);
+    const Oasis::CompiledExpression compiled { *polynomial, { "x" } };
+
+    const std::array axes { Oasis::CompiledExpression::Axis { .start = 0.0, .step = 1.0 / (1 << 18), .count = 1 << 18 } };
+    std::vector<double> xs(axes[0].count), results(axes[0].count);
+
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        xs[i] = axes[0].start + static_cast<double>(i) * axes[0].step;
+    }
+
+    BENCHMARK("EvaluateMany 16 Terms At 2^18 Points")
+    {
+        compiled.EvaluateMany(std::array<std::span<const double>, 1> { xs }, results);
+        return results.back();
+    };
+
+    BENCHMARK("EvaluateGrid 16 Terms At 2^18 Points")
+    {
+        compiled.EvaluateGrid(axes, results);
+        return results.back();
+    };
+
+    BENCHMARK("ReduceGrid 16 Terms At 2^18 Points")
+    {
+        return compiled.ReduceGrid(axes);
+    };
+}
+
+TEST_CASE("Forward Mode Benchmarks", "[Benchmark]")
+{
+    const auto polynomial = MakePolynomial(16);
+    const Oasis::CompiledExpression compiled { *polynomial, { "x" } };
+
+    BENCHMARK("Differentiate And Substitute 16 Terms")
+    {
+        return polynomial->Differentiate(Oasis::Variable { "x" })->Substitute(Oasis::Variable { "x" }, Oasis::Real { 0.5 })->Simplify();
+    };
+
+    BENCHMARK("EvaluateDual 16 Terms")
+    {
+        return compiled.EvaluateDual(std::array { 0.5 }, std::array { 1.0 });
+    };
+}
+
+TEST_CASE("Reverse Mode Benchmarks", "[Benchmark]")
+{
+    // sum of i * x_i^2 + x_i * x_(i + 1) over 16 variables
+    constexpr int variables = 16;
+    std::vector<std::unique_ptr<Oasis::Expression>> ops;
+    std::vector<std::string> names;
+
+    for (int i = 0; i < variables; ++i) {
+        names.push_back("x" + std::to_string(i));
+    }
+
+    for (int i = 0; i < variables; ++i) {
+        const Oasis::Variable variable { names[i] };
+        ops.emplace_back(Oasis::Multiply { Oasis::Real { static_cast<double>(i + 1) }, Oasis::Exponent { variable, Oasis::Real { 2.0 } } }.Copy());
+        ops.emplace_back(Oasis::Multiply { variable, Oasis::Variable { names[(i + 1) % variables] } }.Copy());
+    }
+
+    const auto loss = Oasis::BuildFromVector<Oasis::Add>(ops);
+    const Oasis::CompiledExpression compiled { *loss, names };
+    const std::vector<double> values(variables, 0.5);
+    std::vector<double> gradient(variables);
+
+    BENCHMARK("Differentiate Each Of 16 Variables")
+    {
+        for (int i = 0; i < variables; ++i) {
+            const auto derivative = loss->Differentiate(Oasis::Variable { names[i] });
+            gradient[i] = Oasis::CompiledExpression { *derivative, names }.Evaluate(values);
+        }
+
+        return gradient.back();
+    };
+
+    BENCHMARK("EvaluateGradient Of 16 Variables")
+    {
+        return compiled.EvaluateGradient(values, gradient);
+    };
+}
+
+TEST_CASE("Common Subexpression Benchmarks", "[Benchmark]")
+{
+    const Oasis::Variable x { "x" };
+    const Oasis::Variable y { "y" };
+
+    // f = x / (x^2 + y), along with its partial derivatives
+    const Oasis::Add sum { Oasis::Exponent { x, Oasis::Real { 2.0 } }, y };
+    const Oasis::Divide f { x, sum };
+    const Oasis::Divide dfdx { Oasis::Subtract { sum, Oasis::Multiply { Oasis::Real { 2.0 }, Oasis::Multiply { x, x } } }, Oasis::Multiply { sum, sum } };
+    const Oasis::Negate dfdy { Oasis::Divide { x, Oasis::Multiply { sum, sum } } };
+
+    const std::array<const Oasis::Expression*, 3> expressions { &f, &dfdx, &dfdy };
+    const Oasis::CompiledExpression together { expressions, { "x", "y" } };
+    const std::array<Oasis::CompiledExpression, 3> separate {
+        Oasis::CompiledExpression { f, { "x", "y" } },
+        Oasis::CompiledExpression { dfdx, { "x", "y" } },
+        Oasis::CompiledExpression { dfdy, { "x", "y" } }
+    };
+
+    const std::array values { 1.25, 3.0 };
+    std::array<double, 3> outputs {};
+
+    BENCHMARK("Evaluate Function And Derivatives Separately")
+    {
+        for (std::size_t i = 0; i < separate.size(); ++i) {
+            outputs[i] = separate[i].Evaluate(values);
+        }
+
+        return outputs.back();
+    };
+
+    BENCHMARK("Evaluate Function And Derivatives Together")
+    {
+        together.Evaluate(values, outputs);
+        return outputs.back();
+    };
+}
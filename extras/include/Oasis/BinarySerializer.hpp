@@ -0,0 +1,106 @@
+#ifndef OASIS_BINARYSERIALIZER_HPP
+#define OASIS_BINARYSERIALIZER_HPP
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Oasis/Serialization.hpp"
+
+namespace Oasis {
+
+/**
+ * Writes expressions in a compact binary format that `FromBinary` reads back exactly.
+ *
+ * A document starts with the magic bytes `OASB` and a version byte, followed by a table of the
+ * names of the variables it uses and then each expression serialized with this serializer, in
+ * order. Each expression is written in preorder as a one-byte tag followed by its payload: a real
+ * number is its IEEE 754 bits in little-endian order, a variable is the index of its name in the
+ * table, and a matrix is its number of rows and columns followed by its elements in row-major
+ * order. Every operation has a fixed number of operands, each written right after it, and a
+ * missing operand is written as a tag of its own. Counts, lengths, and indices are unsigned
+ * LEB128 varints. Each distinct variable name is written only once per document.
+ *
+ * @code
+ * BinarySerializer serializer;
+ * first.Serialize(serializer);
+ * second.Serialize(serializer);
+ * std::vector<std::uint8_t> document = serializer.GetResult();
+ * @endcode
+ */
+class BinarySerializer final : public SerializationVisitor {
+public:
+    /**
+     * The version of the format this serializer writes.
+     */
+    static constexpr std::uint8_t version = 1;
+
+    void Serialize(const Real& real) override;
+    void Serialize(const Imaginary& imaginary) override;
+    void Serialize(const Matrix& matrix) override;
+    void Serialize(const Variable& variable) override;
+    void Serialize(const Undefined& undefined) override;
+    void Serialize(const Add<Expression, Expression>& add) override;
+    void Serialize(const Subtract<Expression, Expression>& subtract) override;
+    void Serialize(const Multiply<Expression, Expression>& multiply) override;
+    void Serialize(const Divide<Expression, Expression>& divide) override;
+    void Serialize(const Exponent<Expression, Expression>& exponent) override;
+    void Serialize(const Log<Expression, Expression>& log) override;
+    void Serialize(const Negate<Expression>& negate) override;
+    void Serialize(const Derivative<Expression, Expression>& derivative) override;
+    void Serialize(const Integral<Expression, Expression>& integral) override;
+
+    /**
+     * Gets a document of every expression serialized since this serializer was created or
+     * cleared.
+     *
+     * @return The document.
+     */
+    [[nodiscard]] auto GetResult() const -> std::vector<std::uint8_t>;
+
+    /**
+     * Discards every expression serialized so far, so that the next expression serialized starts
+     * a new document.
+     */
+    void Clear();
+
+private:
+    void SerializeOperand(const Expression* operand);
+
+    std::vector<std::uint8_t> body;
+    std::vector<std::string> names;
+    std::unordered_map<std::string, std::uint32_t> nameIndices;
+};
+
+/**
+ * Reads the expressions of a document written by `BinarySerializer`.
+ *
+ * The document is decoded in a single pass without recursion. Expressions more than 4096 levels
+ * deep are rejected, since destroying, comparing, or serializing them would recurse as deeply.
+ *
+ * @param document The document to read.
+ * @return The expressions of the document, in the order they were serialized.
+ * @throws std::invalid_argument If the document is malformed, of an unsupported version, or
+ * holds an expression that is nested too deeply.
+ */
+auto FromBinary(std::span<const std::uint8_t> document) -> std::vector<std::unique_ptr<Expression>>;
+
+/**
+ * Reads the expressions of a file written by `BinarySerializer`, like `FromBinary`. The file is
+ * mapped into memory rather than read, so it is never copied.
+ *
+ * @param path The file to read.
+ * @return The expressions of the file, in the order they were serialized.
+ * @throws std::runtime_error If the file cannot be read.
+ * @throws std::invalid_argument If the file is malformed, of an unsupported version, or holds an
+ * expression that is nested too deeply.
+ */
+auto FromBinaryFile(const std::filesystem::path& path) -> std::vector<std::unique_ptr<Expression>>;
+
+} // Oasis
+
+#endif // OASIS_BINARYSERIALIZER_HPP
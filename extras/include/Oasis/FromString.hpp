@@ -5,22 +5,105 @@
 #ifndef FROMSTRING_HPP
 #define FROMSTRING_HPP
 
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+#include "Oasis/Expression.hpp"
+
 namespace Oasis {
 
+class Runtime;
+
+/**
+ * Why and where parsing failed.
+ */
+struct ParseError {
+    std::string message;
+    std::size_t offset; ///< The offset of the offending character in the input.
+};
+
 class ParseResult {
 public:
     explicit ParseResult(std::unique_ptr<Expression> expr);
     explicit ParseResult(std::string err);
+    explicit ParseResult(ParseError err);
 
     [[nodiscard]] bool Ok() const;
     [[nodiscard]] const Expression& GetResult() const;
     [[nodiscard]] std::string GetErrorMessage() const;
 
+    /**
+     * Gets the offset in the input at which parsing failed.
+     *
+     * @return The offset of the offending character, or 0 if parsing succeeded.
+     */
+    [[nodiscard]] std::size_t GetErrorOffset() const;
+
 private:
-    std::variant<std::unique_ptr<Expression>, std::string> result;
+    std::variant<std::unique_ptr<Expression>, ParseError> result;
 };
 
-auto FromInFix(const std::string& str) -> ParseResult;
+/**
+ * Parses an expression written in in-fix notation, such as `2x^2 + log(2, y) / 3`.
+ *
+ * The input is read in a single pass without copying it. Tokens need not be separated by
+ * whitespace. Juxtaposed operands, such as `2x` or `xy`, are multiplied. Each letter is a separate
+ * variable, optionally with a subscript such as `x_1` or `x_{12}`, unless it starts a word that is
+ * exactly a function name. `^` is right-associative and binds tighter than unary `-`.
+ * `log(b, a)`, `dd(f, x)`, and `in(f, x)` give a logarithm, derivative, and integral, and `i` is
+ * the imaginary unit.
+ *
+ * @param str The expression to parse.
+ * @return The parsed expression, or the reason and offset at which parsing failed. Malformed
+ *         input never throws.
+ */
+auto FromInFix(std::string_view str) -> ParseResult;
+
+/**
+ * Parses each line of some text as an in-fix expression on the current `Runtime`.
+ *
+ * @param text The expressions to parse, one per line. A final newline is optional.
+ * @return One result per line, in order.
+ */
+auto FromInFixLines(std::string_view text) -> std::vector<ParseResult>;
+
+/**
+ * Parses each line of some text as an in-fix expression.
+ *
+ * The text is split on newlines without copying, and runs of consecutive lines are parsed in
+ * parallel. A line that fails to parse does not affect the others, and the offset of its error is
+ * relative to the start of the line.
+ *
+ * @param text The expressions to parse, one per line. A final newline is optional.
+ * @param runtime The runtime to parse on.
+ * @return One result per line, in order.
+ */
+auto FromInFixLines(std::string_view text, Runtime& runtime) -> std::vector<ParseResult>;
+
+/**
+ * Parses a file of in-fix expressions, one per line, on the current `Runtime`.
+ *
+ * @param path The file to parse.
+ * @return One result per line, in order.
+ * @throws std::runtime_error If the file cannot be read.
+ */
+auto FromInFixFile(const std::filesystem::path& path) -> std::vector<ParseResult>;
+
+/**
+ * Parses a file of in-fix expressions, one per line, like `FromInFixLines`. The file is mapped
+ * into memory rather than read, so it is never copied.
+ *
+ * @param path The file to parse.
+ * @param runtime The runtime to parse on.
+ * @return One result per line, in order.
+ * @throws std::runtime_error If the file cannot be read.
+ */
+auto FromInFixFile(const std::filesystem::path& path, Runtime& runtime) -> std::vector<ParseResult>;
 
 }
 
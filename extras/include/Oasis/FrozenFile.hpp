@@ -0,0 +1,24 @@
+#ifndef OASIS_FROZENFILE_HPP
+#define OASIS_FROZENFILE_HPP
+
+#include <filesystem>
+
+#include "Oasis/FrozenExpression.hpp"
+
+namespace Oasis {
+
+/**
+ * Views a file holding the bytes of a `FrozenExpression`. The file is mapped into memory rather
+ * than read, so loading it costs no more than the page faults of the parts that are used. The
+ * mapping lives as long as the returned expression or any copy of it.
+ *
+ * @param path The file to view.
+ * @return The frozen expression in the file.
+ * @throws std::runtime_error If the file cannot be read.
+ * @throws std::invalid_argument If the file does not hold a valid frozen expression.
+ */
+auto FromFrozenFile(const std::filesystem::path& path) -> FrozenExpression;
+
+} // Oasis
+
+#endif // OASIS_FROZENFILE_HPP
@@ -6,15 +6,52 @@
 #define INFIXSERIALIZER_HPP
 
 #include <string>
+#include <string_view>
+
+#include <fmt/format.h>
 
 #include "Oasis/Serialization.hpp"
 
 namespace Oasis {
 
+/**
+ * Writes expressions in in-fix notation, such as `((2*x)+1)`.
+ *
+ * Every node appends directly to a single output buffer, so serializing a tree allocates only
+ * to grow that buffer. The result is that of the last expression serialized, although a buffer
+ * owned by the caller keeps every expression serialized into it.
+ */
 class InFixSerializer final : public SerializationVisitor {
 public:
+    /**
+     * How operands are parenthesized.
+     */
+    enum class Parentheses {
+        All, ///< Every operation is parenthesized, as in `((2*x)+1)`.
+        Minimal, ///< Only where precedence and associativity require, as in `2*x+1`. Numbers are written with every digit needed to read them back exactly, so the output of a tree of finite numbers parses back to the same tree.
+    };
+
+    /**
+     * Creates a serializer that writes to a buffer of its own.
+     *
+     * @param parentheses How operands are parenthesized.
+     */
+    explicit InFixSerializer(Parentheses parentheses = Parentheses::All);
+
+    /**
+     * Creates a serializer that appends to a buffer owned by the caller.
+     *
+     * @param out The buffer to append to. It must outlive the serializer.
+     * @param parentheses How operands are parenthesized.
+     */
+    explicit InFixSerializer(fmt::memory_buffer& out, Parentheses parentheses = Parentheses::All);
+
+    InFixSerializer(const InFixSerializer&) = delete;
+    auto operator=(const InFixSerializer&) -> InFixSerializer& = delete;
+
     void Serialize(const Real& real) override;
     void Serialize(const Imaginary& imaginary) override;
+    void Serialize(const Matrix& matrix) override;
     void Serialize(const Variable& variable) override;
     void Serialize(const Undefined& undefined) override;
     void Serialize(const Add<Expression, Expression>& add) override;
@@ -27,10 +64,38 @@ public:
     void Serialize(const Derivative<Expression, Expression>& derivative) override;
     void Serialize(const Integral<Expression, Expression>& integral) override;
 
+    /**
+     * Gets the output of the last expression serialized.
+     *
+     * @return The output of the last expression serialized.
+     */
     [[nodiscard]] std::string getResult() const;
 
+    /**
+     * Gets the output of the last expression serialized without copying it.
+     *
+     * @return A view of the output, valid until the next expression is serialized or the output
+     *         is cleared.
+     */
+    [[nodiscard]] std::string_view GetView() const;
+
+    /**
+     * Discards the output, so that the next expression serialized starts a new one.
+     */
+    void Clear();
+
 private:
-    std::string result;
+    void BeginExpression();
+    void SerializeNumber(double value);
+    void SerializeBinary(const Expression& mostSigOp, const Expression& leastSigOp, char op, int precedence);
+    void SerializeFunction(std::string_view name, const Expression& first, const Expression& second);
+    void SerializeOperand(const Expression& operand, bool parenthesize);
+
+    fmt::memory_buffer buffer;
+    fmt::memory_buffer* out;
+    Parentheses parentheses;
+    std::size_t start = 0; ///< Where the output of the last expression serialized begins.
+    int nesting = 0; ///< How many operands deep the node being serialized is.
 };
 
 } // Oasis
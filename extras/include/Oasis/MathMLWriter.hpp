@@ -0,0 +1,102 @@
+#ifndef OASIS_MATHMLWRITER_HPP
+#define OASIS_MATHMLWRITER_HPP
+
+#include <cstddef>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Oasis/Serialization.hpp"
+
+namespace Oasis {
+
+class Expression;
+
+/**
+ * Writes expressions as MathML directly to a stream, without building a document.
+ *
+ * The output is byte for byte what `MathMLSerializer` produces once its result is inserted into
+ * an empty `tinyxml2::XMLDocument` and printed with a default `tinyxml2::XMLPrinter`. Each
+ * expression serialized is written as a document of its own, ending with a newline.
+ *
+ * Output is collected in a small buffer that is written to the stream whenever it fills and
+ * after each expression, so memory use does not grow with the size of the output. Apart from
+ * that buffer, the writer keeps only the operands of the sums and products it is inside of.
+ *
+ * @code
+ * std::ofstream file { "expression.mml" };
+ * Oasis::MathMLWriter writer { file };
+ * expression.Serialize(writer);
+ * @endcode
+ */
+class MathMLWriter final : public SerializationVisitor {
+public:
+    /**
+     * The number of bytes collected before they are written to the stream.
+     */
+    static constexpr std::size_t buffer_size = 64 * 1024;
+
+    /**
+     * Creates a writer.
+     *
+     * @param out The stream to write to. It must outlive the writer. Errors are reported through
+     *            the state of the stream, as with any other output to it.
+     */
+    explicit MathMLWriter(std::ostream& out);
+
+    MathMLWriter(const MathMLWriter&) = delete;
+    auto operator=(const MathMLWriter&) -> MathMLWriter& = delete;
+
+    void Serialize(const Real& real) override;
+    void Serialize(const Imaginary& imaginary) override;
+    void Serialize(const Matrix& matrix) override;
+    void Serialize(const Variable& variable) override;
+    void Serialize(const Undefined& undefined) override;
+    void Serialize(const Add<Expression, Expression>& add) override;
+    void Serialize(const Subtract<Expression, Expression>& subtract) override;
+    void Serialize(const Multiply<Expression, Expression>& multiply) override;
+    void Serialize(const Divide<Expression, Expression>& divide) override;
+    void Serialize(const Exponent<Expression, Expression>& exponent) override;
+    void Serialize(const Log<Expression, Expression>& log) override;
+    void Serialize(const Negate<Expression>& negate) override;
+    void Serialize(const Derivative<Expression, Expression>& derivative) override;
+    void Serialize(const Integral<Expression, Expression>& integral) override;
+
+    /**
+     * Writes any buffered output to the stream. This happens on its own after each expression,
+     * so it is only needed to see part of an expression that is still being written.
+     */
+    void Flush();
+
+private:
+    void OpenElement(std::string_view name);
+    void CloseElement(std::string_view name);
+    void PushElement(std::string_view name, std::string_view text);
+    void PushOperand(const Expression* operand);
+    void PushPlaceholder();
+
+    void BeginLine();
+    void EndElement();
+    void Indent(int level);
+    void PushEscaped(std::string_view text);
+
+    auto PushOperands(const Expression& expression) -> std::size_t;
+
+    std::ostream& out;
+    fmt::memory_buffer buffer;
+
+    /**
+     * The flattened operands of every sum and product being written, innermost last.
+     */
+    std::vector<const Expression*> operands;
+    std::vector<const Expression*> pending;
+
+    int depth = 0;
+    bool elementJustOpened = false;
+};
+
+} // Oasis
+
+#endif // OASIS_MATHMLWRITER_HPP
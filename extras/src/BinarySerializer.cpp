@@ -0,0 +1,492 @@
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "Oasis/BinarySerializer.hpp"
+
+#include "Oasis/Add.hpp"
+#include "Oasis/Derivative.hpp"
+#include "Oasis/Divide.hpp"
+#include "Oasis/Exponent.hpp"
+#include "Oasis/Imaginary.hpp"
+#include "Oasis/Integral.hpp"
+#include "Oasis/Log.hpp"
+#include "Oasis/Matrix.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Negate.hpp"
+#include "Oasis/NodeAllocation.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Subtract.hpp"
+#include "Oasis/Undefined.hpp"
+#include "Oasis/Variable.hpp"
+
+#include "MappedFile.hpp"
+
+namespace {
+
+constexpr std::uint8_t magic[] = { 'O', 'A', 'S', 'B' };
+
+// The tag of each kind of node. These are part of the format, so they must never be renumbered.
+enum class Tag : std::uint8_t {
+    Empty, ///< A missing operand.
+    Real,
+    Imaginary,
+    Variable,
+    Undefined,
+    Matrix,
+    Add,
+    Subtract,
+    Multiply,
+    Divide,
+    Exponent,
+    Log,
+    Negate,
+    Derivative,
+    Integral,
+};
+
+void writeVarint(std::vector<std::uint8_t>& out, std::uint64_t value)
+{
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+void writeDouble(std::vector<std::uint8_t>& out, const double value)
+{
+    const auto bits = std::bit_cast<std::uint64_t>(value);
+    const std::size_t offset = out.size();
+    out.resize(offset + sizeof bits);
+
+    for (std::size_t i = 0; i < sizeof bits; ++i) {
+        out[offset + i] = static_cast<std::uint8_t>(bits >> (8 * i));
+    }
+}
+
+// Reads the primitives of a document, throwing if it ends early.
+class Cursor {
+public:
+    explicit Cursor(std::span<const std::uint8_t> document)
+        : pos(document.data())
+        , end(document.data() + document.size())
+    {
+    }
+
+    [[nodiscard]] auto AtEnd() const -> bool
+    {
+        return pos == end;
+    }
+
+    [[nodiscard]] auto Remaining() const -> std::size_t
+    {
+        return static_cast<std::size_t>(end - pos);
+    }
+
+    auto ReadByte() -> std::uint8_t
+    {
+        Require(1);
+        return *pos++;
+    }
+
+    auto ReadVarint() -> std::uint64_t
+    {
+        std::uint64_t value = 0;
+
+        for (int shift = 0; shift < 64; shift += 7) {
+            const std::uint8_t byte = ReadByte();
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+
+            if ((byte & 0x80) == 0) {
+                return value;
+            }
+        }
+
+        throw std::invalid_argument("Varint is too long.");
+    }
+
+    auto ReadDouble() -> double
+    {
+        Require(sizeof(std::uint64_t));
+        std::uint64_t bits = 0;
+
+        for (std::size_t i = 0; i < sizeof bits; ++i) {
+            bits |= static_cast<std::uint64_t>(pos[i]) << (8 * i);
+        }
+
+        pos += sizeof bits;
+        return std::bit_cast<double>(bits);
+    }
+
+    auto ReadBytes(const std::size_t count) -> std::string_view
+    {
+        Require(count);
+        const std::string_view bytes { reinterpret_cast<const char*>(pos), count };
+        pos += count;
+        return bytes;
+    }
+
+private:
+    void Require(const std::size_t count) const
+    {
+        if (Remaining() < count) {
+            throw std::invalid_argument("Unexpected end of document.");
+        }
+    }
+
+    const std::uint8_t* pos;
+    const std::uint8_t* end;
+};
+
+// An operand, which is shared so that attaching it to its parent neither copies it nor allocates.
+using Operand = std::shared_ptr<const Oasis::Expression>;
+
+using Oasis::AllocateNode;
+using Oasis::MakeBinaryNode;
+
+template <bool Root>
+auto makeNode(const Tag tag, Operand first, Operand second) -> Oasis::ExpressionNode<Root>
+{
+    switch (tag) {
+    case Tag::Add:
+        return MakeBinaryNode<Oasis::Add, Root>(std::move(first), std::move(second));
+    case Tag::Subtract:
+        return MakeBinaryNode<Oasis::Subtract, Root>(std::move(first), std::move(second));
+    case Tag::Multiply:
+        return MakeBinaryNode<Oasis::Multiply, Root>(std::move(first), std::move(second));
+    case Tag::Divide:
+        return MakeBinaryNode<Oasis::Divide, Root>(std::move(first), std::move(second));
+    case Tag::Exponent:
+        return MakeBinaryNode<Oasis::Exponent, Root>(std::move(first), std::move(second));
+    case Tag::Log:
+        return MakeBinaryNode<Oasis::Log, Root>(std::move(first), std::move(second));
+    case Tag::Derivative:
+        return MakeBinaryNode<Oasis::Derivative, Root>(std::move(first), std::move(second));
+    case Tag::Integral:
+        return MakeBinaryNode<Oasis::Integral, Root>(std::move(first), std::move(second));
+    default: {
+        auto negate = AllocateNode<Oasis::Negate<Oasis::Expression>, Root>();
+        negate->SetOperand(std::move(first));
+        return negate;
+    }
+    }
+}
+
+// Reads the payload of a leaf, whose tag has already been read.
+template <bool Root>
+auto readLeaf(const Tag tag, Cursor& cursor, const std::vector<std::string_view>& names) -> Oasis::ExpressionNode<Root>
+{
+    switch (tag) {
+    case Tag::Real:
+        return AllocateNode<Oasis::Real, Root>(cursor.ReadDouble());
+    case Tag::Imaginary:
+        return AllocateNode<Oasis::Imaginary, Root>();
+    case Tag::Variable: {
+        const std::uint64_t index = cursor.ReadVarint();
+
+        if (index >= names.size()) {
+            throw std::invalid_argument("Variable name index is out of range.");
+        }
+
+        return AllocateNode<Oasis::Variable, Root>(std::string { names[index] });
+    }
+    case Tag::Undefined:
+        return AllocateNode<Oasis::Undefined, Root>();
+    case Tag::Matrix: {
+        const std::uint64_t rows = cursor.ReadVarint();
+        const std::uint64_t cols = cursor.ReadVarint();
+
+        // An empty matrix may have any number of rows or columns, as long as Eigen can index them.
+        if (rows > static_cast<std::uint64_t>(std::numeric_limits<Eigen::Index>::max()) || cols > static_cast<std::uint64_t>(std::numeric_limits<Eigen::Index>::max())) {
+            throw std::invalid_argument("Matrix dimensions are out of range.");
+        }
+
+        // Checking against the rest of the document also guards the allocation below.
+        if (cols != 0 && rows > cursor.Remaining() / sizeof(double) / cols) {
+            throw std::invalid_argument("Matrix is larger than the document.");
+        }
+
+        Oasis::MatrixXXD matrix(static_cast<Eigen::Index>(rows), static_cast<Eigen::Index>(cols));
+
+        for (Eigen::Index i = 0; i < matrix.size(); ++i) {
+            matrix.data()[i] = cursor.ReadDouble();
+        }
+
+        return AllocateNode<Oasis::Matrix, Root>(std::move(matrix));
+    }
+    default:
+        throw std::invalid_argument("Unknown tag.");
+    }
+}
+
+// A node whose operands are still being read.
+struct Pending {
+    Tag tag;
+    int remaining; ///< The number of operands left to read.
+    Operand first;
+};
+
+}
+
+namespace Oasis {
+
+void BinarySerializer::Serialize(const Real& real)
+{
+    body.push_back(static_cast<std::uint8_t>(Tag::Real));
+    writeDouble(body, real.GetValue());
+}
+
+void BinarySerializer::Serialize(const Imaginary&)
+{
+    body.push_back(static_cast<std::uint8_t>(Tag::Imaginary));
+}
+
+void BinarySerializer::Serialize(const Matrix& matrix)
+{
+    const auto& mat = matrix.GetMatrix();
+
+    body.push_back(static_cast<std::uint8_t>(Tag::Matrix));
+    writeVarint(body, static_cast<std::uint64_t>(mat.rows()));
+    writeVarint(body, static_cast<std::uint64_t>(mat.cols()));
+
+    // Eigen stores MatrixXXD in row-major order, so its elements are already in order.
+    for (Eigen::Index i = 0; i < mat.size(); ++i) {
+        writeDouble(body, mat.data()[i]);
+    }
+}
+
+void BinarySerializer::Serialize(const Variable& variable)
+{
+    auto name = variable.GetName();
+    const auto [it, inserted] = nameIndices.try_emplace(name, static_cast<std::uint32_t>(names.size()));
+
+    if (inserted) {
+        names.push_back(std::move(name));
+    }
+
+    body.push_back(static_cast<std::uint8_t>(Tag::Variable));
+    writeVarint(body, it->second);
+}
+
+void BinarySerializer::Serialize(const Undefined&)
+{
+    body.push_back(static_cast<std::uint8_t>(Tag::Undefined));
+}
+
+void BinarySerializer::Serialize(const Add<>& add)
+{
+    body.push_back(static_cast<std::uint8_t>(Tag::Add));
+    SerializeOperand(add.HasMostSigOp() ? &add.GetMostSigOp() : nullptr);
+    SerializeOperand(add.HasLeastSigOp() ? &add.GetLeastSigOp() : nullptr);
+}
+
+void BinarySerializer::Serialize(const Subtract<>& subtract)
+{
+    body.push_back(static_cast<std::uint8_t>(Tag::Subtract));
+    SerializeOperand(subtract.HasMostSigOp() ? &subtract.GetMostSigOp() : nullptr);
+    SerializeOperand(subtract.HasLeastSigOp() ? &subtract.GetLeastSigOp() : nullptr);
+}
+
+void BinarySerializer::Serialize(const Multiply<>& multiply)
+{
+    body.push_back(static_cast<std::uint8_t>(Tag::Multiply));
+    SerializeOperand(multiply.HasMostSigOp() ? &multiply.GetMostSigOp() : nullptr);
+    SerializeOperand(multiply.HasLeastSigOp() ? &multiply.GetLeastSigOp() : nullptr);
+}
+
+void BinarySerializer::Serialize(const Divide<>& divide)
+{
+    body.push_back(static_cast<std::uint8_t>(Tag::Divide));
+    SerializeOperand(divide.HasMostSigOp() ? &divide.GetMostSigOp() : nullptr);
+    SerializeOperand(divide.HasLeastSigOp() ? &divide.GetLeastSigOp() : nullptr);
+}
+
+void BinarySerializer::Serialize(const Exponent<>& exponent)
+{
+    body.push_back(static_cast<std::uint8_t>(Tag::Exponent));
+    SerializeOperand(exponent.HasMostSigOp() ? &exponent.GetMostSigOp() : nullptr);
+    SerializeOperand(exponent.HasLeastSigOp() ? &exponent.GetLeastSigOp() : nullptr);
+}
+
+void BinarySerializer::Serialize(const Log<>& log)
+{
+    body.push_back(static_cast<std::uint8_t>(Tag::Log));
+    SerializeOperand(log.HasMostSigOp() ? &log.GetMostSigOp() : nullptr);
+    SerializeOperand(log.HasLeastSigOp() ? &log.GetLeastSigOp() : nullptr);
+}
+
+void BinarySerializer::Serialize(const Negate<Expression>& negate)
+{
+    body.push_back(static_cast<std::uint8_t>(Tag::Negate));
+    SerializeOperand(negate.HasOperand() ? &negate.GetOperand() : nullptr);
+}
+
+void BinarySerializer::Serialize(const Derivative<>& derivative)
+{
+    body.push_back(static_cast<std::uint8_t>(Tag::Derivative));
+    SerializeOperand(derivative.HasMostSigOp() ? &derivative.GetMostSigOp() : nullptr);
+    SerializeOperand(derivative.HasLeastSigOp() ? &derivative.GetLeastSigOp() : nullptr);
+}
+
+void BinarySerializer::Serialize(const Integral<>& integral)
+{
+    body.push_back(static_cast<std::uint8_t>(Tag::Integral));
+    SerializeOperand(integral.HasMostSigOp() ? &integral.GetMostSigOp() : nullptr);
+    SerializeOperand(integral.HasLeastSigOp() ? &integral.GetLeastSigOp() : nullptr);
+}
+
+auto BinarySerializer::GetResult() const -> std::vector<std::uint8_t>
+{
+    std::vector<std::uint8_t> document(std::begin(magic), std::end(magic));
+    document.push_back(version);
+    writeVarint(document, names.size());
+
+    for (const auto& name : names) {
+        writeVarint(document, name.size());
+        document.insert(document.end(), name.begin(), name.end());
+    }
+
+    document.insert(document.end(), body.begin(), body.end());
+    return document;
+}
+
+void BinarySerializer::Clear()
+{
+    body.clear();
+    names.clear();
+    nameIndices.clear();
+}
+
+void BinarySerializer::SerializeOperand(const Expression* operand)
+{
+    if (operand == nullptr) {
+        body.push_back(static_cast<std::uint8_t>(Tag::Empty));
+        return;
+    }
+
+    operand->Serialize(*this);
+}
+
+auto FromBinary(const std::span<const std::uint8_t> document) -> std::vector<std::unique_ptr<Expression>>
+{
+    Cursor cursor { document };
+
+    if (cursor.Remaining() < sizeof magic || std::memcmp(document.data(), magic, sizeof magic) != 0) {
+        throw std::invalid_argument("Not an Oasis binary document.");
+    }
+
+    cursor.ReadBytes(sizeof magic);
+
+    if (const std::uint8_t documentVersion = cursor.ReadByte(); documentVersion != BinarySerializer::version) {
+        throw std::invalid_argument("Unsupported document version.");
+    }
+
+    // Each name takes at least one byte, which bounds the table by the size of the document.
+    const std::uint64_t nameCount = cursor.ReadVarint();
+
+    if (nameCount > cursor.Remaining()) {
+        throw std::invalid_argument("Unexpected end of document.");
+    }
+
+    std::vector<std::string_view> names;
+    names.reserve(nameCount);
+
+    for (std::uint64_t i = 0; i < nameCount; ++i) {
+        const std::uint64_t length = cursor.ReadVarint();
+
+        if (length > cursor.Remaining()) {
+            throw std::invalid_argument("Unexpected end of document.");
+        }
+
+        names.push_back(cursor.ReadBytes(length));
+    }
+
+    std::vector<std::unique_ptr<Expression>> expressions;
+    std::vector<Pending> pending;
+
+    while (!cursor.AtEnd()) {
+        const auto tag = static_cast<Tag>(cursor.ReadByte());
+        Operand operand;
+
+        switch (tag) {
+        case Tag::Add:
+        case Tag::Subtract:
+        case Tag::Multiply:
+        case Tag::Divide:
+        case Tag::Exponent:
+        case Tag::Log:
+        case Tag::Derivative:
+        case Tag::Integral:
+        case Tag::Negate:
+            // Every pending node is an ancestor of the next one read, so this bounds the height.
+            if (pending.size() == max_height) {
+                throw std::invalid_argument("Expression is nested too deeply.");
+            }
+
+            pending.push_back({ tag, tag == Tag::Negate ? 1 : 2, nullptr });
+            continue;
+        case Tag::Empty:
+            if (pending.empty()) {
+                throw std::invalid_argument("Expected an expression.");
+            }
+            break;
+        default:
+            if (pending.empty()) {
+                expressions.push_back(readLeaf<true>(tag, cursor, names));
+                continue;
+            }
+
+            operand = readLeaf<false>(tag, cursor, names);
+        }
+
+        // Hand the operand to the node waiting for it, completing that node in turn if this was
+        // its last operand.
+        while (true) {
+            auto& parent = pending.back();
+
+            if (--parent.remaining > 0) {
+                parent.first = std::move(operand);
+                break;
+            }
+
+            const Tag parentTag = parent.tag;
+            Operand first = std::move(parent.first);
+            pending.pop_back();
+
+            // A negation has only the operand just read.
+            Operand second = std::move(operand);
+
+            if (parentTag == Tag::Negate) {
+                std::swap(first, second);
+            }
+
+            if (pending.empty()) {
+                expressions.push_back(makeNode<true>(parentTag, std::move(first), std::move(second)));
+                break;
+            }
+
+            operand = makeNode<false>(parentTag, std::move(first), std::move(second));
+        }
+    }
+
+    if (!pending.empty()) {
+        throw std::invalid_argument("Unexpected end of document.");
+    }
+
+    return expressions;
+}
+
+auto FromBinaryFile(const std::filesystem::path& path) -> std::vector<std::unique_ptr<Expression>>
+{
+    const MappedFile file { path };
+    const std::string_view bytes = file.GetText();
+    return FromBinary({ reinterpret_cast<const std::uint8_t*>(bytes.data()), bytes.size() });
+}
+
+} // Oasis
@@ -1,10 +1,15 @@
 //
 // Created by Matthew McCall on 4/21/24.
 //
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cstring>
 #include <memory>
-#include <regex>
-#include <sstream>
-#include <stack>
+#include <optional>
+
+#include "taskflow/taskflow.hpp"
 
 #include <Oasis/Add.hpp>
 #include <Oasis/Derivative.hpp>
@@ -14,202 +19,437 @@
 #include <Oasis/Integral.hpp>
 #include <Oasis/Log.hpp>
 #include <Oasis/Multiply.hpp>
+#include <Oasis/Negate.hpp>
+#include <Oasis/NodeAllocation.hpp>
 #include <Oasis/Real.hpp>
+#include <Oasis/Runtime.hpp>
 #include <Oasis/Subtract.hpp>
+#include <Oasis/Variable.hpp>
 
 #include "Oasis/FromString.hpp"
 
+#include "MappedFile.hpp"
+
 #include "fmt/format.h"
 
 namespace {
 
-int prec(const char c)
-{
-    if (c == '^')
-        return 3;
-    if (c == '*' || c == '/')
-        return 2;
-    if (c == '+' || c == '-')
-        return 1;
-    return -1;
-}
-
-template <typename T>
-void setOps(T& exp, const std::unique_ptr<Oasis::Expression>& op1, const std::unique_ptr<Oasis::Expression>& op2)
-{
-    if (op1) {
-        exp.SetMostSigOp(*op1);
+enum class TokenKind {
+    Number,
+    Variable,
+    Function,
+    Plus,
+    Minus,
+    Star,
+    Slash,
+    Caret,
+    LeftParen,
+    RightParen,
+    Comma,
+    End,
+    Invalid,
+};
+
+struct Token {
+    TokenKind kind;
+    std::string_view text; ///< A view of the input, never a copy.
+    std::size_t offset;
+    double value = 0.0; ///< The value of a number.
+};
+
+constexpr std::array<std::string_view, 3> functions { "log", "dd", "in" };
+
+bool is_letter(const char c) { return std::isalpha(static_cast<unsigned char>(c)) != 0; }
+
+bool is_digit(const char c) { return std::isdigit(static_cast<unsigned char>(c)) != 0; }
+
+bool is_space(const char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; }
+
+// Splits the input into tokens on demand, one character of lookahead at a time.
+class Lexer {
+public:
+    explicit Lexer(const std::string_view source)
+        : source(source)
+    {
     }
-    if (op2) {
-        exp.SetLeastSigOp(*op2);
+
+    auto Next() -> Token
+    {
+        while (position < source.size() && is_space(source[position])) {
+            ++position;
+        }
+
+        const std::size_t start = position;
+
+        if (start == source.size()) {
+            return { TokenKind::End, {}, start };
+        }
+
+        const char c = source[start];
+
+        if (is_digit(c)) {
+            return LexNumber();
+        }
+
+        if (is_letter(c)) {
+            return LexWord();
+        }
+
+        ++position;
+
+        switch (c) {
+        case '+':
+            return { TokenKind::Plus, source.substr(start, 1), start };
+        case '-':
+            return { TokenKind::Minus, source.substr(start, 1), start };
+        case '*':
+            return { TokenKind::Star, source.substr(start, 1), start };
+        case '/':
+            return { TokenKind::Slash, source.substr(start, 1), start };
+        case '^':
+            return { TokenKind::Caret, source.substr(start, 1), start };
+        case '(':
+            return { TokenKind::LeftParen, source.substr(start, 1), start };
+        case ')':
+            return { TokenKind::RightParen, source.substr(start, 1), start };
+        case ',':
+            return { TokenKind::Comma, source.substr(start, 1), start };
+        default:
+            return { TokenKind::Invalid, source.substr(start, 1), start };
+        }
     }
-}
 
-bool processOp(std::stack<std::string>& ops, std::stack<std::unique_ptr<Oasis::Expression>>& st)
-{
-    if (st.size() < 2) {
-        throw std::runtime_error("Invalid number of arguments");
+private:
+    auto LexNumber() -> Token
+    {
+        const std::size_t start = position;
+        double value = 0.0;
+
+        // Only fixed notation, so that the "e" of "2e" is a variable rather than an exponent.
+        const auto [end, ec] = std::from_chars(source.data() + start, source.data() + source.size(), value, std::chars_format::fixed);
+        position = end - source.data();
+
+        if (ec != std::errc {}) {
+            return { TokenKind::Invalid, source.substr(start, position - start), start };
+        }
+
+        return { TokenKind::Number, source.substr(start, position - start), start, value };
     }
 
-    const std::unique_ptr<Oasis::Expression> right = std::move(st.top());
-    st.pop();
-
-    const std::unique_ptr<Oasis::Expression> left = std::move(st.top());
-    st.pop();
-
-    const auto op = ops.top();
-    assert(op.size() == 1);
-
-    std::unique_ptr<Oasis::Expression> opExp;
-
-    switch (op[0]) {
-    case '+': {
-        Oasis::Add<> add;
-        setOps(add, left, right);
-        opExp = add.Copy();
-    } break;
-    case '-': {
-        Oasis::Subtract<> subtract;
-        setOps(subtract, left, right);
-        opExp = subtract.Copy();
-    } break;
-    case '*': {
-        Oasis::Multiply<> multiply;
-        setOps(multiply, left, right);
-        opExp = multiply.Copy();
-    } break;
-    case '/': {
-        Oasis::Divide<> divide;
-        setOps(divide, left, right);
-        opExp = divide.Copy();
-    } break;
-    case '^': {
-        Oasis::Exponent<> exponent;
-        setOps(exponent, left, right);
-        opExp = exponent.Copy();
-        break;
+    // A word that is exactly a function name is a function. Otherwise, each letter is its own
+    // variable, optionally followed by a subscript.
+    auto LexWord() -> Token
+    {
+        const std::size_t start = position;
+
+        if (start == 0 || !is_letter(source[start - 1])) {
+            std::size_t end = start;
+
+            while (end < source.size() && is_letter(source[end])) {
+                ++end;
+            }
+
+            if (const std::string_view word = source.substr(start, end - start); std::ranges::find(functions, word) != functions.end()) {
+                position = end;
+                return { TokenKind::Function, word, start };
+            }
+        }
+
+        ++position;
+
+        if (position < source.size() && source[position] == '_') {
+            if (position + 1 < source.size() && source[position + 1] == '{') {
+                const std::size_t close = source.find('}', position + 2);
+
+                if (close == std::string_view::npos) {
+                    return { TokenKind::Invalid, source.substr(position + 1, 1), position + 1 };
+                }
+
+                position = close + 1;
+            } else if (position + 1 < source.size() && std::isalnum(static_cast<unsigned char>(source[position + 1]))) {
+                position += 2;
+            } else {
+                return { TokenKind::Invalid, source.substr(position, 1), position };
+            }
+        }
+
+        return { TokenKind::Variable, source.substr(start, position - start), start };
     }
-    default:
-        return false;
+
+    std::string_view source;
+    std::size_t position = 0;
+};
+
+// Binding powers, from loosest to tightest. Juxtaposition, as in "2x", binds tighter than "*" and
+// "/", so "1/2x" is "1/(2x)", but looser than "^", so "2x^2" is "2(x^2)" and "x^2y" is "(x^2)y".
+constexpr int sum_power = 10;
+constexpr int product_power = 20;
+constexpr int juxtaposition_power = 30;
+constexpr int negation_power = 40;
+constexpr int exponent_power = 50;
+
+// Guards against exhausting the stack on deeply nested input.
+constexpr int max_depth = 1024;
+
+// A precedence-climbing parser that builds each node as soon as its operands are parsed. On the
+// first error, it records the error and unwinds by returning null.
+class Parser {
+public:
+    explicit Parser(const std::string_view source)
+        : lexer(source)
+        , current(lexer.Next())
+    {
     }
 
-    st.emplace(std::move(opExp));
-    ops.pop();
-    return true;
-}
+    auto Parse() -> Oasis::ParseResult
+    {
+        auto expression = ParseExpression(0);
 
-bool processFunction(std::stack<std::unique_ptr<Oasis::Expression>>& st, const std::string& function_token)
-{
-    if (st.size() < 2) {
-        throw std::runtime_error("Invalid number of arguments");
-    }
+        if (expression && current.kind != TokenKind::End) {
+            Fail(current);
+        }
 
-    // If we have a function active, the second operand has just been pushed onto the stack
-    auto second_operand = std::move(st.top());
-    st.pop();
-    auto first_operand = std::move(st.top());
-    st.pop();
-
-    std::unique_ptr<Oasis::Expression> func;
-
-    if (function_token == "log") {
-        Oasis::Log<> log;
-        setOps(log, first_operand, second_operand);
-        func = log.Copy();
-    } else if (function_token == "dd") {
-        Oasis::Derivative<> dd;
-        setOps(dd, first_operand, second_operand);
-        func = dd.Copy();
-    } else if (function_token == "in") {
-        Oasis::Integral<> in;
-        setOps(in, first_operand, second_operand);
-        func = in.Copy();
-    } else {
-        return false;
+        if (error) {
+            return Oasis::ParseResult { std::move(*error) };
+        }
+
+        return Oasis::ParseResult { std::move(expression) };
     }
 
-    st.emplace(std::move(func));
-    return true;
-}
+private:
+    auto ParseExpression(const int minPower) -> std::unique_ptr<Oasis::Expression>
+    {
+        if (depth == max_depth) {
+            return Fail("Expression is nested too deeply", current.offset);
+        }
 
-std::vector<std::string> tokenizeMultiplicands(const std::string& expression)
-{
-    // Insert '*' between digits and letters, and letters and digits
-    std::string explicit_multiplication;
-    for (size_t i = 0; i < expression.size(); i++) {
-        explicit_multiplication += expression[i];
-        if (i < expression.size() - 1) {
-            bool is_digit = isdigit(expression[i]);
-            bool is_letter = isalpha(expression[i]);
-            bool is_digit_next = isdigit(expression[i + 1]);
-            bool is_letter_next = isalpha(expression[i + 1]);
-
-            if ((is_digit && is_letter_next) || (is_letter && is_digit_next)) {
-                explicit_multiplication += '*';
+        ++depth;
+        auto lhs = ParsePrefix();
+        std::size_t lhsHeight = height;
+
+        while (lhs) {
+            const TokenKind kind = current.kind;
+            const int power = InfixPower(kind);
+
+            if (power <= minPower) {
+                break;
+            }
+
+            const bool implicit = kind == TokenKind::Number || kind == TokenKind::Variable || kind == TokenKind::Function || kind == TokenKind::LeftParen;
+
+            if (!implicit) {
+                Advance();
             }
 
-            if (is_letter && is_letter_next) {
-                explicit_multiplication += '*';
+            // "^" is right-associative, so its right operand may itself contain a "^".
+            auto rhs = ParseExpression(kind == TokenKind::Caret ? power - 1 : power);
+
+            if (!rhs) {
+                lhs = nullptr;
+                break;
+            }
+
+            lhsHeight = std::max(lhsHeight, height) + 1;
+
+            if (lhsHeight > Oasis::max_height) {
+                lhs = Fail("Expression is nested too deeply", current.offset);
+                break;
+            }
+
+            switch (kind) {
+            case TokenKind::Plus:
+                lhs = Oasis::MakeBinaryNode<Oasis::Add>(std::move(lhs), std::move(rhs));
+                break;
+            case TokenKind::Minus:
+                lhs = Oasis::MakeBinaryNode<Oasis::Subtract>(std::move(lhs), std::move(rhs));
+                break;
+            case TokenKind::Slash:
+                lhs = Oasis::MakeBinaryNode<Oasis::Divide>(std::move(lhs), std::move(rhs));
+                break;
+            case TokenKind::Caret:
+                lhs = Oasis::MakeBinaryNode<Oasis::Exponent>(std::move(lhs), std::move(rhs));
+                break;
+            default:
+                lhs = Oasis::MakeBinaryNode<Oasis::Multiply>(std::move(lhs), std::move(rhs));
+                break;
             }
         }
+
+        --depth;
+        height = lhsHeight;
+        return lhs;
     }
 
-    // Tokenize on '*'
-    std::vector<std::string> tokens;
-    std::string buffer;
-    bool inside_braces = false;
-
-    for (char c : explicit_multiplication) {
-        if (c == '{')
-            inside_braces = true;
-        if (c == '}')
-            inside_braces = false;
-
-        if (c == '*' && !inside_braces) {
-            tokens.push_back(buffer);
-            buffer.clear();
-        } else {
-            buffer += c;
+    auto ParsePrefix() -> std::unique_ptr<Oasis::Expression>
+    {
+        const Token token = current;
+
+        switch (token.kind) {
+        case TokenKind::Number:
+            Advance();
+            height = 1;
+            return std::make_unique<Oasis::Real>(token.value);
+        case TokenKind::Variable:
+            Advance();
+            height = 1;
+
+            if (token.text == "i") {
+                return std::make_unique<Oasis::Imaginary>();
+            }
+
+            return std::make_unique<Oasis::Variable>(std::string { token.text });
+        case TokenKind::Plus:
+            Advance();
+            return ParseExpression(negation_power);
+        case TokenKind::Minus: {
+            Advance();
+            const bool literal = current.kind == TokenKind::Number;
+            auto operand = ParseExpression(negation_power);
+
+            if (!operand) {
+                return nullptr;
+            }
+
+            // Negative literals stay literals, but "-(3)" is a negation.
+            if (literal && operand->Is<Oasis::Real>()) {
+                return std::make_unique<Oasis::Real>(-static_cast<const Oasis::Real&>(*operand).GetValue());
+            }
+
+            auto negation = std::make_unique<Oasis::Negate<Oasis::Expression>>();
+            negation->SetOperand(std::shared_ptr<const Oasis::Expression> { std::move(operand) });
+            ++height;
+            return negation;
+        }
+        case TokenKind::LeftParen: {
+            Advance();
+            auto expression = ParseExpression(0);
+            return Expect(TokenKind::RightParen, "Expected \")\"") ? std::move(expression) : nullptr;
+        }
+        case TokenKind::Function:
+            Advance();
+            return ParseFunction(token);
+        case TokenKind::End:
+            return Fail("Expected an expression", token.offset);
+        default:
+            return Fail(token);
         }
     }
 
-    tokens.push_back(buffer); // push back the last token
+    auto ParseFunction(const Token& name) -> std::unique_ptr<Oasis::Expression>
+    {
+        if (!Expect(TokenKind::LeftParen, fmt::format(R"(Expected "(" after "{}")", name.text))) {
+            return nullptr;
+        }
 
-    return tokens;
-}
+        auto first = ParseExpression(0);
+        const std::size_t firstHeight = height;
 
-template <typename First, typename... T>
-bool is_in(First&& first, T&&... t)
-{
-    return ((first == t) || ...);
-}
+        if (!first || !Expect(TokenKind::Comma, fmt::format(R"(Expected "," between the arguments of "{}")", name.text))) {
+            return nullptr;
+        }
 
-bool is_operator(const std::string& token) { return is_in(token, "+", "-", "*", "/", "^"); }
+        auto second = ParseExpression(0);
 
-bool is_function(const std::string& token) { return is_in(token, "log", "dd", "in"); }
+        if (!second || !Expect(TokenKind::RightParen, "Expected \")\"")) {
+            return nullptr;
+        }
 
-bool is_number(const std::string& token) { return std::regex_match(token, std::regex(R"(^-?\d+(\.\d+)?$)")); }
+        height = std::max(firstHeight, height) + 1;
 
-std::unique_ptr<Oasis::Expression> multiplyFromVariables(const std::vector<std::string>& tokens)
-{
-    std::vector<std::unique_ptr<Oasis::Expression>> multiplicands;
-    std::ranges::transform(tokens, std::back_inserter(multiplicands), [](auto token) -> std::unique_ptr<Oasis::Expression> {
-        if (is_number(token)) {
-            return std::make_unique<Oasis::Real>(std::stof(token));
+        if (name.text == "log") {
+            return Oasis::MakeBinaryNode<Oasis::Log>(std::move(first), std::move(second));
         }
 
-        if (token == "i") {
-            return std::make_unique<Oasis::Imaginary>();
+        if (name.text == "dd") {
+            return Oasis::MakeBinaryNode<Oasis::Derivative>(std::move(first), std::move(second));
         }
 
-        return std::make_unique<Oasis::Variable>(token);
-    });
+        return Oasis::MakeBinaryNode<Oasis::Integral>(std::move(first), std::move(second));
+    }
+
+    static auto InfixPower(const TokenKind kind) -> int
+    {
+        switch (kind) {
+        case TokenKind::Plus:
+        case TokenKind::Minus:
+            return sum_power;
+        case TokenKind::Star:
+        case TokenKind::Slash:
+            return product_power;
+        case TokenKind::Number:
+        case TokenKind::Variable:
+        case TokenKind::Function:
+        case TokenKind::LeftParen:
+            return juxtaposition_power;
+        case TokenKind::Caret:
+            return exponent_power;
+        default:
+            return 0;
+        }
+    }
+
+    auto Advance() -> void
+    {
+        current = lexer.Next();
+    }
+
+    auto Expect(const TokenKind kind, std::string_view message) -> bool
+    {
+        if (error) {
+            return false;
+        }
+
+        if (current.kind != kind) {
+            Fail(message, current.offset);
+            return false;
+        }
+
+        Advance();
+        return true;
+    }
+
+    auto Fail(const std::string_view message, const std::size_t offset) -> std::unique_ptr<Oasis::Expression>
+    {
+        if (!error) {
+            error = Oasis::ParseError { std::string { message }, offset };
+        }
+
+        return nullptr;
+    }
+
+    auto Fail(const Token& token) -> std::unique_ptr<Oasis::Expression>
+    {
+        if (token.kind == TokenKind::Invalid) {
+            return Fail(fmt::format(R"(Unexpected character "{}")", token.text), token.offset);
+        }
 
-    if (multiplicands.size() == 1) {
-        return std::move(multiplicands.front());
+        return Fail(fmt::format(R"(Unexpected "{}")", token.text), token.offset);
     }
 
-    return Oasis::BuildFromVector<Oasis::Multiply>(multiplicands);
+    Lexer lexer;
+    Token current;
+    std::optional<Oasis::ParseError> error;
+    int depth = 0;
+    std::size_t height = 0; ///< The height of the tree most recently parsed.
+};
+
+// The number of lines each task parses. Enough to amortize scheduling a task.
+constexpr std::size_t lines_per_task = 256;
+
+auto splitLines(const std::string_view text) -> std::vector<std::string_view>
+{
+    std::vector<std::string_view> lines;
+    const char* begin = text.data();
+    const char* const end = text.data() + text.size();
+
+    while (begin != end) {
+        const auto* newline = static_cast<const char*>(std::memchr(begin, '\n', end - begin));
+        const char* const lineEnd = newline != nullptr ? newline : end;
+        lines.emplace_back(begin, lineEnd - begin);
+        begin = newline != nullptr ? newline + 1 : end;
+    }
+
+    return lines;
 }
 
 }
@@ -220,7 +460,10 @@ ParseResult::ParseResult(std::unique_ptr<Expression> expr) {
     result = std::move(expr);
 }
 
-ParseResult::ParseResult(std::string err) : result(err) {
+ParseResult::ParseResult(std::string err) : result(ParseError { std::move(err), 0 }) {
+}
+
+ParseResult::ParseResult(ParseError err) : result(std::move(err)) {
 }
 
 bool ParseResult::Ok() const {
@@ -233,86 +476,68 @@ auto ParseResult::GetResult() const -> const Expression & {
 
 std::string ParseResult::GetErrorMessage() const
 {
-    if (const auto message = std::get_if<std::string>(&result)) {
-        return *message;
+    if (const auto error = std::get_if<ParseError>(&result)) {
+        return error->message;
     }
 
     return "No Error";
 }
 
-auto FromInFix(const std::string& str) -> ParseResult {
-    // Based off Dijkstra's Shunting Yard
+std::size_t ParseResult::GetErrorOffset() const
+{
+    if (const auto error = std::get_if<ParseError>(&result)) {
+        return error->offset;
+    }
 
-    std::stack<std::unique_ptr<Expression>> st;
-    std::stack<std::string> ops;
+    return 0;
+}
 
-    std::string token, function_token;
-    std::stringstream ss(str);
+auto FromInFix(const std::string_view str) -> ParseResult {
+    return Parser { str }.Parse();
+}
 
-    while (ss >> token) {
-        // Operand
-        if (is_number(token)) {
-            st.push(std::make_unique<Real>(std::stof(token)));
-        }
-        // '(' or function
-        else if (token == "(" || is_function(token)) {
-            ops.push(token);
-        }
-        // ','
-        else if (token == ",") {
-            // function_active = true;
-            while (!ops.empty() && ops.top() != "(") {
-                if (!processOp(ops, st)) {
-                    return ParseResult { fmt::format(R"(Unknown operator: "{}")", token) };
-                }
-            }
-        }
-        // ')'
-        else if (token == ")") {
-            while (!ops.empty() && ops.top() != "(") {
-                if (!processOp(ops, st)) {
-                    return ParseResult { fmt::format(R"(Unknown operator: "{}")", token) };
-                }
-            }
+auto FromInFixLines(const std::string_view text) -> std::vector<ParseResult>
+{
+    return FromInFixLines(text, Runtime::Current());
+}
 
-            if (ops.empty() || ops.top() != "(") {
-                throw std::runtime_error("Mismatched parenthesis");
-            }
+auto FromInFixLines(const std::string_view text, Runtime& runtime) -> std::vector<ParseResult>
+{
+    const std::vector<std::string_view> lines = splitLines(text);
 
-            ops.pop(); // pop '('
-            if (!ops.empty() && is_function(ops.top())) {
-                std::string func = ops.top();
-                ops.pop();
-                if (!processFunction(st, func)) {
-                    return ParseResult { fmt::format(R"(Unknown function: "{}")", token) };
-                }
-            }
-        }
-        // Operator
-        else if (is_operator(token)) {
-            while (!ops.empty() && prec(ops.top()[0]) >= prec(token[0])) {
-                if (!processOp(ops, st)) {
-                    return ParseResult { fmt::format(R"(Unknown operator: "{}")", token) };
-                }
-            }
-            ops.push(token);
-        } else if (ss.peek() != '(') {
-            st.push(multiplyFromVariables(tokenizeMultiplicands(token)));
-        }
+    // Placeholders, so that each task can assign its results in place.
+    std::vector<ParseResult> results;
+    results.reserve(lines.size());
+
+    for (std::size_t i = 0; i < lines.size(); ++i) {
+        results.emplace_back(ParseError {});
     }
 
-    // Process remaining ops
-    while (!ops.empty()) {
-        if (!processOp(ops, st)) {
-            return ParseResult { fmt::format(R"(Unknown operator: "{}")", token) };
+    const std::size_t tasks = (lines.size() + lines_per_task - 1) / lines_per_task;
+
+    tf::Taskflow taskflow;
+
+    taskflow.for_each_index(std::size_t { 0 }, tasks, std::size_t { 1 }, [&lines, &results](std::size_t task) {
+        const std::size_t end = std::min((task + 1) * lines_per_task, lines.size());
+
+        for (std::size_t i = task * lines_per_task; i < end; ++i) {
+            results[i] = FromInFix(lines[i]);
         }
-    }
+    });
 
-    if (st.empty()) {
-        return ParseResult { "Parsing failed" };
-    }
+    runtime.GetExecutor().run(taskflow).wait();
+    return results;
+}
+
+auto FromInFixFile(const std::filesystem::path& path) -> std::vector<ParseResult>
+{
+    return FromInFixFile(path, Runtime::Current());
+}
 
-    return ParseResult { st.top()->Copy() }; // root of the expression tree
+auto FromInFixFile(const std::filesystem::path& path, Runtime& runtime) -> std::vector<ParseResult>
+{
+    const MappedFile file { path };
+    return FromInFixLines(file.GetText(), runtime);
 }
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,17 @@
+#include <memory>
+#include <span>
+
+#include "Oasis/FrozenFile.hpp"
+
+#include "MappedFile.hpp"
+
+namespace Oasis {
+
+auto FromFrozenFile(const std::filesystem::path& path) -> FrozenExpression
+{
+    auto file = std::make_shared<const MappedFile>(path);
+    const std::string_view text = file->GetText();
+    return FrozenExpression::FromBytes(std::as_bytes(std::span { text.data(), text.size() }), std::move(file));
+}
+
+} // Oasis
@@ -2,6 +2,10 @@
 // Created by Matthew McCall on 4/28/24.
 //
 
+#include <array>
+#include <charconv>
+#include <cmath>
+
 #include <fmt/core.h>
 
 #include "Oasis/InFixSerializer.hpp"
@@ -12,133 +16,257 @@
 #include "Oasis/Exponent.hpp"
 #include "Oasis/Integral.hpp"
 #include "Oasis/Log.hpp"
+#include "Oasis/Matrix.hpp"
 #include "Oasis/Multiply.hpp"
 #include "Oasis/Negate.hpp"
 #include "Oasis/Real.hpp"
 #include "Oasis/Subtract.hpp"
 #include "Oasis/Variable.hpp"
 
-namespace Oasis {
+namespace {
 
-void InFixSerializer::Serialize(const Real& real)
+// Precedences, from loosest to tightest, matching those of FromInFix.
+constexpr int sum_precedence = 1;
+constexpr int product_precedence = 2;
+constexpr int negation_precedence = 3;
+constexpr int exponent_precedence = 4;
+constexpr int atom_precedence = 5;
+
+int precedence(const Oasis::Expression& expression)
 {
-    result = fmt::format("{:.5}", real.GetValue());
+    switch (expression.GetType()) {
+    case Oasis::ExpressionType::Add:
+    case Oasis::ExpressionType::Subtract:
+        return sum_precedence;
+    case Oasis::ExpressionType::Multiply:
+    case Oasis::ExpressionType::Divide:
+        return product_precedence;
+    case Oasis::ExpressionType::Negate:
+        return negation_precedence;
+    case Oasis::ExpressionType::Exponent:
+        return exponent_precedence;
+    case Oasis::ExpressionType::Real:
+        // A negative number is written with a leading minus, so it binds like a negation.
+        return std::signbit(static_cast<const Oasis::Real&>(expression).GetValue()) ? negation_precedence : atom_precedence;
+    default:
+        return atom_precedence;
+    }
 }
 
-void InFixSerializer::Serialize(const Imaginary& imaginary)
+// Fixed notation, since FromInFix does not read exponents, with as many digits as it takes to read
+// back the same value. The longest such number, the smallest subnormal, has fewer than 350 characters.
+void formatExact(fmt::memory_buffer& out, const double value)
 {
-    result = "i";
+    std::array<char, 512> digits {};
+    const char* const end = std::to_chars(digits.data(), digits.data() + digits.size(), value, std::chars_format::fixed).ptr;
+    out.append(digits.data(), end);
 }
 
-void InFixSerializer::Serialize(const Variable& variable)
-{
-    result = variable.GetName();
 }
 
-void InFixSerializer::Serialize(const Undefined& undefined)
+namespace Oasis {
+
+InFixSerializer::InFixSerializer(Parentheses parentheses)
+    : out(&buffer)
+    , parentheses(parentheses)
 {
-    result = "Undefined";
 }
 
-void InFixSerializer::Serialize(const Add<>& add)
+InFixSerializer::InFixSerializer(fmt::memory_buffer& out, Parentheses parentheses)
+    : out(&out)
+    , parentheses(parentheses)
 {
-    add.GetMostSigOp().Serialize(*this);
-    const auto mostSigOpStr = getResult();
+}
 
-    add.GetLeastSigOp().Serialize(*this);
-    const auto leastSigOpStr = getResult();
+void InFixSerializer::Serialize(const Real& real)
+{
+    BeginExpression();
+    SerializeNumber(real.GetValue());
+}
 
-    result = fmt::format("({}+{})", mostSigOpStr, leastSigOpStr);
+void InFixSerializer::Serialize(const Imaginary&)
+{
+    BeginExpression();
+    out->push_back('i');
 }
 
-void InFixSerializer::Serialize(const Subtract<>& subtract)
+void InFixSerializer::Serialize(const Matrix& matrix)
 {
-    subtract.GetMostSigOp().Serialize(*this);
-    const auto mostSigOpStr = getResult();
+    BeginExpression();
+    const auto& mat = matrix.GetMatrix();
+
+    out->push_back('[');
 
-    subtract.GetLeastSigOp().Serialize(*this);
-    const auto leastSigOpStr = getResult();
+    for (Eigen::Index r = 0; r < mat.rows(); ++r) {
+        out->append(std::string_view { r == 0 ? "[" : ",[" });
 
-    result = fmt::format("({}-{})", mostSigOpStr, leastSigOpStr);
+        for (Eigen::Index c = 0; c < mat.cols(); ++c) {
+            if (c != 0) {
+                out->push_back(',');
+            }
+
+            SerializeNumber(mat(r, c));
+        }
+
+        out->push_back(']');
+    }
+
+    out->push_back(']');
 }
 
-void InFixSerializer::Serialize(const Multiply<>& multiply)
+void InFixSerializer::Serialize(const Variable& variable)
 {
-    multiply.GetMostSigOp().Serialize(*this);
-    const auto mostSigOpStr = getResult();
+    BeginExpression();
+    out->append(std::string_view { variable.GetName() });
+}
 
-    multiply.GetLeastSigOp().Serialize(*this);
-    const auto leastSigOpStr = getResult();
+void InFixSerializer::Serialize(const Undefined&)
+{
+    BeginExpression();
+    out->append(std::string_view { "Undefined" });
+}
 
-    result = fmt::format("({}*{})", mostSigOpStr, leastSigOpStr);
+void InFixSerializer::Serialize(const Add<>& add)
+{
+    BeginExpression();
+    SerializeBinary(add.GetMostSigOp(), add.GetLeastSigOp(), '+', sum_precedence);
 }
 
-void InFixSerializer::Serialize(const Divide<>& divide)
+void InFixSerializer::Serialize(const Subtract<>& subtract)
 {
-    divide.GetMostSigOp().Serialize(*this);
-    const auto mostSigOpStr = getResult();
+    BeginExpression();
+    SerializeBinary(subtract.GetMostSigOp(), subtract.GetLeastSigOp(), '-', sum_precedence);
+}
 
-    divide.GetLeastSigOp().Serialize(*this);
-    const auto leastSigOpStr = getResult();
+void InFixSerializer::Serialize(const Multiply<>& multiply)
+{
+    BeginExpression();
+    SerializeBinary(multiply.GetMostSigOp(), multiply.GetLeastSigOp(), '*', product_precedence);
+}
 
-    result = fmt::format("({}/{})", mostSigOpStr, leastSigOpStr);
+void InFixSerializer::Serialize(const Divide<>& divide)
+{
+    BeginExpression();
+    SerializeBinary(divide.GetMostSigOp(), divide.GetLeastSigOp(), '/', product_precedence);
 }
 
 void InFixSerializer::Serialize(const Exponent<>& exponent)
 {
-    exponent.GetMostSigOp().Serialize(*this);
-    const auto mostSigOpStr = getResult();
+    BeginExpression();
+    SerializeBinary(exponent.GetMostSigOp(), exponent.GetLeastSigOp(), '^', exponent_precedence);
+}
 
-    exponent.GetLeastSigOp().Serialize(*this);
-    const auto leastSigOpStr = getResult();
+void InFixSerializer::Serialize(const Log<>& log)
+{
+    BeginExpression();
+    SerializeFunction("log", log.GetMostSigOp(), log.GetLeastSigOp());
+}
 
-    result = fmt::format("({}^{})", mostSigOpStr, leastSigOpStr);
+void InFixSerializer::Serialize(const Negate<Expression>& negate)
+{
+    BeginExpression();
+    out->push_back('-');
+
+    // FromInFix reads a minus sign directly before a number as part of the number.
+    const Expression& operand = negate.GetOperand();
+    SerializeOperand(operand, parentheses == Parentheses::All || operand.Is<Real>() || precedence(operand) < negation_precedence);
 }
 
-void InFixSerializer::Serialize(const Log<>& log)
+void InFixSerializer::Serialize(const Derivative<>& derivative)
 {
-    log.GetMostSigOp().Serialize(*this);
-    const auto mostSigOpStr = getResult();
+    BeginExpression();
+    SerializeFunction("dd", derivative.GetMostSigOp(), derivative.GetLeastSigOp());
+}
 
-    log.GetLeastSigOp().Serialize(*this);
-    const auto leastSigOpStr = getResult();
+void InFixSerializer::Serialize(const Integral<>& integral)
+{
+    BeginExpression();
+    SerializeFunction("in", integral.GetMostSigOp(), integral.GetLeastSigOp());
+}
 
-    result = fmt::format("log({},{})", mostSigOpStr, leastSigOpStr);
+std::string InFixSerializer::getResult() const
+{
+    return std::string { GetView() };
 }
 
-void InFixSerializer::Serialize(const Negate<Expression>& negate)
+std::string_view InFixSerializer::GetView() const
 {
-    negate.GetOperand().Serialize(*this);
-    const auto opStr = getResult();
+    return { out->data() + start, out->size() - start };
+}
 
-    result = fmt::format("-({})", opStr);
+void InFixSerializer::Clear()
+{
+    out->clear();
+    start = 0;
 }
 
-void InFixSerializer::Serialize(const Derivative<>& derivative)
+void InFixSerializer::BeginExpression()
 {
-    derivative.GetMostSigOp().Serialize(*this);
-    const auto mostSigOpStr = getResult();
+    if (nesting != 0) {
+        return;
+    }
 
-    derivative.GetLeastSigOp().Serialize(*this);
-    const auto leastSigOpStr = getResult();
+    if (out == &buffer) {
+        buffer.clear();
+    }
 
-    result = fmt::format("dd({},{})", mostSigOpStr, leastSigOpStr);
+    start = out->size();
 }
 
-void InFixSerializer::Serialize(const Integral<>& integral)
+void InFixSerializer::SerializeNumber(const double value)
 {
-    integral.GetMostSigOp().Serialize(*this);
-    const auto mostSigOpStr = getResult();
+    if (parentheses == Parentheses::Minimal) {
+        formatExact(*out, value);
+    } else {
+        fmt::format_to(fmt::appender(*out), "{:.5}", value);
+    }
+}
 
-    integral.GetLeastSigOp().Serialize(*this);
-    const auto leastSigOpStr = getResult();
+void InFixSerializer::SerializeBinary(const Expression& mostSigOp, const Expression& leastSigOp, const char op, const int precedence)
+{
+    if (parentheses == Parentheses::All) {
+        out->push_back('(');
+        SerializeOperand(mostSigOp, false);
+        out->push_back(op);
+        SerializeOperand(leastSigOp, false);
+        out->push_back(')');
+        return;
+    }
+
+    // "^" is right-associative and the other operators are left-associative, so an operand of
+    // equal precedence needs parentheses only on the other side.
+    const bool rightAssociative = op == '^';
+    const int mostSigPrecedence = ::precedence(mostSigOp);
+    const int leastSigPrecedence = ::precedence(leastSigOp);
+
+    SerializeOperand(mostSigOp, rightAssociative ? mostSigPrecedence <= precedence : mostSigPrecedence < precedence);
+    out->push_back(op);
+    SerializeOperand(leastSigOp, rightAssociative ? leastSigPrecedence < precedence : leastSigPrecedence <= precedence);
+}
 
-    result = fmt::format("in({},{})", mostSigOpStr, leastSigOpStr);
+void InFixSerializer::SerializeFunction(const std::string_view name, const Expression& first, const Expression& second)
+{
+    out->append(name);
+    out->push_back('(');
+    SerializeOperand(first, false);
+    out->push_back(',');
+    SerializeOperand(second, false);
+    out->push_back(')');
 }
 
-std::string InFixSerializer::getResult() const
+void InFixSerializer::SerializeOperand(const Expression& operand, const bool parenthesize)
 {
-    return result;
+    if (parenthesize) {
+        out->push_back('(');
+    }
+
+    ++nesting;
+    operand.Serialize(*this);
+    --nesting;
+
+    if (parenthesize) {
+        out->push_back(')');
+    }
 }
 
-} // Oasis
\ No newline at end of file
+} // Oasis
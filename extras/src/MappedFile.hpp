@@ -0,0 +1,103 @@
+#ifndef OASIS_MAPPEDFILE_HPP
+#define OASIS_MAPPEDFILE_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <stdexcept>
+#include <string_view>
+
+#ifdef _WIN32
+#include <fstream>
+#include <iterator>
+#include <string>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "fmt/format.h"
+
+namespace Oasis {
+
+/**
+ * A read-only view of a whole file. Where available, the file is mapped into memory rather than
+ * read, so its contents are never copied.
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::filesystem::path& path)
+    {
+#ifdef _WIN32
+        std::ifstream file { path, std::ios::binary };
+
+        if (!file) {
+            throw std::runtime_error(fmt::format(R"(Could not open "{}")", path.string()));
+        }
+
+        contents.assign(std::istreambuf_iterator<char> { file }, std::istreambuf_iterator<char> {});
+#else
+        const int descriptor = open(path.c_str(), O_RDONLY);
+
+        if (descriptor == -1) {
+            throw std::runtime_error(fmt::format(R"(Could not open "{}")", path.string()));
+        }
+
+        struct stat status { };
+
+        if (fstat(descriptor, &status) == -1) {
+            close(descriptor);
+            throw std::runtime_error(fmt::format(R"(Could not read "{}")", path.string()));
+        }
+
+        size = static_cast<std::size_t>(status.st_size);
+
+        // Mapping an empty file fails, but there is nothing to map anyway.
+        if (size > 0) {
+            data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        }
+
+        close(descriptor);
+
+        if (data == MAP_FAILED) {
+            throw std::runtime_error(fmt::format(R"(Could not map "{}")", path.string()));
+        }
+
+        madvise(data, size, MADV_SEQUENTIAL);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    auto operator=(const MappedFile&) -> MappedFile& = delete;
+
+    ~MappedFile()
+    {
+#ifndef _WIN32
+        if (data != nullptr && data != MAP_FAILED) {
+            munmap(data, size);
+        }
+#endif
+    }
+
+    [[nodiscard]] auto GetText() const -> std::string_view
+    {
+#ifdef _WIN32
+        return contents;
+#else
+        return { static_cast<const char*>(data), size };
+#endif
+    }
+
+private:
+#ifdef _WIN32
+    std::string contents;
+#else
+    void* data = nullptr;
+    std::size_t size = 0;
+#endif
+};
+
+} // Oasis
+
+#endif // OASIS_MAPPEDFILE_HPP
@@ -48,7 +48,7 @@ void MathMLSerializer::Serialize(const Matrix& matrix)
     tinyxml2::XMLElement* closeBrace = doc.NewElement("mo");
     closeBrace->SetText("]");
 
-    auto mat = matrix.GetMatrix();
+    const auto& mat = matrix.GetMatrix();
 
     tinyxml2::XMLElement* table = doc.NewElement("mtable");
 
@@ -98,13 +98,15 @@ void MathMLSerializer::Serialize(const Undefined& undefined)
 {
     tinyxml2::XMLElement* const mtext = doc.NewElement("mtext");
     mtext->SetText("Undefined");
+
+    result = mtext;
 }
 
 void MathMLSerializer::Serialize(const Add<>& add)
 {
     tinyxml2::XMLElement* mrow = doc.NewElement("mrow");
 
-    std::vector<std::unique_ptr<Expression>> ops;
+    std::vector<std::shared_ptr<const Expression>> ops;
     add.Flatten(ops);
 
     for (const auto& op : ops) {
@@ -170,7 +172,7 @@ void MathMLSerializer::Serialize(const Multiply<>& multiply)
 {
     tinyxml2::XMLElement* mrow = doc.NewElement("mrow");
 
-    std::vector<std::unique_ptr<Expression>> ops;
+    std::vector<std::shared_ptr<const Expression>> ops;
     multiply.Flatten(ops);
 
     bool surroundWithParens = !ops[0]->Is<Real>() && !ops[0]->Is<Variable>() && !ops[0]->Is<Exponent>() && !ops[0]->Is<Log>();
@@ -0,0 +1,388 @@
+#include <cstdio>
+
+#include "Oasis/MathMLWriter.hpp"
+
+#include "Oasis/Add.hpp"
+#include "Oasis/Derivative.hpp"
+#include "Oasis/Divide.hpp"
+#include "Oasis/Exponent.hpp"
+#include "Oasis/Integral.hpp"
+#include "Oasis/Log.hpp"
+#include "Oasis/Matrix.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Negate.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Subtract.hpp"
+#include "Oasis/Variable.hpp"
+
+namespace {
+
+// Mirrors the parenthesization of factors in MathMLSerializer.
+auto IsBareFactor(const Oasis::Expression& factor) -> bool
+{
+    return factor.Is<Oasis::Real>() || factor.Is<Oasis::Variable>() || factor.Is<Oasis::Exponent>() || factor.Is<Oasis::Log>();
+}
+
+}
+
+namespace Oasis {
+
+MathMLWriter::MathMLWriter(std::ostream& out)
+    : out(out)
+{
+}
+
+void MathMLWriter::Serialize(const Real& real)
+{
+    BeginLine();
+    fmt::format_to(fmt::appender(buffer), "<mn>{:.5}</mn>", real.GetValue());
+    EndElement();
+}
+
+void MathMLWriter::Serialize(const Imaginary&)
+{
+    PushElement("mi", "i");
+}
+
+void MathMLWriter::Serialize(const Matrix& matrix)
+{
+    const auto& mat = matrix.GetMatrix();
+
+    OpenElement("mrow");
+    PushElement("mo", "[");
+    OpenElement("mtable");
+
+    for (Eigen::Index r = 0; r < mat.rows(); ++r) {
+        OpenElement("mtr");
+
+        for (Eigen::Index c = 0; c < mat.cols(); ++c) {
+            OpenElement("mtd");
+
+            // tinyxml2 writes the text of a number with this format.
+            char text[32];
+            const int length = std::snprintf(text, sizeof text, "%.*g", 17, mat(r, c));
+            PushElement("mn", { text, static_cast<std::size_t>(length) });
+
+            CloseElement("mtd");
+        }
+
+        CloseElement("mtr");
+    }
+
+    CloseElement("mtable");
+    PushElement("mo", "]");
+    CloseElement("mrow");
+}
+
+void MathMLWriter::Serialize(const Variable& variable)
+{
+    BeginLine();
+    buffer.append(std::string_view { "<mi>" });
+    PushEscaped(variable.GetName());
+    buffer.append(std::string_view { "</mi>" });
+    EndElement();
+}
+
+void MathMLWriter::Serialize(const Undefined&)
+{
+    PushElement("mtext", "Undefined");
+}
+
+void MathMLWriter::Serialize(const Add<>& add)
+{
+    const std::size_t begin = PushOperands(add);
+
+    OpenElement("mrow");
+
+    for (std::size_t i = begin; i < operands.size(); ++i) {
+        if (i != begin) {
+            PushElement("mo", "+");
+        }
+
+        operands[i]->Serialize(*this);
+    }
+
+    CloseElement("mrow");
+
+    operands.resize(begin);
+}
+
+void MathMLWriter::Serialize(const Subtract<>& subtract)
+{
+    const Expression* subtrahend = subtract.GetChild(1);
+    const bool surroundWithParens = !(subtrahend != nullptr && subtrahend->Is<Real>() && static_cast<const Real&>(*subtrahend).GetValue() >= 0);
+
+    OpenElement("mrow");
+    PushOperand(subtract.GetChild(0));
+    PushElement("mo", "-");
+
+    if (surroundWithParens) {
+        PushElement("mo", "(");
+    }
+
+    PushOperand(subtrahend);
+
+    if (surroundWithParens) {
+        PushElement("mo", ")");
+    }
+
+    CloseElement("mrow");
+}
+
+void MathMLWriter::Serialize(const Multiply<>& multiply)
+{
+    const std::size_t begin = PushOperands(multiply);
+
+    OpenElement("mrow");
+
+    for (std::size_t i = begin; i < operands.size(); ++i) {
+        const Expression& factor = *operands[i];
+
+        if (i != begin && operands[i - 1]->Is<Real>() && factor.Is<Real>()) {
+            PushElement("mo", "\u00D7");
+        }
+
+        const bool surroundWithParens = !IsBareFactor(factor);
+
+        if (surroundWithParens) {
+            PushElement("mo", "(");
+        }
+
+        factor.Serialize(*this);
+
+        if (surroundWithParens) {
+            PushElement("mo", ")");
+        }
+    }
+
+    CloseElement("mrow");
+
+    operands.resize(begin);
+}
+
+void MathMLWriter::Serialize(const Divide<>& divide)
+{
+    OpenElement("mfrac");
+    PushOperand(divide.GetChild(0));
+    PushOperand(divide.GetChild(1));
+    CloseElement("mfrac");
+}
+
+void MathMLWriter::Serialize(const Exponent<>& exponent)
+{
+    const Expression* base = exponent.GetChild(0);
+
+    OpenElement("msup");
+
+    if (base != nullptr && !base->Is<Real>() && !base->Is<Variable>()) {
+        OpenElement("mrow");
+        PushElement("mo", "(");
+        base->Serialize(*this);
+        PushElement("mo", ")");
+        CloseElement("mrow");
+    } else {
+        PushOperand(base);
+    }
+
+    PushOperand(exponent.GetChild(1));
+    CloseElement("msup");
+}
+
+void MathMLWriter::Serialize(const Log<>& log)
+{
+    OpenElement("mrow");
+
+    OpenElement("msub");
+    PushElement("mi", "log");
+    PushOperand(log.GetChild(0));
+    CloseElement("msub");
+
+    PushElement("mo", "(");
+    PushOperand(log.GetChild(1));
+    PushElement("mo", ")");
+
+    CloseElement("mrow");
+}
+
+void MathMLWriter::Serialize(const Negate<Expression>& negate)
+{
+    OpenElement("mrow");
+    PushElement("mo", "-");
+    PushElement("mo", "(");
+    PushOperand(negate.GetChild(0));
+    PushElement("mo", ")");
+    CloseElement("mrow");
+}
+
+void MathMLWriter::Serialize(const Derivative<>& derivative)
+{
+    OpenElement("mrow");
+
+    OpenElement("mfrac");
+    PushElement("mo", "d");
+    OpenElement("mrow");
+    PushElement("mo", "d");
+    PushOperand(derivative.GetChild(1));
+    CloseElement("mrow");
+    CloseElement("mfrac");
+
+    PushElement("mo", "(");
+    PushOperand(derivative.GetChild(0));
+    PushElement("mo", ")");
+
+    CloseElement("mrow");
+}
+
+void MathMLWriter::Serialize(const Integral<>& integral)
+{
+    OpenElement("mrow");
+    PushElement("mo", "\u222B");
+    PushOperand(integral.GetChild(0));
+
+    OpenElement("mrow");
+    PushElement("mo", "d");
+    PushOperand(integral.GetChild(1));
+    CloseElement("mrow");
+
+    CloseElement("mrow");
+}
+
+void MathMLWriter::Flush()
+{
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    buffer.clear();
+}
+
+void MathMLWriter::OpenElement(const std::string_view name)
+{
+    BeginLine();
+    buffer.push_back('<');
+    buffer.append(name);
+
+    elementJustOpened = true;
+    ++depth;
+}
+
+void MathMLWriter::CloseElement(const std::string_view name)
+{
+    --depth;
+
+    if (elementJustOpened) {
+        buffer.append(std::string_view { "/>" });
+        elementJustOpened = false;
+    } else {
+        buffer.push_back('\n');
+        Indent(depth);
+        buffer.append(std::string_view { "</" });
+        buffer.append(name);
+        buffer.push_back('>');
+    }
+
+    EndElement();
+}
+
+void MathMLWriter::PushElement(const std::string_view name, const std::string_view text)
+{
+    BeginLine();
+    fmt::format_to(fmt::appender(buffer), "<{0}>{1}</{0}>", name, text);
+    EndElement();
+}
+
+void MathMLWriter::PushOperand(const Expression* operand)
+{
+    if (operand != nullptr) {
+        operand->Serialize(*this);
+    } else {
+        PushPlaceholder();
+    }
+}
+
+void MathMLWriter::PushPlaceholder()
+{
+    OpenElement("mspace");
+    buffer.append(std::string_view { R"( style="border: dashed gray 1.5pt;" width="1em" height="1em")" });
+    CloseElement("mspace");
+}
+
+// Like tinyxml2::XMLPrinter, every element but the root starts on a line of its own, indented by
+// its depth. The root is the first element of its document, so nothing precedes it.
+void MathMLWriter::BeginLine()
+{
+    if (elementJustOpened) {
+        buffer.push_back('>');
+        elementJustOpened = false;
+    }
+
+    if (depth > 0) {
+        buffer.push_back('\n');
+        Indent(depth);
+    }
+}
+
+void MathMLWriter::EndElement()
+{
+    if (depth == 0) {
+        buffer.push_back('\n');
+        Flush();
+    } else if (buffer.size() >= buffer_size) {
+        Flush();
+    }
+}
+
+void MathMLWriter::Indent(const int level)
+{
+    for (int i = 0; i < level; ++i) {
+        buffer.append(std::string_view { "    " });
+    }
+}
+
+void MathMLWriter::PushEscaped(const std::string_view text)
+{
+    for (const char c : text) {
+        switch (c) {
+        case '&':
+            buffer.append(std::string_view { "&amp;" });
+            break;
+        case '<':
+            buffer.append(std::string_view { "&lt;" });
+            break;
+        case '>':
+            buffer.append(std::string_view { "&gt;" });
+            break;
+        default:
+            buffer.push_back(c);
+        }
+    }
+}
+
+// Appends the operands of a sum or product like BinaryExpression::Flatten, but without copying
+// or generalizing them, and without recursing, so that a long chain cannot exhaust the stack.
+auto MathMLWriter::PushOperands(const Expression& expression) -> std::size_t
+{
+    const std::size_t begin = operands.size();
+    const ExpressionType type = expression.GetType();
+
+    pending.clear();
+    pending.push_back(expression.GetChild(1));
+    pending.push_back(expression.GetChild(0));
+
+    while (!pending.empty()) {
+        const Expression* operand = pending.back();
+        pending.pop_back();
+
+        if (operand == nullptr) {
+            continue;
+        }
+
+        if (operand->GetType() == type) {
+            pending.push_back(operand->GetChild(1));
+            pending.push_back(operand->GetChild(0));
+        } else {
+            operands.push_back(operand);
+        }
+    }
+
+    return begin;
+}
+
+} // Oasis
@@ -0,0 +1,294 @@
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "Oasis/Add.hpp"
+#include "Oasis/BinarySerializer.hpp"
+#include "Oasis/Derivative.hpp"
+#include "Oasis/Divide.hpp"
+#include "Oasis/Exponent.hpp"
+#include "Oasis/Imaginary.hpp"
+#include "Oasis/Integral.hpp"
+#include "Oasis/Log.hpp"
+#include "Oasis/Matrix.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Negate.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Subtract.hpp"
+#include "Oasis/Undefined.hpp"
+#include "Oasis/Variable.hpp"
+
+namespace {
+
+// Serializes the expressions read from a document again, which must reproduce the document.
+auto Reencode(const std::vector<std::unique_ptr<Oasis::Expression>>& expressions) -> std::vector<std::uint8_t>
+{
+    Oasis::BinarySerializer serializer;
+
+    for (const auto& expression : expressions) {
+        expression->Serialize(serializer);
+    }
+
+    return serializer.GetResult();
+}
+
+} // namespace
+
+TEST_CASE("Binary Serialization Round-Trips Every Kind of Expression")
+{
+    const Oasis::Add expression {
+        Oasis::Subtract {
+            Oasis::Multiply { Oasis::Real { 2.0 }, Oasis::Variable { "x" } },
+            Oasis::Divide { Oasis::Imaginary {}, Oasis::Real { -3.0 } } },
+        Oasis::Add {
+            Oasis::Exponent { Oasis::Log { Oasis::Real { 10.0 }, Oasis::Variable { "y" } }, Oasis::Negate { Oasis::Variable { "x" } } },
+            Oasis::Add {
+                Oasis::Derivative { Oasis::Variable { "z" }, Oasis::Variable { "x" } },
+                Oasis::Integral { Oasis::Variable { "z" }, Oasis::Variable { "x" } } } }
+    };
+
+    Oasis::BinarySerializer serializer;
+    expression.Serialize(serializer);
+
+    // Undefined is never equal to anything, so it is compared by type.
+    Oasis::Undefined {}.Serialize(serializer);
+
+    const auto document = serializer.GetResult();
+    const auto expressions = Oasis::FromBinary(document);
+
+    REQUIRE(expressions.size() == 2);
+    REQUIRE(expressions[0]->Equals(expression));
+    REQUIRE(expressions[1]->Is<Oasis::Undefined>());
+    REQUIRE(Reencode(expressions) == document);
+}
+
+TEST_CASE("Binary Serialization Preserves Real Numbers Exactly")
+{
+    const std::vector<double> values { 0.1, 1e-300, -0.0, 123456.789012345, std::numeric_limits<double>::denorm_min(),
+        std::numeric_limits<double>::max(), -std::numeric_limits<double>::infinity() };
+
+    Oasis::BinarySerializer serializer;
+
+    for (const double value : values) {
+        Oasis::Real { value }.Serialize(serializer);
+    }
+
+    Oasis::Real { std::numeric_limits<double>::quiet_NaN() }.Serialize(serializer);
+
+    const auto document = serializer.GetResult();
+    const auto expressions = Oasis::FromBinary(document);
+
+    REQUIRE(expressions.size() == values.size() + 1);
+
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        REQUIRE(expressions[i]->Is<Oasis::Real>());
+
+        const double value = static_cast<const Oasis::Real&>(*expressions[i]).GetValue();
+        REQUIRE(value == values[i]);
+        REQUIRE(std::signbit(value) == std::signbit(values[i]));
+    }
+
+    REQUIRE(std::isnan(static_cast<const Oasis::Real&>(*expressions.back()).GetValue()));
+    REQUIRE(Reencode(expressions) == document);
+}
+
+TEST_CASE("Binary Serialization Writes Each Variable Name Once")
+{
+    const Oasis::Add once { Oasis::Variable { "velocity" }, Oasis::Real { 1.0 } };
+    const Oasis::Add thrice {
+        Oasis::Multiply { Oasis::Variable { "velocity" }, Oasis::Variable { "velocity" } },
+        Oasis::Variable { "velocity" }
+    };
+
+    Oasis::BinarySerializer serializer;
+    once.Serialize(serializer);
+    const auto onceSize = serializer.GetResult().size();
+
+    serializer.Clear();
+    thrice.Serialize(serializer);
+    const auto document = serializer.GetResult();
+
+    // Each further use of the name costs a tag and a one-byte index, not the name itself.
+    REQUIRE(document.size() < onceSize + 8);
+
+    const auto expressions = Oasis::FromBinary(document);
+    REQUIRE(expressions.size() == 1);
+    REQUIRE(expressions[0]->Equals(thrice));
+    REQUIRE(Reencode(expressions) == document);
+}
+
+TEST_CASE("Binary Serialization Writes Several Expressions to One Document")
+{
+    const Oasis::Add first { Oasis::Variable { "x" }, Oasis::Real { 1.0 } };
+    const Oasis::Negate second { Oasis::Variable { "y" } };
+    const Oasis::Variable third { "x" };
+
+    Oasis::BinarySerializer serializer;
+    first.Serialize(serializer);
+    second.Serialize(serializer);
+    third.Serialize(serializer);
+
+    const auto document = serializer.GetResult();
+    const auto expressions = Oasis::FromBinary(document);
+
+    REQUIRE(expressions.size() == 3);
+    REQUIRE(expressions[0]->Equals(first));
+    REQUIRE(expressions[1]->Equals(second));
+    REQUIRE(expressions[2]->Equals(third));
+    REQUIRE(Reencode(expressions) == document);
+
+    serializer.Clear();
+    REQUIRE(Oasis::FromBinary(serializer.GetResult()).empty());
+}
+
+TEST_CASE("Binary Serialization Round-Trips Matrices")
+{
+    Oasis::MatrixXXD values(2, 3);
+    values << 1.0, 0.1, -2.5, 1e-300, 4.0, 6.25;
+
+    const Oasis::Multiply expression { Oasis::Matrix { values }, Oasis::Matrix { Oasis::MatrixXXD(0, 0) } };
+
+    Oasis::BinarySerializer serializer;
+    expression.Serialize(serializer);
+
+    const auto document = serializer.GetResult();
+    const auto expressions = Oasis::FromBinary(document);
+
+    REQUIRE(expressions.size() == 1);
+    REQUIRE(expressions[0]->Equals(expression));
+    REQUIRE(Reencode(expressions) == document);
+}
+
+TEST_CASE("Binary Serialization Round-Trips Missing Operands")
+{
+    Oasis::Add<> expression;
+    expression.SetLeastSigOp(Oasis::Real { 1.0 });
+
+    Oasis::BinarySerializer serializer;
+    expression.Serialize(serializer);
+
+    const auto document = serializer.GetResult();
+    const auto expressions = Oasis::FromBinary(document);
+
+    REQUIRE(expressions.size() == 1);
+    REQUIRE(Reencode(expressions) == document);
+
+    const auto& add = static_cast<const Oasis::Add<>&>(*expressions[0]);
+    REQUIRE(!add.HasMostSigOp());
+    REQUIRE(add.GetLeastSigOp().Equals(Oasis::Real { 1.0 }));
+}
+
+TEST_CASE("Binary Parsing Rejects Malformed Documents")
+{
+    const Oasis::Add expression { Oasis::Variable { "x" }, Oasis::Real { 0.5 } };
+
+    Oasis::BinarySerializer serializer;
+    expression.Serialize(serializer);
+    const auto document = serializer.GetResult();
+
+    // The magic is followed by the version, the name table, and then the body.
+    constexpr std::size_t versionOffset = 4;
+    constexpr std::size_t bodyOffset = versionOffset + 1 + 1 + 1 + 1;
+
+    auto badMagic = document;
+    badMagic[0] = 'X';
+    REQUIRE_THROWS_AS(Oasis::FromBinary(badMagic), std::invalid_argument);
+
+    auto badVersion = document;
+    badVersion[versionOffset] = Oasis::BinarySerializer::version + 1;
+    REQUIRE_THROWS_AS(Oasis::FromBinary(badVersion), std::invalid_argument);
+
+    for (std::size_t size = 0; size < document.size(); ++size) {
+        const std::vector<std::uint8_t> truncated(document.begin(), document.begin() + static_cast<std::ptrdiff_t>(size));
+
+        // Cutting the document between expressions leaves a valid document.
+        if (size == bodyOffset) {
+            REQUIRE(Oasis::FromBinary(truncated).empty());
+            continue;
+        }
+
+        REQUIRE_THROWS_AS(Oasis::FromBinary(truncated), std::invalid_argument);
+    }
+
+    auto unknownTag = document;
+    unknownTag[bodyOffset] = 0xFF;
+    REQUIRE_THROWS_AS(Oasis::FromBinary(unknownTag), std::invalid_argument);
+
+    auto badName = document;
+    badName[bodyOffset + 2] = 1;
+    REQUIRE_THROWS_AS(Oasis::FromBinary(badName), std::invalid_argument);
+
+    std::vector<std::uint8_t> hugeMatrix(document.begin(), document.begin() + bodyOffset);
+    hugeMatrix.insert(hugeMatrix.end(), { 5, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F });
+    REQUIRE_THROWS_AS(Oasis::FromBinary(hugeMatrix), std::invalid_argument);
+
+    // An empty matrix with 2^63 rows or columns has no elements, but cannot be indexed.
+    const std::initializer_list<std::uint8_t> outOfRange { 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x01 };
+
+    std::vector<std::uint8_t> tallMatrix(document.begin(), document.begin() + bodyOffset);
+    tallMatrix.push_back(5);
+    tallMatrix.insert(tallMatrix.end(), outOfRange);
+    tallMatrix.push_back(0);
+    REQUIRE_THROWS_AS(Oasis::FromBinary(tallMatrix), std::invalid_argument);
+
+    std::vector<std::uint8_t> wideMatrix(document.begin(), document.begin() + bodyOffset);
+    wideMatrix.push_back(5);
+    wideMatrix.push_back(0);
+    wideMatrix.insert(wideMatrix.end(), outOfRange);
+    REQUIRE_THROWS_AS(Oasis::FromBinary(wideMatrix), std::invalid_argument);
+}
+
+TEST_CASE("Binary Parsing Rejects Deeply Nested Documents")
+{
+    const Oasis::Real leaf { 1.0 };
+
+    Oasis::BinarySerializer serializer;
+    leaf.Serialize(serializer);
+    const auto document = serializer.GetResult();
+
+    // The magic is followed by the version and an empty name table.
+    constexpr std::size_t bodyOffset = 4 + 1 + 1;
+    constexpr std::uint8_t negateTag = 12;
+
+    const auto nested = [&](const std::size_t depth) {
+        std::vector<std::uint8_t> chain(document.begin(), document.begin() + bodyOffset);
+        chain.insert(chain.end(), depth, negateTag);
+        chain.insert(chain.end(), document.begin() + bodyOffset, document.end());
+        return chain;
+    };
+
+    REQUIRE_THROWS_AS(Oasis::FromBinary(nested(1 << 20)), std::invalid_argument);
+
+    const auto shallow = nested(2000);
+    const auto expressions = Oasis::FromBinary(shallow);
+    REQUIRE(expressions.size() == 1);
+    REQUIRE(Reencode(expressions) == shallow);
+}
+
+TEST_CASE("Binary Parsing Works on Files")
+{
+    const Oasis::Exponent expression { Oasis::Variable { "x" }, Oasis::Real { 0.1 } };
+
+    Oasis::BinarySerializer serializer;
+    expression.Serialize(serializer);
+    const auto document = serializer.GetResult();
+
+    const auto path = std::filesystem::temp_directory_path() / "OasisBinaryTests.bin";
+    std::ofstream { path, std::ios::binary }.write(reinterpret_cast<const char*>(document.data()), static_cast<std::streamsize>(document.size()));
+
+    const auto expressions = Oasis::FromBinaryFile(path);
+    std::filesystem::remove(path);
+
+    REQUIRE(expressions.size() == 1);
+    REQUIRE(expressions[0]->Equals(expression));
+    REQUIRE(Reencode(expressions) == document);
+
+    REQUIRE_THROWS_AS(Oasis::FromBinaryFile(path), std::runtime_error);
+}
@@ -0,0 +1,36 @@
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "Oasis/Add.hpp"
+#include "Oasis/Exponent.hpp"
+#include "Oasis/FrozenFile.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Variable.hpp"
+
+TEST_CASE("Frozen Expressions Are Viewed from Files")
+{
+    const Oasis::Add expression { Oasis::Exponent { Oasis::Variable { "x" }, Oasis::Real { 2.0 } }, Oasis::Real { 0.1 } };
+    const auto frozen = Oasis::FrozenExpression::Freeze(expression);
+    const auto bytes = frozen.GetBytes();
+
+    const auto path = std::filesystem::temp_directory_path() / "OasisFrozenTests.bin";
+    std::ofstream { path, std::ios::binary }.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+
+    {
+        const auto viewed = Oasis::FromFrozenFile(path);
+
+        REQUIRE(viewed.Equals(frozen));
+        REQUIRE(viewed.Evaluate(std::array { 3.0 }) == 3.0 * 3.0 + 0.1);
+        REQUIRE(viewed.Thaw()->Equals(expression));
+    }
+
+    std::ofstream { path, std::ios::binary } << "not frozen";
+    REQUIRE_THROWS_AS(Oasis::FromFrozenFile(path), std::invalid_argument);
+
+    std::filesystem::remove(path);
+    REQUIRE_THROWS_AS(Oasis::FromFrozenFile(path), std::runtime_error);
+}
@@ -2,12 +2,25 @@
 // Created by Matthew McCall on 4/21/24.
 //
 
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
 #include "catch2/catch_test_macros.hpp"
 
 #include "Oasis/Add.hpp"
+#include "Oasis/Divide.hpp"
+#include "Oasis/Exponent.hpp"
+#include "Oasis/Imaginary.hpp"
+#include "Oasis/InFixSerializer.hpp"
 #include "Oasis/Log.hpp"
+#include "Oasis/Matrix.hpp"
 #include "Oasis/Multiply.hpp"
+#include "Oasis/Negate.hpp"
 #include "Oasis/FromString.hpp"
+#include "Oasis/Subtract.hpp"
 #include "Oasis/Variable.hpp"
 
 TEST_CASE("In-Fix Parsing Works for Simple Trees", "[Sexp]")
@@ -73,4 +86,236 @@ TEST_CASE("In-Fix Parsing Works with Variables")
 
     const auto& parsed = result.GetResult();
     REQUIRE(parsed.Equals(expected));
-}
\ No newline at end of file
+}
+
+TEST_CASE("In-Fix Parsing Does Not Need Whitespace", "[InFix]")
+{
+    const Oasis::Subtract expected {
+        Oasis::Multiply {
+            Oasis::Real { 2.0 },
+            Oasis::Exponent { Oasis::Variable { "x" }, Oasis::Real { 2.0 } } },
+        Oasis::Divide {
+            Oasis::Log { Oasis::Real { 2.0 }, Oasis::Variable { "y" } },
+            Oasis::Real { 0.25 } }
+    };
+
+    const auto result = Oasis::FromInFix("2x^2-log(2,y)/0.25");
+    REQUIRE(result.Ok());
+    REQUIRE(result.GetResult().Equals(expected));
+}
+
+TEST_CASE("In-Fix Parsing Handles Exponents and Negation", "[InFix]")
+{
+    // ^ is right-associative and binds tighter than unary minus.
+    const Oasis::Negate expected {
+        Oasis::Exponent {
+            Oasis::Variable { "x" },
+            Oasis::Exponent { Oasis::Real { 2.0 }, Oasis::Real { -1.0 } } }
+    };
+
+    const auto result = Oasis::FromInFix("-x^2^-1");
+    REQUIRE(result.Ok());
+    REQUIRE(result.GetResult().Equals(expected));
+
+    const auto literal = Oasis::FromInFix("-3");
+    REQUIRE(literal.Ok());
+    REQUIRE(literal.GetResult().Equals(Oasis::Real { -3.0 }));
+}
+
+TEST_CASE("In-Fix Parsing Works with Juxtaposition and Subscripts", "[InFix]")
+{
+    const Oasis::Multiply expected {
+        Oasis::Multiply {
+            Oasis::Multiply { Oasis::Real { 3.0 }, Oasis::Variable { "x_1" } },
+            Oasis::Variable { "y_{12}" } },
+        Oasis::Add { Oasis::Variable { "z" }, Oasis::Imaginary {} }
+    };
+
+    const auto result = Oasis::FromInFix("3x_1 y_{12}(z + i)");
+    REQUIRE(result.Ok());
+    REQUIRE(result.GetResult().Equals(expected));
+}
+
+TEST_CASE("In-Fix Parsing Binds Juxtaposition Between Products and Powers", "[InFix]")
+{
+    // Tighter than "/"
+    const auto quotient = Oasis::FromInFix("1/2x");
+    REQUIRE(quotient.Ok());
+    REQUIRE(quotient.GetResult().Identical(Oasis::Divide {
+        Oasis::Real { 1.0 },
+        Oasis::Multiply { Oasis::Real { 2.0 }, Oasis::Variable { "x" } } }));
+
+    // Looser than "^"
+    const auto power = Oasis::FromInFix("x^2y");
+    REQUIRE(power.Ok());
+    REQUIRE(power.GetResult().Identical(Oasis::Multiply {
+        Oasis::Exponent { Oasis::Variable { "x" }, Oasis::Real { 2.0 } },
+        Oasis::Variable { "y" } }));
+
+    const auto negative = Oasis::FromInFix("-2x");
+    REQUIRE(negative.Ok());
+    REQUIRE(negative.GetResult().Identical(Oasis::Multiply { Oasis::Real { -2.0 }, Oasis::Variable { "x" } }));
+}
+
+TEST_CASE("In-Fix Parsing Reports Error Offsets", "[InFix]")
+{
+    const std::pair<std::string, std::size_t> cases[] {
+        { "1 + * 2", 4 }, { "(1 + 2", 6 }, { "log(1)", 5 }, { "1 + 2)", 5 }, { "2 % 3", 2 }, { "", 0 }, { "x_", 1 }
+    };
+
+    for (const auto& [input, offset] : cases) {
+        const auto result = Oasis::FromInFix(input);
+        REQUIRE_FALSE(result.Ok());
+        REQUIRE(result.GetErrorOffset() == offset);
+    }
+
+    const auto result = Oasis::FromInFix("1 + * 2");
+    REQUIRE(result.GetErrorMessage() == R"(Unexpected "*")");
+
+    const std::string nested(100000, '(');
+    REQUIRE(Oasis::FromInFix(nested).GetErrorMessage() == "Expression is nested too deeply");
+
+    std::string chain = "x";
+
+    for (int i = 0; i < 100000; ++i) {
+        chain += "+x";
+    }
+
+    REQUIRE(Oasis::FromInFix(chain).GetErrorMessage() == "Expression is nested too deeply");
+    REQUIRE(Oasis::FromInFix(chain.substr(0, 2001)).Ok());
+}
+
+TEST_CASE("In-Fix Parsing Works Line by Line", "[InFix]")
+{
+    std::string text;
+
+    for (int i = 0; i < 1000; ++i) {
+        text += i % 100 == 7 ? "1 + * 2\n" : std::to_string(i) + "x + 1\n";
+    }
+
+    const auto results = Oasis::FromInFixLines(text);
+    REQUIRE(results.size() == 1000);
+
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        if (i % 100 == 7) {
+            REQUIRE_FALSE(results[i].Ok());
+            REQUIRE(results[i].GetErrorOffset() == 4);
+        } else {
+            REQUIRE(results[i].Ok());
+            REQUIRE(results[i].GetResult().Equals(Oasis::FromInFix(std::to_string(i) + "x + 1").GetResult()));
+        }
+    }
+
+    REQUIRE(Oasis::FromInFixLines("").empty());
+    REQUIRE(Oasis::FromInFixLines("x\n\ny").size() == 3);
+}
+
+TEST_CASE("In-Fix Parsing Works on Files", "[InFix]")
+{
+    const auto path = std::filesystem::temp_directory_path() / "OasisInFixTests.txt";
+    std::ofstream { path } << "1 + 2\r\nlog(2, x)\n(";
+
+    const auto results = Oasis::FromInFixFile(path);
+    std::filesystem::remove(path);
+
+    REQUIRE(results.size() == 3);
+    REQUIRE(results[0].GetResult().Equals(Oasis::Add { Oasis::Real { 1.0 }, Oasis::Real { 2.0 } }));
+    REQUIRE(results[1].GetResult().Equals(Oasis::Log { Oasis::Real { 2.0 }, Oasis::Variable { "x" } }));
+    REQUIRE(results[2].GetErrorOffset() == 1);
+
+    REQUIRE_THROWS_AS(Oasis::FromInFixFile(path), std::runtime_error);
+}
+
+TEST_CASE("In-Fix Serialization Parenthesizes Every Operation", "[InFix]")
+{
+    const Oasis::Add expression {
+        Oasis::Multiply { Oasis::Real { 2.0 }, Oasis::Variable { "x" } },
+        Oasis::Negate { Oasis::Log { Oasis::Real { 2.0 }, Oasis::Variable { "y" } } }
+    };
+
+    Oasis::InFixSerializer serializer;
+    expression.Serialize(serializer);
+    REQUIRE(serializer.getResult() == "((2*x)+-(log(2,y)))");
+
+    const Oasis::Matrix matrix { Oasis::MatrixXXD { { 1.0, 2.0 }, { 3.0, 4.5 } } };
+    serializer.Clear();
+    matrix.Serialize(serializer);
+    REQUIRE(serializer.GetView() == "[[1,2],[3,4.5]]");
+}
+
+TEST_CASE("In-Fix Serialization Appends to a Buffer", "[InFix]")
+{
+    fmt::memory_buffer buffer;
+    Oasis::InFixSerializer serializer { buffer };
+
+    Oasis::Variable { "x" }.Serialize(serializer);
+    buffer.push_back(';');
+    Oasis::Add { Oasis::Real { 1.0 }, Oasis::Real { 2.0 } }.Serialize(serializer);
+
+    REQUIRE(fmt::to_string(buffer) == "x;(1+2)");
+    REQUIRE(serializer.getResult() == "(1+2)");
+}
+
+TEST_CASE("In-Fix Serialization Replaces the Previous Result", "[InFix]")
+{
+    Oasis::InFixSerializer serializer;
+
+    Oasis::Variable { "x" }.Serialize(serializer);
+    REQUIRE(serializer.getResult() == "x");
+
+    Oasis::Add { Oasis::Real { 1.0 }, Oasis::Real { 2.0 } }.Serialize(serializer);
+    REQUIRE(serializer.getResult() == "(1+2)");
+}
+
+TEST_CASE("In-Fix Serialization Emits Minimal Parentheses", "[InFix]")
+{
+    const std::pair<std::string, std::string> cases[] {
+        { "2*x + 1", "2*x+1" },
+        { "(a - b) - c", "a-b-c" },
+        { "a - (b - c)", "a-(b-c)" },
+        { "a / (b * c)", "a/(b*c)" },
+        { "x^y^z", "x^y^z" },
+        { "(x^y)^z", "(x^y)^z" },
+        { "-(a + b)", "-(a+b)" },
+        { "(-x)^2", "(-x)^2" },
+        { "-x^2", "-x^2" },
+        { "x^(-y)", "x^(-y)" },
+        { "(1 + x) * log(2, (y + 1) / 2)", "(1+x)*log(2,(y+1)/2)" },
+        { "-(3)", "-(3)" },
+        { "-3", "-3" },
+        { "x^-0.5", "x^(-0.5)" },
+        { "123456.789x", "123456.789*x" },
+    };
+
+    for (const auto& [input, expected] : cases) {
+        const auto parsed = Oasis::FromInFix(input);
+        REQUIRE(parsed.Ok());
+
+        Oasis::InFixSerializer serializer { Oasis::InFixSerializer::Parentheses::Minimal };
+        parsed.GetResult().Serialize(serializer);
+        REQUIRE(serializer.GetView() == expected);
+
+        // The output parses back to the same tree, which serializes to the same output.
+        const auto reparsed = Oasis::FromInFix(serializer.GetView());
+        REQUIRE(reparsed.Ok());
+
+        Oasis::InFixSerializer reserializer { Oasis::InFixSerializer::Parentheses::Minimal };
+        reparsed.GetResult().Serialize(reserializer);
+        REQUIRE(reserializer.GetView() == expected);
+    }
+}
+
+TEST_CASE("In-Fix Serialization Round-Trips Numbers", "[InFix]")
+{
+    const Oasis::Negate negation { Oasis::Real { 3.0 } };
+    const Oasis::Multiply product { Oasis::Real { 0.1 + 0.2 }, Oasis::Real { 1e-7 } };
+
+    for (const Oasis::Expression* expression : { static_cast<const Oasis::Expression*>(&negation), static_cast<const Oasis::Expression*>(&product) }) {
+        Oasis::InFixSerializer serializer { Oasis::InFixSerializer::Parentheses::Minimal };
+        expression->Serialize(serializer);
+
+        const auto reparsed = Oasis::FromInFix(serializer.GetView());
+        REQUIRE(reparsed.Ok());
+        REQUIRE(reparsed.GetResult().Identical(*expression));
+    }
+}
@@ -0,0 +1,153 @@
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "Oasis/Add.hpp"
+#include "Oasis/Derivative.hpp"
+#include "Oasis/Divide.hpp"
+#include "Oasis/Exponent.hpp"
+#include "Oasis/Imaginary.hpp"
+#include "Oasis/Integral.hpp"
+#include "Oasis/Log.hpp"
+#include "Oasis/MathMLSerializer.hpp"
+#include "Oasis/MathMLWriter.hpp"
+#include "Oasis/Matrix.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Negate.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Subtract.hpp"
+#include "Oasis/Undefined.hpp"
+#include "Oasis/Variable.hpp"
+
+namespace {
+
+auto ToMathMLWithDocument(const Oasis::Expression& expression) -> std::string
+{
+    tinyxml2::XMLDocument doc;
+    Oasis::MathMLSerializer serializer(doc);
+
+    expression.Serialize(serializer);
+    doc.InsertEndChild(serializer.GetResult());
+
+    tinyxml2::XMLPrinter printer;
+    doc.Print(&printer);
+
+    return printer.CStr();
+}
+
+auto ToMathMLWithWriter(const Oasis::Expression& expression) -> std::string
+{
+    std::ostringstream out;
+    Oasis::MathMLWriter writer(out);
+
+    expression.Serialize(writer);
+
+    return out.str();
+}
+
+}
+
+TEST_CASE("MathML Writer Matches the Document Serializer", "[MathML]")
+{
+    const Oasis::Add expression {
+        Oasis::Subtract {
+            Oasis::Multiply { Oasis::Multiply { Oasis::Real { 2.0 }, Oasis::Real { 0.125 } }, Oasis::Add { Oasis::Variable { "x" }, Oasis::Imaginary {} } },
+            Oasis::Divide { Oasis::Variable { "y" }, Oasis::Real { -3.0 } } },
+        Oasis::Add {
+            Oasis::Exponent { Oasis::Log { Oasis::Real { 10.0 }, Oasis::Variable { "y" } }, Oasis::Negate { Oasis::Variable { "x" } } },
+            Oasis::Subtract {
+                Oasis::Derivative { Oasis::Exponent { Oasis::Variable { "z" }, Oasis::Real { 2.0 } }, Oasis::Variable { "z" } },
+                Oasis::Integral { Oasis::Variable { "z" }, Oasis::Variable { "z" } } } }
+    };
+
+    REQUIRE(ToMathMLWithWriter(expression) == ToMathMLWithDocument(expression));
+
+    const Oasis::Subtract positive { Oasis::Variable { "x" }, Oasis::Real { 1.0 } };
+    REQUIRE(ToMathMLWithWriter(positive) == ToMathMLWithDocument(positive));
+
+    const Oasis::Variable leaf { "x" };
+    REQUIRE(ToMathMLWithWriter(leaf) == "<mi>x</mi>\n");
+    REQUIRE(ToMathMLWithWriter(leaf) == ToMathMLWithDocument(leaf));
+
+    const Oasis::Undefined undefined;
+    REQUIRE(ToMathMLWithWriter(undefined) == ToMathMLWithDocument(undefined));
+}
+
+TEST_CASE("MathML Writer Matches the Document Serializer for Matrices", "[Matrix][MathML]")
+{
+    Oasis::MatrixXXD values(2, 3);
+    values << 1.0, 0.1, -2.5, 1e-300, 4.0, 6.25;
+
+    const Oasis::Matrix matrix { values };
+    REQUIRE(ToMathMLWithWriter(matrix) == ToMathMLWithDocument(matrix));
+
+    const Oasis::Matrix empty { Oasis::MatrixXXD(0, 0) };
+    REQUIRE(ToMathMLWithWriter(empty) == ToMathMLWithDocument(empty));
+}
+
+TEST_CASE("MathML Writer Writes Placeholders for Missing Operands", "[MathML]")
+{
+    Oasis::Divide<> divide;
+    divide.SetMostSigOp(Oasis::Variable { "x" });
+
+    Oasis::Exponent<> exponent;
+    exponent.SetLeastSigOp(Oasis::Real { 2.0 });
+
+    REQUIRE(ToMathMLWithWriter(divide) == ToMathMLWithDocument(divide));
+    REQUIRE(ToMathMLWithWriter(exponent) == ToMathMLWithDocument(exponent));
+}
+
+TEST_CASE("MathML Writer Escapes Text", "[MathML]")
+{
+    const Oasis::Variable variable { "a<b&c>d" };
+
+    REQUIRE(ToMathMLWithWriter(variable) == "<mi>a&lt;b&amp;c&gt;d</mi>\n");
+    REQUIRE(ToMathMLWithWriter(variable) == ToMathMLWithDocument(variable));
+}
+
+TEST_CASE("MathML Writer Writes Each Expression as a Document", "[MathML]")
+{
+    const Oasis::Add first { Oasis::Variable { "x" }, Oasis::Real { 1.0 } };
+    const Oasis::Negate second { Oasis::Variable { "y" } };
+
+    std::ostringstream out;
+    Oasis::MathMLWriter writer(out);
+
+    first.Serialize(writer);
+    REQUIRE(out.str() == ToMathMLWithDocument(first));
+
+    second.Serialize(writer);
+    REQUIRE(out.str() == ToMathMLWithDocument(first) + ToMathMLWithDocument(second));
+}
+
+TEST_CASE("MathML Writer Streams Large Outputs", "[MathML]")
+{
+    Oasis::MatrixXXD values(60, 60);
+
+    for (Eigen::Index i = 0; i < values.size(); ++i) {
+        values.data()[i] = static_cast<double>(i) / 7.0;
+    }
+
+    const Oasis::Matrix matrix { values };
+    const std::string expected = ToMathMLWithDocument(matrix);
+
+    REQUIRE(expected.size() > 2 * Oasis::MathMLWriter::buffer_size);
+    REQUIRE(ToMathMLWithWriter(matrix) == expected);
+
+    // A long sum is flattened without recursing once per term.
+    std::unique_ptr<Oasis::Expression> sum = std::make_unique<Oasis::Variable>("x0");
+
+    for (int i = 1; i < 5000; ++i) {
+        sum = std::make_unique<Oasis::Add<>>(*sum, Oasis::Variable { "x" + std::to_string(i) });
+    }
+
+    std::ostringstream out;
+    Oasis::MathMLWriter writer(out);
+    sum->Serialize(writer);
+
+    const std::string mathml = out.str();
+    REQUIRE(mathml.starts_with("<mrow>\n    <mi>x0</mi>\n    <mo>+</mo>\n    <mi>x1</mi>\n"));
+    REQUIRE(mathml.ends_with("    <mi>x4999</mi>\n</mrow>\n"));
+}
@@ -20,9 +20,6 @@ class Add<
 public:
     using BinaryExpression::BinaryExpression;
 
-    [[nodiscard]] auto Simplify() const -> std::unique_ptr<Expression> final;
-    auto Simplify(tf::Subflow& subflow) const -> std::unique_ptr<Expression> final;
-
     [[nodiscard]] auto Integrate(const Expression& integrationVariable) -> std::unique_ptr<Expression> final;
     [[nodiscard]] auto Differentiate(const Expression& differentiationVariable) const -> std::unique_ptr<Expression> final;
 
@@ -30,6 +27,9 @@ public:
 
     EXPRESSION_TYPE(Add)
     EXPRESSION_CATEGORY(Associative | Commutative | BinExp)
+
+protected:
+    [[nodiscard]] auto SimplifyImpl() const -> std::unique_ptr<Expression> final;
 };
 /// @endcond
 
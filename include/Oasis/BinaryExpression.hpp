@@ -5,12 +5,17 @@
 #ifndef OASIS_BINARYEXPRESSION_HPP
 #define OASIS_BINARYEXPRESSION_HPP
 
+#include <algorithm>
 #include <functional>
-#include <list>
+#include <iterator>
+#include <type_traits>
+#include <unordered_set>
 
 #include "taskflow/taskflow.hpp"
 
 #include "Expression.hpp"
+#include "ExpressionStore.hpp"
+#include "Runtime.hpp"
 #include "Serialization.hpp"
 
 namespace Oasis {
@@ -27,14 +32,18 @@ template <template <typename, typename> typename T>
 concept IAssociativeAndCommutative = IExpression<T<Expression, Expression>> && ((T<Expression, Expression>::GetStaticCategory() & (Associative | Commutative)) == (Associative | Commutative));
 
 /**
- * Builds a reasonably balanced binary expression from a vector of operands.
+ * Builds a reasonably balanced binary expression from a vector of shared operands.
+ *
+ * Adjacent operands are paired level by level, with an odd operand carried over to the next level.
+ * The operands are shared with the result rather than copied.
+ *
  * @tparam T The type of the binary expression, e.g. Add or Multiply.
  * @param ops The vector of operands. Must have a minimum of 2 operands.
  * @return A binary expression with the operands in the vector, or a nullptr if ops.size() <=1.
  */
 template <template <typename, typename> typename T>
     requires IAssociativeAndCommutative<T>
-auto BuildFromVector(const std::vector<std::unique_ptr<Expression>>& ops) -> std::unique_ptr<T<Expression, Expression>>
+auto BuildFromOperands(std::vector<std::shared_ptr<const Expression>> ops) -> std::unique_ptr<T<Expression, Expression>>
 {
     if (ops.size() <= 1) {
         return nullptr;
@@ -42,21 +51,47 @@ auto BuildFromVector(const std::vector<std::unique_ptr<Expression>>& ops) -> std
 
     using GeneralizedT = T<Expression, Expression>;
 
-    std::list<std::unique_ptr<Expression>> opsList;
-    opsList.resize(ops.size());
+    while (ops.size() > 2) {
+        std::vector<std::shared_ptr<const Expression>> next;
+        next.reserve((ops.size() + 1) / 2);
 
-    std::transform(ops.begin(), ops.end(), opsList.begin(), [](const auto& op) { return op->Copy(); });
+        for (std::size_t i = 0; i + 1 < ops.size(); i += 2) {
+            auto node = std::make_shared<GeneralizedT>();
+            node->mostSigOp = std::move(ops[i]);
+            node->leastSigOp = std::move(ops[i + 1]);
+            next.push_back(std::move(node));
+        }
 
-    while (std::next(opsList.begin()) != opsList.end()) {
-        for (auto i = opsList.begin(); i != opsList.end() && std::next(i) != opsList.end();) {
-            auto node = std::make_unique<GeneralizedT>(**i, **std::next(i));
-            opsList.insert(i, std::move(node));
-            i = opsList.erase(i, std::next(i, 2));
+        if (ops.size() % 2 != 0) {
+            next.push_back(std::move(ops.back()));
         }
+
+        ops = std::move(next);
     }
 
-    auto* result = dynamic_cast<GeneralizedT*>(opsList.front().release());
-    return std::unique_ptr<GeneralizedT>(result);
+    auto result = std::make_unique<GeneralizedT>();
+    result->mostSigOp = std::move(ops[0]);
+    result->leastSigOp = std::move(ops[1]);
+
+    return result;
+}
+
+/**
+ * Builds a reasonably balanced binary expression from a vector of operands.
+ * @tparam T The type of the binary expression, e.g. Add or Multiply.
+ * @param ops The vector of operands. Must have a minimum of 2 operands.
+ * @return A binary expression with the operands in the vector, or a nullptr if ops.size() <=1.
+ */
+template <template <typename, typename> typename T>
+    requires IAssociativeAndCommutative<T>
+auto BuildFromVector(const std::vector<std::unique_ptr<Expression>>& ops) -> std::unique_ptr<T<Expression, Expression>>
+{
+    std::vector<std::shared_ptr<const Expression>> operands;
+    operands.reserve(ops.size());
+
+    std::transform(ops.begin(), ops.end(), std::back_inserter(operands), [](const auto& op) { return std::shared_ptr<const Expression> { op->Copy() }; });
+
+    return BuildFromOperands<T>(std::move(operands));
 }
 
 /**
@@ -83,14 +118,10 @@ class BinaryExpression : public Expression {
 public:
     BinaryExpression() = default;
     BinaryExpression(const BinaryExpression& other)
+        : Expression(other)
+        , mostSigOp(other.mostSigOp)
+        , leastSigOp(other.leastSigOp)
     {
-        if (other.HasMostSigOp()) {
-            SetMostSigOp(other.GetMostSigOp());
-        }
-
-        if (other.HasLeastSigOp()) {
-            SetLeastSigOp(other.GetLeastSigOp());
-        }
     }
 
     BinaryExpression(const MostSigOpT& mostSigOp, const LeastSigOpT& leastSigOp)
@@ -115,8 +146,8 @@ public:
         // build expression from vector
         auto generalized = BuildFromVector<DerivedT>(opsVec);
 
-        SetLeastSigOp(generalized->GetLeastSigOp());
-        SetMostSigOp(generalized->GetMostSigOp());
+        this->mostSigOp = generalized->mostSigOp;
+        this->leastSigOp = generalized->leastSigOp;
     }
 
     [[nodiscard]] auto Copy() const -> std::unique_ptr<Expression> final
@@ -124,25 +155,10 @@ public:
         return std::make_unique<DerivedSpecialized>(*static_cast<const DerivedSpecialized*>(this));
     }
 
-    auto Copy(tf::Subflow& subflow) const -> std::unique_ptr<Expression> final
+    auto Copy(tf::Subflow&) const -> std::unique_ptr<Expression> final
     {
-        DerivedSpecialized copy;
-
-        if (this->mostSigOp) {
-            subflow.emplace([this, &copy](tf::Subflow& sbf) {
-                copy.SetMostSigOp(mostSigOp->Copy(sbf), sbf);
-            });
-        }
-
-        if (this->leastSigOp) {
-            subflow.emplace([this, &copy](tf::Subflow& sbf) {
-                copy.SetLeastSigOp(leastSigOp->Copy(sbf), sbf);
-            });
-        }
-
-        subflow.join();
-
-        return std::make_unique<DerivedSpecialized>(copy);
+        // Operands are shared and immutable, so there is nothing worth spawning tasks for.
+        return Copy();
     }
     [[nodiscard]] auto Differentiate(const Expression& differentiationVariable) const -> std::unique_ptr<Expression> override
     {
@@ -150,7 +166,7 @@ public:
     }
     [[nodiscard]] auto Equals(const Expression& other) const -> bool final
     {
-        if (this->GetType() != other.GetType()) {
+        if (this->GetType() != other.GetType() || this->Hash() != other.Hash()) {
             return false;
         }
 
@@ -183,63 +199,48 @@ public:
             return false;
         }
 
-        auto thisFlattened = std::vector<std::unique_ptr<Expression>> {};
-        auto otherFlattened = std::vector<std::unique_ptr<Expression>> {};
+        auto thisFlattened = std::vector<std::shared_ptr<const Expression>> {};
+        auto otherFlattened = std::vector<std::shared_ptr<const Expression>> {};
 
         this->Flatten(thisFlattened);
         otherBinaryGeneralized.Flatten(otherFlattened);
 
-        for (const auto& thisOperand : thisFlattened) {
-            if (std::find_if(otherFlattened.begin(), otherFlattened.end(), [&thisOperand](const auto& otherOperand) {
-                    return thisOperand->Equals(*otherOperand);
-                })
-                == otherFlattened.end()) {
-                return false;
-            }
+        if (thisFlattened.size() != otherFlattened.size()) {
+            return false;
         }
 
-        return true;
-    }
-
-    [[nodiscard]] auto Generalize() const -> std::unique_ptr<Expression> final
-    {
-        DerivedGeneralized generalized;
+        std::unordered_multiset<const Expression*, ExpressionHash, ExpressionEqual> otherOperands;
 
-        if (this->mostSigOp) {
-            generalized.SetMostSigOp(*this->mostSigOp->Copy());
+        for (const auto& otherOperand : otherFlattened) {
+            otherOperands.insert(otherOperand.get());
         }
 
-        if (this->leastSigOp) {
-            generalized.SetLeastSigOp(*this->leastSigOp->Copy());
-        }
+        // Each operand of the other expression may only be matched once, so that repeated operands
+        // must appear equally often on both sides.
+        return std::all_of(thisFlattened.begin(), thisFlattened.end(), [&otherOperands](const auto& thisOperand) {
+            const auto match = otherOperands.find(thisOperand.get());
+
+            if (match == otherOperands.end()) {
+                return false;
+            }
 
-        return std::make_unique<DerivedGeneralized>(generalized);
+            otherOperands.erase(match);
+            return true;
+        });
     }
 
-    auto Generalize(tf::Subflow& subflow) const -> std::unique_ptr<Expression> final
+    [[nodiscard]] auto Generalize() const -> std::unique_ptr<Expression> final
     {
-        DerivedGeneralized generalized;
-
-        if (this->mostSigOp) {
-            subflow.emplace([this, &generalized](tf::Subflow& sbf) {
-                generalized.SetMostSigOp(*this->mostSigOp->Copy(sbf));
-            });
-        }
+        auto generalized = std::make_unique<DerivedGeneralized>();
+        generalized->mostSigOp = this->mostSigOp;
+        generalized->leastSigOp = this->leastSigOp;
 
-        if (this->leastSigOp) {
-            subflow.emplace([this, &generalized](tf::Subflow& sbf) {
-                generalized.SetLeastSigOp(*this->leastSigOp->Copy(sbf));
-            });
-        }
-
-        subflow.join();
-
-        return std::make_unique<DerivedGeneralized>(generalized);
+        return generalized;
     }
 
-    [[nodiscard]] auto Simplify() const -> std::unique_ptr<Expression> override
+    auto Generalize(tf::Subflow&) const -> std::unique_ptr<Expression> final
     {
-        return Generalize()->Simplify();
+        return Generalize();
     }
 
     [[nodiscard]] auto Integrate(const Expression& integrationVariable) -> std::unique_ptr<Expression> override
@@ -247,22 +248,22 @@ public:
         return Generalize()->Integrate(integrationVariable);
     }
 
-    auto Simplify(tf::Subflow& subflow) const -> std::unique_ptr<Expression> override
+    auto Intern(ExpressionStore& store) const -> std::shared_ptr<const Expression> final
     {
-        std::unique_ptr<Expression> generalized, simplified;
+        std::shared_ptr<const Expression> internedMostSigOp = mostSigOp ? mostSigOp->Intern(store) : nullptr;
+        std::shared_ptr<const Expression> internedLeastSigOp = leastSigOp ? leastSigOp->Intern(store) : nullptr;
 
-        tf::Task generalizeTask = subflow.emplace([this, &generalized](tf::Subflow& sbf) {
-            generalized = Generalize(sbf);
-        });
+        const ExpressionStore::Key key { .type = this->GetType(), .mostSigOp = internedMostSigOp.get(), .leastSigOp = internedLeastSigOp.get() };
 
-        tf::Task simplifyTask = subflow.emplace([&generalized, &simplified](tf::Subflow& sbf) {
-            simplified = generalized->Simplify(sbf);
-        });
+        if (auto existing = store.Find(key); existing != nullptr) {
+            return existing;
+        }
 
-        simplifyTask.succeed(generalizeTask);
-        subflow.join();
+        auto node = std::make_shared<DerivedGeneralized>();
+        node->mostSigOp = std::move(internedMostSigOp);
+        node->leastSigOp = std::move(internedLeastSigOp);
 
-        return simplified;
+        return store.Insert(key, std::move(node));
     }
 
     [[nodiscard]] auto StructurallyEquivalent(const Expression& other) const -> bool final
@@ -299,6 +300,10 @@ public:
             return false;
         }
 
+        if (this->NodeCount() < Runtime::GetSequentialCutoff()) {
+            return StructurallyEquivalent(other);
+        }
+
         std::unique_ptr<Expression> otherGeneralized;
 
         tf::Task generalizeTask = subflow.emplace([&](tf::Subflow& sbf) {
@@ -366,6 +371,46 @@ public:
         }
     }
 
+    /**
+     * Flattens this expression without copying its operands.
+     *
+     * This behaves like the overload taking a vector of `std::unique_ptr`, except that the operands
+     * are shared with this expression rather than copied.
+     * @param out The vector to append the operands to.
+     */
+    auto Flatten(std::vector<std::shared_ptr<const Expression>>& out) const -> void
+    {
+        if (mostSigOp) {
+            if (this->mostSigOp->template Is<DerivedT>()) {
+                auto generalizedMostSigOp = this->mostSigOp->Generalize();
+                static_cast<const DerivedGeneralized&>(*generalizedMostSigOp).Flatten(out);
+            } else {
+                out.push_back(this->mostSigOp);
+            }
+        }
+
+        if (leastSigOp) {
+            if (this->leastSigOp->template Is<DerivedT>()) {
+                auto generalizedLeastSigOp = this->leastSigOp->Generalize();
+                static_cast<const DerivedGeneralized&>(*generalizedLeastSigOp).Flatten(out);
+            } else {
+                out.push_back(this->leastSigOp);
+            }
+        }
+    }
+
+    [[nodiscard]] auto GetChild(std::size_t index) const -> const Expression* final
+    {
+        switch (index) {
+        case 0:
+            return mostSigOp.get();
+        case 1:
+            return leastSigOp.get();
+        default:
+            return nullptr;
+        }
+    }
+
     /**
      * Gets the most significant operand of this expression.
      * @return The most significant operand of this expression.
@@ -410,10 +455,12 @@ public:
      */
     auto SetMostSigOp(const MostSigOpT& op) -> void
     {
+        this->Invalidate();
+
         if constexpr (std::same_as<MostSigOpT, Expression>) {
             this->mostSigOp = op.Copy();
         } else {
-            this->mostSigOp = std::make_unique<MostSigOpT>(op);
+            this->mostSigOp = std::make_shared<MostSigOpT>(op);
         }
     }
 
@@ -423,10 +470,12 @@ public:
      */
     auto SetLeastSigOp(const LeastSigOpT& op) -> void
     {
+        this->Invalidate();
+
         if constexpr (std::same_as<LeastSigOpT, Expression>) {
             this->leastSigOp = op.Copy();
         } else {
-            this->leastSigOp = std::make_unique<LeastSigOpT>(op);
+            this->leastSigOp = std::make_shared<LeastSigOpT>(op);
         }
     }
 
@@ -434,7 +483,11 @@ public:
         requires IsAnyOf<T, MostSigOpT, Expression>
     auto SetMostSigOp(std::unique_ptr<T>&& op) -> void
     {
-        if constexpr (std::same_as<T, Expression>) {
+        this->Invalidate();
+
+        if constexpr (std::same_as<MostSigOpT, Expression>) {
+            this->mostSigOp = std::move(op);
+        } else if constexpr (std::same_as<T, Expression>) {
             auto specializedOp = MostSigOpT::Specialize(*op);
             assert(specializedOp);
             this->mostSigOp = std::move(specializedOp);
@@ -447,7 +500,11 @@ public:
         requires IsAnyOf<T, LeastSigOpT, Expression>
     auto SetLeastSigOp(std::unique_ptr<T>&& op) -> void
     {
-        if constexpr (std::same_as<T, Expression>) {
+        this->Invalidate();
+
+        if constexpr (std::same_as<LeastSigOpT, Expression>) {
+            this->leastSigOp = std::move(op);
+        } else if constexpr (std::same_as<T, Expression>) {
             auto specializedOp = LeastSigOpT::Specialize(*op);
             assert(specializedOp);
             this->leastSigOp = std::move(specializedOp);
@@ -460,6 +517,8 @@ public:
         requires IsAnyOf<T, MostSigOpT, Expression>
     auto SetMostSigOp(std::unique_ptr<T>&& op, tf::Subflow& subflow) -> void
     {
+        this->Invalidate();
+
         if constexpr (std::same_as<T, Expression>) {
             auto specializedOp = MostSigOpT::Specialize(*op, subflow);
             assert(specializedOp);
@@ -473,6 +532,8 @@ public:
         requires IsAnyOf<T, LeastSigOpT, Expression>
     auto SetLeastSigOp(std::unique_ptr<T>&& op, tf::Subflow& subflow) -> void
     {
+        this->Invalidate();
+
         if constexpr (std::same_as<T, Expression>) {
             auto specializedOp = LeastSigOpT::Specialize(*op, subflow);
             assert(specializedOp);
@@ -495,20 +556,100 @@ public:
      */
     auto SwapOperands() const -> DerivedT<LeastSigOpT, MostSigOpT>
     {
-        return DerivedT { *this->leastSigOp, *this->mostSigOp };
+        DerivedT<LeastSigOpT, MostSigOpT> swapped;
+        swapped.mostSigOp = this->leastSigOp;
+        swapped.leastSigOp = this->mostSigOp;
+
+        return swapped;
     }
 
     auto operator=(const BinaryExpression& other) -> BinaryExpression& = default;
 
     void Serialize(SerializationVisitor& visitor) const override
     {
-        const auto generalized = Generalize();
-        const auto& derivedGeneralized = dynamic_cast<const DerivedGeneralized&>(*generalized);
-        visitor.Serialize(derivedGeneralized);
+        // A generalized expression is visited in place. A specialized one is visited through a
+        // generalized expression on the stack that shares its operands.
+        if constexpr (std::is_same_v<DerivedSpecialized, DerivedGeneralized>) {
+            visitor.Serialize(static_cast<const DerivedGeneralized&>(*this));
+        } else {
+            DerivedGeneralized generalized;
+            generalized.mostSigOp = this->mostSigOp;
+            generalized.leastSigOp = this->leastSigOp;
+            visitor.Serialize(generalized);
+        }
     }
 
-    std::unique_ptr<MostSigOpT> mostSigOp;
-    std::unique_ptr<LeastSigOpT> leastSigOp;
+protected:
+    [[nodiscard]] auto SimplifyImpl() const -> std::unique_ptr<Expression> override
+    {
+        return Generalize()->Simplify();
+    }
+
+    /**
+     * Simplifies both operands concurrently, then applies the sequential rules of this expression
+     * to the simplified operands. Since the simplified operands are in normal form, the sequential
+     * rules do not simplify them again, and the result is identical to that of `Simplify()`.
+     */
+    auto SimplifyImpl(tf::Subflow& subflow) const -> std::unique_ptr<Expression> override
+    {
+        std::unique_ptr<Expression> simplifiedMostSigOp, simplifiedLeastSigOp;
+
+        if (mostSigOp) {
+            subflow.emplace([this, &simplifiedMostSigOp](tf::Subflow& sbf) {
+                simplifiedMostSigOp = mostSigOp->Simplify(sbf);
+            });
+        }
+
+        if (leastSigOp) {
+            subflow.emplace([this, &simplifiedLeastSigOp](tf::Subflow& sbf) {
+                simplifiedLeastSigOp = leastSigOp->Simplify(sbf);
+            });
+        }
+
+        subflow.join();
+
+        DerivedGeneralized simplified;
+        simplified.mostSigOp = std::move(simplifiedMostSigOp);
+        simplified.leastSigOp = std::move(simplifiedLeastSigOp);
+
+        return Expression::SimplifyImpl(simplified);
+    }
+
+    [[nodiscard]] auto ComputeHash() const -> std::size_t override
+    {
+        const std::size_t typeSeed = MixHash(static_cast<std::size_t>(this->GetType()));
+
+        if (!(this->GetCategory() & Commutative)) {
+            const std::size_t mostSigOpHash = mostSigOp ? mostSigOp->Hash() : 0;
+            const std::size_t leastSigOpHash = leastSigOp ? leastSigOp->Hash() : 0;
+            return CombineHash(CombineHash(typeSeed, mostSigOpHash), leastSigOpHash);
+        }
+
+        // Commutative operands are summed so that their order does not matter. Operands of the
+        // same associative type contribute their own sums, so that every grouping of the same
+        // flattened operands hashes alike.
+        const auto operandHash = [this, typeSeed](const Expression* op) -> std::size_t {
+            if (op == nullptr) {
+                return 0;
+            }
+
+            if ((this->GetCategory() & Associative) && op->GetType() == this->GetType()) {
+                return op->Hash() - typeSeed;
+            }
+
+            return MixHash(op->Hash());
+        };
+
+        return typeSeed + operandHash(mostSigOp.get()) + operandHash(leastSigOp.get());
+    }
+
+public:
+    /**
+     * The operands are immutable and may be shared between any number of expressions, which allows
+     * copying and generalizing an expression without copying its subtrees.
+     */
+    std::shared_ptr<const MostSigOpT> mostSigOp;
+    std::shared_ptr<const LeastSigOpT> leastSigOp;
 };
 
 #define IMPL_SPECIALIZE(Derived, FirstOp, SecondOp)                                                                      \
@@ -564,41 +705,11 @@ public:
         return nullptr;                                                                                                  \
     }                                                                                                                    \
                                                                                                                          \
-    static auto Specialize(const Expression& other, tf::Subflow& subflow) -> std::unique_ptr<Derived<FirstOp, SecondOp>> \
+    static auto Specialize(const Expression& other, tf::Subflow&) -> std::unique_ptr<Derived<FirstOp, SecondOp>>         \
     {                                                                                                                    \
-        if (!other.Is<Oasis::Derived>()) {                                                                               \
-            return nullptr;                                                                                              \
-        }                                                                                                                \
-                                                                                                                         \
-        Derived<FirstOp, SecondOp> multiply;                                                                             \
-                                                                                                                         \
-        std::unique_ptr<Expression> otherGeneralized;                                                                    \
-                                                                                                                         \
-        tf::Task generalizeTask = subflow.emplace([&other, &otherGeneralized](tf::Subflow& sbf) {                        \
-            otherGeneralized = other.Generalize(sbf);                                                                    \
-        });                                                                                                              \
-                                                                                                                         \
-        tf::Task mostSigOpTask = subflow.emplace([&multiply, &otherGeneralized](tf::Subflow& sbf) {                      \
-            const auto& otherBinaryExpression = dynamic_cast<const Derived<Expression>&>(*otherGeneralized);             \
-            if (otherBinaryExpression.HasMostSigOp()) {                                                                  \
-                multiply.SetMostSigOp(*FirstOp::Specialize(otherBinaryExpression.GetMostSigOp(), sbf));                  \
-            }                                                                                                            \
-        });                                                                                                              \
-                                                                                                                         \
-        mostSigOpTask.succeed(generalizeTask);                                                                           \
-                                                                                                                         \
-        tf::Task leastSigOpTask = subflow.emplace([&multiply, &otherGeneralized](tf::Subflow& sbf) {                     \
-            const auto& otherBinaryExpression = dynamic_cast<const Derived<Expression>&>(*otherGeneralized);             \
-            if (otherBinaryExpression.HasLeastSigOp()) {                                                                 \
-                multiply.SetLeastSigOp(*SecondOp::Specialize(otherBinaryExpression.GetLeastSigOp(), sbf));               \
-            }                                                                                                            \
-        });                                                                                                              \
-                                                                                                                         \
-        leastSigOpTask.succeed(generalizeTask);                                                                          \
-                                                                                                                         \
-        subflow.join();                                                                                                  \
-                                                                                                                         \
-        return std::make_unique<Derived<FirstOp, SecondOp>>(multiply);                                                   \
+        /* Specializing only descends as deep as the pattern, and operands are shared rather */                          \
+        /* than copied, so spawning tasks here would cost more than it saves. */                                         \
+        return Specialize(other);                                                                                        \
     }
 } // Oasis
 
@@ -155,12 +155,12 @@ public:
         return std::make_unique<DerivedGeneralized>(generalized);
     }
 
-    [[nodiscard]] auto Simplify() const -> std::unique_ptr<Expression> override
+    [[nodiscard]] auto SimplifyImpl() const -> std::unique_ptr<Expression> override
     {
         return Generalize()->Simplify();
     }
 
-    auto Simplify(tf::Subflow& subflow) const -> std::unique_ptr<Expression> override
+    auto SimplifyImpl(tf::Subflow& subflow) const -> std::unique_ptr<Expression> override
     {
         std::unique_ptr<Expression> generalized, simplified;
 
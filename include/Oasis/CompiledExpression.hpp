@@ -0,0 +1,321 @@
+#ifndef OASIS_COMPILEDEXPRESSION_HPP
+#define OASIS_COMPILEDEXPRESSION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Expression.hpp"
+
+namespace Oasis {
+
+class Runtime;
+
+/**
+ * An expression compiled to a flat program for fast numeric evaluation.
+ *
+ * Compiling walks the expression once and emits a postfix program for a small stack machine.
+ * Each variable is bound to a slot, and evaluating the program reads the value of each variable
+ * from its slot. Subexpressions that do not depend on any variable are folded into constants.
+ * Unlike substituting a value for each variable and simplifying, evaluating a compiled
+ * expression neither allocates nor rebuilds the expression, which makes it suitable for sampling
+ * a function at many points.
+ *
+ * Several expressions may be compiled together into one program with one output per expression.
+ * A subexpression that occurs more than once, whether within one expression or across several, is
+ * computed once and stored to a temporary that every later occurrence loads. Only occurrences
+ * written identically are shared, so that every value is rounded as the expression is written.
+ *
+ * @code
+ * CompiledExpression compiled { expression, { "x", "y" } };
+ * double z = compiled.Evaluate(std::array { 1.0, 2.0 });
+ *
+ * std::vector<double> zs(xs.size());
+ * compiled.EvaluateMany(std::array<std::span<const double>, 2> { xs, ys }, zs);
+ * @endcode
+ */
+class CompiledExpression {
+public:
+    /**
+     * The operation performed by an instruction.
+     */
+    enum class OpCode : std::uint8_t {
+        Constant, ///< Pushes the constant at the index given by the operand.
+        Variable, ///< Pushes the value of the variable in the slot given by the operand.
+        Add,
+        Subtract,
+        Multiply,
+        Divide,
+        Exponent,
+        Log, ///< Pops the argument, then the base, and pushes the logarithm of the argument.
+        Negate,
+        Store, ///< Copies the top of the stack to the temporary given by the operand.
+        Load, ///< Pushes the temporary given by the operand.
+    };
+
+    /**
+     * A single step of a compiled program. Binary operations pop their least significant operand,
+     * then their most significant operand, and push the result.
+     */
+    struct Instruction {
+        OpCode opCode;
+        std::uint32_t operand;
+    };
+
+    /**
+     * The samples of one variable of a grid. The `i`th sample is `start + i * step`.
+     */
+    struct Axis {
+        double start;
+        double step;
+        std::size_t count;
+    };
+
+    /**
+     * Aggregates of the values of an expression over a grid.
+     */
+    struct Reduction {
+        double sum; ///< The sum of the values.
+        double min; ///< The least value, ignoring NaNs, or infinity if there are no values.
+        double max; ///< The greatest value, ignoring NaNs, or negative infinity if there are no values.
+    };
+
+    /**
+     * The value of an expression together with its derivative in some direction.
+     */
+    struct Dual {
+        double value;
+        double derivative;
+    };
+
+    /**
+     * Compiles an expression.
+     *
+     * @param expression The expression to compile. It may only contain real numbers, variables,
+     *                   sums, differences, products, quotients, powers, logarithms, and negations.
+     * @param variables The variables to bind to the first slots, in order. Any other variable in
+     *                  the expression is bound to the next free slot, in the order it first
+     *                  appears.
+     * @throws std::invalid_argument If the expression contains anything else.
+     */
+    explicit CompiledExpression(const Expression& expression, std::vector<std::string> variables = {});
+
+    /**
+     * Compiles several expressions into one program that computes all of them, such as a
+     * function together with its derivatives. Subexpressions they share are computed once.
+     * Methods that compute a single value compute the first expression.
+     *
+     * @param expressions The expressions to compile. Each becomes one output, in order.
+     * @param variables The variables to bind to the first slots, in order. Any other variable in
+     *                  the expressions is bound to the next free slot, in the order it first
+     *                  appears.
+     * @throws std::invalid_argument If there are no expressions or an expression contains
+     *                               anything but real numbers, variables, sums, differences,
+     *                               products, quotients, powers, logarithms, and negations.
+     */
+    explicit CompiledExpression(std::span<const Expression* const> expressions, std::vector<std::string> variables = {});
+
+    /**
+     * Evaluates this expression. Once the calling thread has evaluated an expression at least
+     * as large as this one, evaluation does not allocate.
+     *
+     * @param values The value of each variable, indexed by slot. Must have at least as many
+     *               elements as there are variables.
+     * @return The value of the expression.
+     */
+    [[nodiscard]] auto Evaluate(std::span<const double> values) const -> double;
+
+    /**
+     * Evaluates every output of this program.
+     *
+     * @param values The value of each variable, indexed by slot. Must have at least as many
+     *               elements as there are variables.
+     * @param outputs Receives the value of each output. Must have one element per output.
+     * @throws std::invalid_argument If the size of `outputs` is wrong.
+     */
+    auto Evaluate(std::span<const double> values, std::span<double> outputs) const -> void;
+
+    /**
+     * Evaluates this expression and its directional derivative in one pass using forward-mode
+     * automatic differentiation. For example, a tangent of `1` for slot `i` and `0` for every other
+     * slot gives the partial derivative with respect to the variable in slot `i`.
+     *
+     * @param values The value of each variable, indexed by slot. Must have at least as many
+     *               elements as there are variables.
+     * @param tangent The direction to differentiate in, indexed by slot. Must have at least as
+     *                many elements as there are variables.
+     * @return The value of the expression and its derivative in the direction of `tangent`.
+     */
+    [[nodiscard]] auto EvaluateDual(std::span<const double> values, std::span<const double> tangent) const -> Dual;
+
+    /**
+     * Evaluates this expression and its derivatives in several directions in one pass, such as
+     * to compute a Jacobian-vector product for each row of a Jacobian. Once the calling thread has
+     * evaluated an expression at least as large as this one with at least as many directions,
+     * evaluation does not allocate.
+     *
+     * @param values The value of each variable, indexed by slot. Must have at least as many
+     *               elements as there are variables.
+     * @param tangents The directions to differentiate in, one after another, each indexed by slot
+     *                 and with one element per variable.
+     * @param derivatives Receives the derivative in each direction. Its size is the number of
+     *                    directions.
+     * @return The value of the expression.
+     */
+    auto EvaluateDual(std::span<const double> values, std::span<const double> tangents, std::span<double> derivatives) const -> double;
+
+    /**
+     * Evaluates this expression and its gradient using reverse-mode automatic differentiation.
+     *
+     * A forward sweep evaluates the program and records each intermediate value on a tape, then a
+     * backward sweep propagates adjoints from the result to every variable. The cost is a small
+     * multiple of `Evaluate` regardless of the number of variables, which makes this the method of
+     * choice for scalar functions of many variables. The tape belongs to the calling thread and is
+     * reused, so once the thread has differentiated an expression at least as large as this one,
+     * this does not allocate.
+     *
+     * @param values The value of each variable, indexed by slot. Must have at least as many
+     *               elements as there are variables.
+     * @param gradient Receives the partial derivative with respect to each variable, indexed by
+     *                 slot. Must have at least as many elements as there are variables.
+     * @return The value of the expression.
+     */
+    auto EvaluateGradient(std::span<const double> values, std::span<double> gradient) const -> double;
+
+    /**
+     * Evaluates this expression at many points.
+     *
+     * Points are processed in blocks, with each instruction applied to a whole block at once.
+     * On x86-64 Linux, the block kernels are compiled for AVX-512, AVX2, and baseline x86-64, and
+     * the widest one the CPU supports is selected when the library is loaded. Elsewhere, they are
+     * compiled for the baseline instruction set of the target, such as NEON on AArch64. The
+     * results are bit-identical to those of `Evaluate` at the same points.
+     *
+     * @param columns The values of each variable, indexed by slot. Must have at least as many
+     *                columns as there are variables, and each column must have at least as many
+     *                elements as `results`.
+     * @param results Receives the value of the expression at each point.
+     */
+    auto EvaluateMany(std::span<const std::span<const double>> columns, std::span<double> results) const -> void;
+
+    /**
+     * Evaluates this expression at every point of a grid on the current `Runtime`.
+     *
+     * @param axes The samples of each variable, indexed by slot. Must have at least as many axes
+     *             as there are variables.
+     * @param results Receives the value of the expression at each point, in row-major order, so
+     *                the last axis varies fastest. Must have one element per point.
+     * @throws std::invalid_argument If there are too few axes or the size of `results` is wrong.
+     */
+    auto EvaluateGrid(std::span<const Axis> axes, std::span<double> results) const -> void;
+
+    /**
+     * Evaluates this expression at every point of a grid.
+     *
+     * The grid is split into chunks of consecutive points whose results fit in cache, and the
+     * chunks are evaluated in parallel like `EvaluateMany`. The coordinates of each point are
+     * generated as it is evaluated, so neither the inputs nor any per-chunk state is allocated.
+     *
+     * @param axes The samples of each variable, indexed by slot. Must have at least as many axes
+     *             as there are variables.
+     * @param results Receives the value of the expression at each point, in row-major order, so
+     *                the last axis varies fastest. Must have one element per point.
+     * @param runtime The runtime to evaluate on.
+     * @throws std::invalid_argument If there are too few axes or the size of `results` is wrong.
+     */
+    auto EvaluateGrid(std::span<const Axis> axes, std::span<double> results, Runtime& runtime) const -> void;
+
+    /**
+     * Aggregates the values of this expression over a grid on the current `Runtime`.
+     *
+     * @param axes The samples of each variable, indexed by slot. Must have at least as many axes
+     *             as there are variables.
+     * @return The sum, minimum, and maximum of the values of this expression over the grid.
+     * @throws std::invalid_argument If there are too few axes.
+     */
+    [[nodiscard]] auto ReduceGrid(std::span<const Axis> axes) const -> Reduction;
+
+    /**
+     * Aggregates the values of this expression over a grid.
+     *
+     * Like `EvaluateGrid`, but each block of values is folded into the aggregates while it is
+     * still in cache instead of being written out. The result does not depend on the number of
+     * workers.
+     *
+     * @param axes The samples of each variable, indexed by slot. Must have at least as many axes
+     *             as there are variables.
+     * @param runtime The runtime to evaluate on.
+     * @return The sum, minimum, and maximum of the values of this expression over the grid.
+     * @throws std::invalid_argument If there are too few axes.
+     */
+    [[nodiscard]] auto ReduceGrid(std::span<const Axis> axes, Runtime& runtime) const -> Reduction;
+
+    /**
+     * Gets the variables of this expression.
+     *
+     * @return The name of the variable bound to each slot, indexed by slot.
+     */
+    [[nodiscard]] auto GetVariables() const -> const std::vector<std::string>&;
+
+    /**
+     * Gets the slot a variable is bound to.
+     *
+     * @param name The name of the variable.
+     * @return The slot of the variable, or `std::nullopt` if no variable has that name.
+     */
+    [[nodiscard]] auto GetSlot(const std::string& name) const -> std::optional<std::size_t>;
+
+    /**
+     * Gets the program of this expression.
+     *
+     * @return The instructions of this expression, in the order they are executed.
+     */
+    [[nodiscard]] auto GetInstructions() const -> std::span<const Instruction>;
+
+    /**
+     * Gets the constants referenced by the program of this expression.
+     *
+     * @return The constants of this expression, indexed by the operand of `OpCode::Constant`.
+     */
+    [[nodiscard]] auto GetConstants() const -> std::span<const double>;
+
+    /**
+     * Gets the deepest the stack gets while evaluating this expression.
+     *
+     * @return The number of values the stack must hold.
+     */
+    [[nodiscard]] auto GetStackSize() const -> std::size_t;
+
+    /**
+     * Gets the number of temporaries the program of this expression stores shared
+     * subexpressions in.
+     *
+     * @return The operand of `OpCode::Store` and `OpCode::Load` is less than this.
+     */
+    [[nodiscard]] auto GetTemporaryCount() const -> std::size_t;
+
+    /**
+     * Gets the number of expressions compiled into this program.
+     *
+     * @return The number of outputs.
+     */
+    [[nodiscard]] auto GetOutputCount() const -> std::size_t;
+
+private:
+    // Runs the program and returns the stack, which holds the value of each output in order.
+    [[nodiscard]] auto Run(std::span<const double> values) const -> const double*;
+
+    std::vector<Instruction> instructions;
+    std::vector<double> constants;
+    std::vector<std::string> variables;
+    std::vector<std::uint32_t> outputs;
+    std::size_t stackSize = 0;
+    std::size_t temporaryCount = 0;
+};
+
+} // Oasis
+
+#endif // OASIS_COMPILEDEXPRESSION_HPP
@@ -21,9 +21,6 @@ public:
 
     Derivative(const Expression& Exp, const Expression& Var);
 
-    [[nodiscard]] auto Simplify() const -> std::unique_ptr<Expression> final;
-    auto Simplify(tf::Subflow& subflow) const -> std::unique_ptr<Expression> final;
-
     [[nodiscard]] auto Differentiate(const Expression& differentiationVariable) const -> std::unique_ptr<Expression> override;
 
     static auto Specialize(const Expression& other) -> std::unique_ptr<Derivative>;
@@ -31,6 +28,9 @@ public:
 
     EXPRESSION_TYPE(Derivative)
     EXPRESSION_CATEGORY(BinExp)
+
+protected:
+    [[nodiscard]] auto SimplifyImpl() const -> std::unique_ptr<Expression> final;
 };
 /// @endcond
 
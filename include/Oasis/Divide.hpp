@@ -21,9 +21,6 @@ public:
 
     Divide(const Expression& dividend, const Expression& divisor);
 
-    [[nodiscard]] auto Simplify() const -> std::unique_ptr<Expression> final;
-    auto Simplify(tf::Subflow& subflow) const -> std::unique_ptr<Expression> final;
-
     [[nodiscard]] auto Differentiate(const Expression& differentiationVariable) const -> std::unique_ptr<Expression> final;
 
     [[nodiscard]] auto Integrate(const Expression& integrationVariable) -> std::unique_ptr<Expression> final;
@@ -33,6 +30,9 @@ public:
 
     EXPRESSION_TYPE(Divide)
     EXPRESSION_CATEGORY(BinExp)
+
+protected:
+    [[nodiscard]] auto SimplifyImpl() const -> std::unique_ptr<Expression> final;
 };
 /// @endcond
 
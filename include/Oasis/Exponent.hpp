@@ -22,9 +22,6 @@ public:
 
     Exponent(const Expression& base, const Expression& power);
 
-    [[nodiscard]] auto Simplify() const -> std::unique_ptr<Expression> final;
-    auto Simplify(tf::Subflow& subflow) const -> std::unique_ptr<Expression> final;
-
     [[nodiscard]] auto Differentiate(const Expression& differentiationVariable) const -> std::unique_ptr<Expression> final;
 
     [[nodiscard]] auto Integrate(const Expression& integrationVariable) -> std::unique_ptr<Expression> final;
@@ -34,6 +31,9 @@ public:
 
     EXPRESSION_TYPE(Exponent)
     EXPRESSION_CATEGORY(BinExp)
+
+protected:
+    [[nodiscard]] auto SimplifyImpl() const -> std::unique_ptr<Expression> final;
 };
 /// @endcond
 
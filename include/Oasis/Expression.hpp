@@ -1,7 +1,12 @@
 #ifndef OASIS_EXPRESSION_HPP
 #define OASIS_EXPRESSION_HPP
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -12,6 +17,8 @@ class Subflow;
 namespace Oasis {
 
 class Expression;
+class ExpressionStore;
+class Runtime;
 class SerializationVisitor;
 
 /**
@@ -79,6 +86,32 @@ concept IExpression = (requires(T, const Expression& other, tf::Subflow& subflow
 template <typename T, typename... U>
 concept IsAnyOf = (std::same_as<T, U> || ...);
 
+/**
+ * Mixes the bits of a hash value so that nearby inputs produce unrelated outputs.
+ *
+ * @param hash The hash value to mix.
+ * @return The mixed hash value.
+ */
+constexpr auto MixHash(std::size_t hash) -> std::size_t
+{
+    auto x = static_cast<std::uint64_t>(hash) + 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return static_cast<std::size_t>(x ^ (x >> 31));
+}
+
+/**
+ * Combines a hash value into a seed in an order-sensitive way.
+ *
+ * @param seed The running hash value.
+ * @param hash The hash value to combine into the seed.
+ * @return The combined hash value.
+ */
+constexpr auto CombineHash(std::size_t seed, std::size_t hash) -> std::size_t
+{
+    return MixHash(seed ^ (hash + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2)));
+}
+
 /**
  * An expression.
  *
@@ -88,6 +121,29 @@ concept IsAnyOf = (std::same_as<T, U> || ...);
  */
 class Expression {
 public:
+    Expression() = default;
+    Expression(const Expression& other);
+
+    auto operator=(const Expression& other) -> Expression&;
+
+    /**
+     * Allocates an expression node. If an `ExpressionArena` is active on the calling thread, the
+     * node is placed in that arena, otherwise it is allocated on the heap.
+     *
+     * @param size The size of the node.
+     * @return The memory for the node.
+     */
+    static auto operator new(std::size_t size) -> void*;
+
+    static auto operator new(std::size_t size, void* ptr) noexcept -> void*;
+
+    /**
+     * Frees an expression node. Nodes placed in an arena are released with the arena instead.
+     *
+     * @param ptr The node to free.
+     */
+    static auto operator delete(void* ptr) noexcept -> void;
+
     /**
      * Copies this expression.
      * @return A copy of this expression.
@@ -120,6 +176,18 @@ public:
      */
     [[nodiscard]] virtual auto Equals(const Expression& other) const -> bool = 0;
 
+    /**
+     * Checks whether this expression is identical to another expression.
+     *
+     * Unlike `Equals`, this does not consider associativity or commutativity: two expressions are
+     * identical only if they have the same operands in the same order. For example, `x + y` and
+     * `y + x` are equal but not identical.
+     *
+     * @param other The other expression.
+     * @return Whether the two expressions are identical.
+     */
+    [[nodiscard]] auto Identical(const Expression& other) const -> bool;
+
     /**
      * The FindZeros function finds all rational real zeros, and up to 2 irrational/complex zeros of a polynomial. Currently assumes an expression of the form a+bx+cx^2+dx^3+... where a, b, c, d are a integers.
      *
@@ -139,6 +207,44 @@ public:
      */
     [[nodiscard]] virtual auto GetType() const -> ExpressionType;
 
+    /**
+     * Gets an operand of this expression without copying it.
+     *
+     * @param index The index of the operand, where 0 is the most significant operand.
+     * @return The operand, or `nullptr` if this expression has no operand at that index.
+     */
+    [[nodiscard]] virtual auto GetChild(std::size_t index) const -> const Expression*;
+
+    /**
+     * Gets the structural hash of this expression.
+     *
+     * The hash is computed once and cached. Expressions that are equal according to `Equals`
+     * have the same hash, so expressions with different hashes are never equal. The hash of a
+     * commutative expression does not depend on the order of its operands, and the hash of an
+     * associative expression does not depend on how its operands are grouped.
+     *
+     * @return The structural hash of this expression.
+     */
+    [[nodiscard]] auto Hash() const -> std::size_t;
+
+    /**
+     * Gets the number of nodes in this expression, including itself. The count is computed once
+     * and cached.
+     *
+     * @return The number of nodes in this expression.
+     */
+    [[nodiscard]] auto NodeCount() const -> std::size_t;
+
+    /**
+     * Checks whether this expression is in normal form, that is, whether it was produced by
+     * `Simplify`, simplifying it again was checked to leave it unchanged, and it has not been
+     * modified since. Simplifying an expression in normal form returns a copy of it without doing
+     * any work.
+     *
+     * @return Whether this expression is in normal form.
+     */
+    [[nodiscard]] auto IsSimplified() const -> bool;
+
     /**
      * Converts this expression to a more general expression.
      *
@@ -206,6 +312,15 @@ public:
      * @return A solved definite integral of the expression
      */
     [[nodiscard]] virtual auto IntegrateWithBounds(const Expression&, const Expression&, const Expression&) -> std::unique_ptr<Expression>;
+
+    /**
+     * Interns this expression and all of its subexpressions into a store.
+     *
+     * @param store The store to intern into.
+     * @return The shared node representing this expression in the store.
+     */
+    virtual auto Intern(ExpressionStore& store) const -> std::shared_ptr<const Expression>;
+
     /**
      * Gets whether this expression is of a specific type.
      *
@@ -226,6 +341,14 @@ public:
 
     /**
      * Simplifies this expression.
+     *
+     * If this expression is already in normal form, a copy of it is returned. Otherwise, if a
+     * `SimplifyCache` is active, the result is looked up in and recorded to it.
+     *
+     * Subclasses provide their simplification rules by overriding `SimplifyImpl`. Overriding this
+     * function instead still takes effect, as it did before `SimplifyImpl` existed, but bypasses the
+     * cache and never marks its result as being in normal form.
+     *
      * @return The simplified expression.
      */
     [[nodiscard]] virtual auto Simplify() const -> std::unique_ptr<Expression>;
@@ -233,6 +356,11 @@ public:
     /**
      * Simplifies this expression asynchronously.
      *
+     * If this expression is already in normal form, a copy of it is returned. Expressions with
+     * fewer nodes than `Runtime::GetSequentialCutoff()` are simplified sequentially, without
+     * spawning any tasks. Otherwise, if a `SimplifyCache` is active, the result is looked up in and
+     * recorded to it.
+     *
      * @note You probably want to use `SimplifyAsync` instead. This is an internal function that
      *       should only be used by the expression simplification system.
      * @param subflow The invoking subflow.
@@ -241,11 +369,18 @@ public:
     virtual auto Simplify(tf::Subflow& subflow) const -> std::unique_ptr<Expression>;
 
     /**
-     * Simplifies this expression asynchronously.
+     * Simplifies this expression asynchronously on the current `Runtime`.
      * @return The simplified expression.
      */
     [[nodiscard]] auto SimplifyAsync() const -> std::unique_ptr<Expression>;
 
+    /**
+     * Simplifies this expression asynchronously.
+     * @param runtime The runtime to simplify on.
+     * @return The simplified expression.
+     */
+    [[nodiscard]] auto SimplifyAsync(Runtime& runtime) const -> std::unique_ptr<Expression>;
+
     /**
      * Checks whether this expression is structurally equivalent to another expression.
      *
@@ -275,7 +410,7 @@ public:
     virtual auto StructurallyEquivalent(const Expression& other, tf::Subflow& subflow) const -> bool = 0;
 
     /**
-     * Checks whether this expression is structurally equivalent to another expression asynchronously.
+     * Checks whether this expression is structurally equivalent to another expression asynchronously on the current `Runtime`.
      *
      * Two expressions are structurally equivalent if the share the same tree structure. For
      * example, `Add<Real>(Real(1), Real(2))` and `Add<Real>(Real(2), Real(1))` are structurally equivalent
@@ -285,6 +420,16 @@ public:
      * @return Whether the two expressions are structurally equivalent.
      */
     [[nodiscard]] auto StructurallyEquivalentAsync(const Expression& other) const -> bool;
+
+    /**
+     * Checks whether this expression is structurally equivalent to another expression asynchronously.
+     *
+     * @param other The other expression.
+     * @param runtime The runtime to compare on.
+     * @return Whether the two expressions are structurally equivalent.
+     */
+    [[nodiscard]] auto StructurallyEquivalentAsync(const Expression& other, Runtime& runtime) const -> bool;
+
     [[nodiscard]] virtual auto Substitute(const Expression& var, const Expression& val) -> std::unique_ptr<Expression> = 0;
 
     /**
@@ -295,8 +440,153 @@ public:
     virtual void Serialize(SerializationVisitor& visitor) const = 0;
 
     virtual ~Expression() = default;
+
+protected:
+    /**
+     * Simplifies this expression. Called by `Simplify` when the result is not already cached.
+     *
+     * The result is marked as being in normal form once simplifying it again leaves it unchanged.
+     * Rules that construct a new expression should return it simplified, and rules that leave an
+     * expression unchanged should return it with its simplified operands, so that the check is cheap.
+     *
+     * @return The simplified expression.
+     */
+    [[nodiscard]] virtual auto SimplifyImpl() const -> std::unique_ptr<Expression>;
+
+    /**
+     * Simplifies this expression asynchronously. Called by `Simplify` when the result is not
+     * already cached.
+     *
+     * @param subflow The invoking subflow.
+     * @return The simplified expression.
+     */
+    virtual auto SimplifyImpl(tf::Subflow& subflow) const -> std::unique_ptr<Expression>;
+
+    /**
+     * Applies the simplification rules of another expression, without consulting the cache or
+     * marking the result. Lets an expression finish simplifying through a generalized copy of
+     * itself, leaving `Simplify` to do so once for the pair.
+     *
+     * @param expression The expression to simplify.
+     * @return The simplified expression.
+     */
+    static auto SimplifyImpl(const Expression& expression) -> std::unique_ptr<Expression>;
+
+    /**
+     * Computes the structural hash of this expression. Called at most once per expression by `Hash`.
+     *
+     * @return The structural hash of this expression.
+     */
+    [[nodiscard]] virtual auto ComputeHash() const -> std::size_t;
+
+    /**
+     * Discards the cached hash and node count and clears the normal-form flag. Must be called
+     * whenever the operands of this expression change.
+     */
+    auto Invalidate() -> void;
+
+private:
+    /**
+     * Marks a result of `SimplifyImpl` as being in normal form if it is a fixed point of the rules,
+     * simplifying it again a bounded number of times until it is. Results that do not settle are
+     * returned unmarked.
+     *
+     * @param result The result to check.
+     * @return The checked result.
+     */
+    static auto Settle(std::unique_ptr<Expression> result) -> std::unique_ptr<Expression>;
+
+    auto InternLeaf(ExpressionStore& store) const -> std::shared_ptr<const Expression>;
+
+    mutable std::atomic<std::size_t> cachedHash { 0 };
+    mutable std::atomic<std::size_t> cachedNodeCount { 0 };
+    bool simplified = false;
 };
 
+/**
+ * Hashes expressions, including those held by pointer, by their structural hash.
+ */
+struct ExpressionHash {
+    using is_transparent = void;
+
+    auto operator()(const Expression& expression) const -> std::size_t
+    {
+        return expression.Hash();
+    }
+
+    template <typename PointerT>
+        requires std::convertible_to<decltype(*std::declval<const PointerT&>()), const Expression&>
+    auto operator()(const PointerT& expression) const -> std::size_t
+    {
+        return expression->Hash();
+    }
+};
+
+/**
+ * Compares expressions, including those held by pointer, using `Expression::Equals`.
+ */
+struct ExpressionEqual {
+    using is_transparent = void;
+
+    auto operator()(const Expression& lhs, const Expression& rhs) const -> bool
+    {
+        return lhs.Equals(rhs);
+    }
+
+    template <typename LhsPointerT, typename RhsPointerT>
+        requires std::convertible_to<decltype(*std::declval<const LhsPointerT&>()), const Expression&>
+        && std::convertible_to<decltype(*std::declval<const RhsPointerT&>()), const Expression&>
+    auto operator()(const LhsPointerT& lhs, const RhsPointerT& rhs) const -> bool
+    {
+        return lhs->Equals(*rhs);
+    }
+};
+
+/**
+ * Compares expressions, including those held by pointer, using `Expression::Identical`.
+ */
+struct ExpressionIdentical {
+    using is_transparent = void;
+
+    auto operator()(const Expression& lhs, const Expression& rhs) const -> bool
+    {
+        return lhs.Identical(rhs);
+    }
+
+    template <typename LhsPointerT, typename RhsPointerT>
+        requires std::convertible_to<decltype(*std::declval<const LhsPointerT&>()), const Expression&>
+        && std::convertible_to<decltype(*std::declval<const RhsPointerT&>()), const Expression&>
+    auto operator()(const LhsPointerT& lhs, const RhsPointerT& rhs) const -> bool
+    {
+        return lhs->Identical(*rhs);
+    }
+};
+
+/**
+ * Simplifies many independent expressions as a single batch on the current `Runtime`.
+ *
+ * @param expressions The expressions to simplify. Null entries are skipped.
+ * @return The simplified expressions, in the same order as `expressions`.
+ */
+[[nodiscard]] auto SimplifyMany(std::span<const Expression* const> expressions) -> std::vector<std::unique_ptr<Expression>>;
+
+/**
+ * Simplifies many independent expressions as a single batch.
+ *
+ * Every expression is scheduled onto one task graph, so the runtime's workers stay busy across
+ * the whole batch instead of waiting on each expression in turn. The largest expressions are
+ * scheduled first and are simplified in parallel like `SimplifyAsync`; smaller ones are grouped
+ * into tasks of roughly `Runtime::GetSequentialCutoff()` nodes each and simplified sequentially.
+ *
+ * Expressions that are identical to each other are simplified only once. Installing a `SimplifyCache`
+ * additionally shares simplified subexpressions across the batch.
+ *
+ * @param expressions The expressions to simplify. Null entries are skipped.
+ * @param runtime The runtime to simplify on.
+ * @return The simplified expressions, in the same order as `expressions`.
+ */
+[[nodiscard]] auto SimplifyMany(std::span<const Expression* const> expressions, Runtime& runtime) -> std::vector<std::unique_ptr<Expression>>;
+
 #define EXPRESSION_TYPE(type)                       \
     auto GetType() const -> ExpressionType override \
     {                                               \
@@ -325,6 +615,14 @@ public:
 
 } // namespace Oasis
 
+template <>
+struct std::hash<Oasis::Expression> {
+    auto operator()(const Oasis::Expression& expression) const -> std::size_t
+    {
+        return expression.Hash();
+    }
+};
+
 std::unique_ptr<Oasis::Expression> operator+(const std::unique_ptr<Oasis::Expression>& lhs, const std::unique_ptr<Oasis::Expression>& rhs);
 std::unique_ptr<Oasis::Expression> operator-(const std::unique_ptr<Oasis::Expression>& lhs, const std::unique_ptr<Oasis::Expression>& rhs);
 std::unique_ptr<Oasis::Expression> operator*(const std::unique_ptr<Oasis::Expression>& lhs, const std::unique_ptr<Oasis::Expression>& rhs);
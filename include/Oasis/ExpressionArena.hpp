@@ -0,0 +1,138 @@
+#ifndef OASIS_EXPRESSIONARENA_HPP
+#define OASIS_EXPRESSIONARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+#include "Expression.hpp"
+
+namespace Oasis {
+
+/**
+ * A region allocator for expression nodes.
+ *
+ * While an arena is alive, every expression node allocated on the thread that created it is
+ * carved out of the arena instead of the heap. Freeing such a node is a no-op, and all of the
+ * arena's memory is released at once when the arena is destroyed. This makes the many temporary
+ * nodes created by `Simplify`, `Differentiate`, `Integrate` and the parsers nearly free to
+ * allocate and discard.
+ *
+ * Nodes allocated in an arena must not outlive it. Results that need to escape the arena must be
+ * promoted to the heap with `Promote` or computed through `Evaluate`. Nodes interned into an
+ * `ExpressionStore` are always allocated on the heap, so a store may outlive the arenas that were
+ * active while it was filled.
+ *
+ * Arenas nest: creating an arena while another is active suspends the outer one until the inner
+ * one is destroyed, so arenas must be destroyed in the reverse order of their creation. Nodes
+ * allocated on other threads, such as those used by `SimplifyAsync`, are unaffected and always
+ * live on the heap.
+ *
+ * Freeing a node tells arena nodes from heap nodes by address, looking it up among the blocks of
+ * memory reserved by the arenas of the calling thread, then by those of other threads. While no
+ * arena is alive, nodes are freed without any lookup.
+ *
+ * @code
+ * ExpressionArena arena;
+ * auto simplified = arena.Evaluate([&] { return expression.Simplify(); });
+ * @endcode
+ */
+class ExpressionArena {
+public:
+    /**
+     * Creates an arena and makes it the active arena of the calling thread.
+     *
+     * @param initialSize The size of the first block of memory the arena reserves.
+     */
+    explicit ExpressionArena(std::size_t initialSize = 64 * 1024);
+
+    ExpressionArena(const ExpressionArena&) = delete;
+    auto operator=(const ExpressionArena&) -> ExpressionArena& = delete;
+
+    /**
+     * Releases all memory held by this arena and reactivates the previously active arena, if any.
+     * The arena must be the active arena of the calling thread, otherwise the program terminates.
+     */
+    ~ExpressionArena();
+
+    /**
+     * Runs a function with this arena active and promotes its result to the heap.
+     *
+     * @param fn A function returning a `std::unique_ptr<Expression>`.
+     * @return A heap-allocated copy of the result, or `nullptr` if the function returned `nullptr`.
+     */
+    template <typename FnT>
+    auto Evaluate(FnT&& fn) -> std::unique_ptr<Expression>
+    {
+        const std::unique_ptr<Expression> result = std::forward<FnT>(fn)();
+        return result ? Promote(*result) : nullptr;
+    }
+
+    /**
+     * Copies an expression, including all of its subexpressions, to the heap.
+     *
+     * @param expression The expression to promote.
+     * @return A copy of the expression that does not reference memory owned by any arena.
+     */
+    static auto Promote(const Expression& expression) -> std::unique_ptr<Expression>;
+
+    /**
+     * Gets the arena that expression nodes allocated on the calling thread are placed in.
+     *
+     * @return The active arena, or `nullptr` if nodes are allocated on the heap.
+     */
+    static auto Current() -> ExpressionArena*;
+
+    /**
+     * Checks whether any arena is alive on any thread. While none is, every expression node is
+     * allocated on the heap.
+     *
+     * @return Whether any arena is alive.
+     */
+    static auto InUse() -> bool;
+
+    /**
+     * Gets the number of bytes of expression nodes allocated in this arena.
+     *
+     * @return The number of bytes allocated in this arena.
+     */
+    [[nodiscard]] auto BytesAllocated() const -> std::size_t;
+
+private:
+    friend class Expression;
+
+    // Reserves the blocks of memory that nodes are carved out of, and records where they are so
+    // that freeing a node can tell whether it belongs to an arena.
+    class BlockResource final : public std::pmr::memory_resource {
+    public:
+        [[nodiscard]] auto Owns(const void* ptr) const -> bool;
+
+    private:
+        auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override;
+        auto do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) -> void override;
+        [[nodiscard]] auto do_is_equal(const std::pmr::memory_resource& other) const noexcept -> bool override;
+
+        std::vector<std::pair<const std::byte*, const std::byte*>> blocks;
+    };
+
+    auto Allocate(std::size_t size) -> void*;
+
+    // Whether a node belongs to any arena alive on any thread.
+    static auto Owns(const void* ptr) -> bool;
+
+    // Deactivates the arenas of the calling thread, so that nodes are allocated on the heap until
+    // they are resumed. Returns whether they were already suspended.
+    static auto Suspend() -> bool;
+    static auto Resume(bool suspended) -> void;
+
+    BlockResource blocks;
+    std::pmr::monotonic_buffer_resource resource;
+    std::size_t bytesAllocated = 0;
+    ExpressionArena* previous;
+};
+
+} // Oasis
+
+#endif // OASIS_EXPRESSIONARENA_HPP
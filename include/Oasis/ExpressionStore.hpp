@@ -0,0 +1,96 @@
+#ifndef OASIS_EXPRESSIONSTORE_HPP
+#define OASIS_EXPRESSIONSTORE_HPP
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "Expression.hpp"
+
+namespace Oasis {
+
+/**
+ * A hash-consing store for expressions.
+ *
+ * Interning an expression through a store returns a shared, immutable node such that two
+ * structurally identical subtrees interned through the same store are represented by the same
+ * node. Interned expressions form a directed acyclic graph, so repeated subexpressions are
+ * stored only once and can be compared by address.
+ *
+ * Reals and variables are deduplicated by value and name respectively. Leaves with no identifying
+ * value, such as `Undefined` and `Matrix`, are interned as fresh nodes.
+ *
+ * The store keeps every node it has handed out alive until it is cleared or destroyed. It is safe
+ * to intern from multiple threads concurrently.
+ */
+class ExpressionStore {
+public:
+    /**
+     * Identifies a node by its type, its already-interned operands, and its leaf payload.
+     */
+    struct Key {
+        ExpressionType type = ExpressionType::None;
+        const Expression* mostSigOp = nullptr;
+        const Expression* leastSigOp = nullptr;
+        double value = 0.0;
+        std::string name {};
+
+        auto operator==(const Key& other) const -> bool;
+    };
+
+    ExpressionStore() = default;
+    ExpressionStore(const ExpressionStore&) = delete;
+    auto operator=(const ExpressionStore&) -> ExpressionStore& = delete;
+
+    /**
+     * Interns an expression and all of its subexpressions.
+     *
+     * @param expression The expression to intern.
+     * @return The canonical node for the expression.
+     */
+    auto Intern(const Expression& expression) -> std::shared_ptr<const Expression>;
+
+    /**
+     * Looks up the node for a key.
+     *
+     * @param key The key to look up.
+     * @return The node for the key, or `nullptr` if no such node has been interned.
+     */
+    [[nodiscard]] auto Find(const Key& key) const -> std::shared_ptr<const Expression>;
+
+    /**
+     * Inserts a node for a key. If another thread inserted a node for the same key first, that
+     * node is returned instead.
+     *
+     * @param key The key of the node.
+     * @param expression The node to insert.
+     * @return The canonical node for the key.
+     */
+    auto Insert(const Key& key, std::shared_ptr<const Expression> expression) -> std::shared_ptr<const Expression>;
+
+    /**
+     * Gets the number of distinct nodes in this store.
+     *
+     * @return The number of distinct nodes in this store.
+     */
+    [[nodiscard]] auto Size() const -> std::size_t;
+
+    /**
+     * Releases every node held by this store. Nodes still referenced elsewhere stay alive.
+     */
+    auto Clear() -> void;
+
+private:
+    struct KeyHash {
+        auto operator()(const Key& key) const -> std::size_t;
+    };
+
+    mutable std::mutex mutex;
+    std::unordered_map<Key, std::shared_ptr<const Expression>, KeyHash> nodes;
+};
+
+} // Oasis
+
+#endif // OASIS_EXPRESSIONSTORE_HPP
@@ -0,0 +1,266 @@
+#ifndef OASIS_FROZENEXPRESSION_HPP
+#define OASIS_FROZENEXPRESSION_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Expression.hpp"
+
+namespace Oasis {
+
+class SerializationVisitor;
+
+/**
+ * An immutable expression stored in a single contiguous, pointer-free buffer.
+ *
+ * The nodes of a frozen expression are numbered in postorder, so every node comes after its
+ * operands and the root is the last node. Each property of the nodes is stored in an array of its
+ * own: their types, their structural hashes, and two 32-bit indices per node. For an operation,
+ * the indices are its operands. For a real number, a variable, or a matrix, the first index
+ * refers into a pool of constants, names, or matrices. An operand shared by several nodes of the
+ * original expression is frozen once.
+ *
+ * Because the buffer holds no pointers, it can be written to a file and later viewed in place,
+ * such as from a memory-mapped file, without being parsed or copied. Comparing, hashing,
+ * traversing, and numerically evaluating a frozen expression all read the buffer directly.
+ *
+ * @code
+ * const FrozenExpression frozen = FrozenExpression::Freeze(expression);
+ * write(file, frozen.GetBytes());
+ *
+ * const FrozenExpression viewed = FrozenExpression::FromBytes(mappedBytes);
+ * double y = viewed.Evaluate(std::array { 2.0 });
+ * @endcode
+ */
+class FrozenExpression {
+public:
+    /**
+     * The index of a missing operand.
+     */
+    static constexpr std::uint32_t npos = UINT32_MAX;
+
+    /**
+     * The version of the layout this class reads and writes.
+     */
+    static constexpr std::uint32_t version = 2;
+
+    /**
+     * Freezes an expression.
+     *
+     * @param expression The expression to freeze. It may contain real numbers, imaginary units,
+     *                   variables, matrices, undefined values, sums, differences, products,
+     *                   quotients, powers, logarithms, negations, derivatives, and integrals.
+     * @return The frozen expression, which owns its buffer.
+     * @throws std::invalid_argument If the expression contains anything else, has more than
+     *                               `npos - 1` nodes, or is nested too deeply to view.
+     */
+    static auto Freeze(const Expression& expression) -> FrozenExpression;
+
+    /**
+     * Views a buffer written by `GetBytes` without copying it.
+     *
+     * The buffer is checked in a single pass, including every structural hash and the height of
+     * every node, after which no operation on the view reads outside the buffer, even if the
+     * buffer came from an untrusted source. Expressions taller than 4096 nodes are rejected, so
+     * that comparing them and destroying the result of `Thaw`, which both recurse as deep as the
+     * expression, are bounded.
+     *
+     * @param bytes The buffer to view. Its address must be aligned to 8 bytes, which every
+     *              memory-mapped file and every heap allocation is.
+     * @param owner An optional object that keeps the buffer alive, such as a memory mapping. If
+     *              it is `nullptr`, the buffer must outlive the view and every copy of it.
+     * @return The view.
+     * @throws std::invalid_argument If the buffer is misaligned, malformed, has a wrong hash, is
+     *                               of an unsupported version, was written on a machine of
+     *                               another byte order, or holds an expression that is nested
+     *                               too deeply.
+     */
+    static auto FromBytes(std::span<const std::byte> bytes, std::shared_ptr<const void> owner = nullptr) -> FrozenExpression;
+
+    /**
+     * Rebuilds the expression this was frozen from. Operands shared in the frozen expression are
+     * shared in the result. The result is built without recursion, but like any expression, it is
+     * destroyed recursively.
+     *
+     * @return The expression.
+     */
+    [[nodiscard]] auto Thaw() const -> std::unique_ptr<Expression>;
+
+    /**
+     * Compares this frozen expression with another like `Expression::Equals`.
+     *
+     * @param other The other frozen expression.
+     * @return Whether the expressions they were frozen from are equal.
+     */
+    [[nodiscard]] auto Equals(const FrozenExpression& other) const -> bool;
+
+    /**
+     * Compares the structure of this frozen expression with that of another like
+     * `Expression::StructurallyEquivalent`.
+     *
+     * @param other The other frozen expression.
+     * @return Whether the expressions they were frozen from are structurally equivalent.
+     */
+    [[nodiscard]] auto StructurallyEquivalent(const FrozenExpression& other) const -> bool;
+
+    /**
+     * Gets the structural hash of this frozen expression. Unlike `Expression::Hash`, it is the same
+     * on every platform, so it is stored in the buffer. Expressions that are equal have the same
+     * hash.
+     *
+     * @return The hash of the root.
+     */
+    [[nodiscard]] auto Hash() const -> std::uint64_t;
+
+    /**
+     * Serializes this frozen expression. The visitor is defined over expression nodes, so the
+     * operands of the root are thawed first, and the root is visited through a node on the stack
+     * that shares them. To store or send a frozen expression, write `GetBytes` instead.
+     *
+     * @param visitor The visitor to serialize with.
+     */
+    void Serialize(SerializationVisitor& visitor) const;
+
+    /**
+     * Numerically evaluates this frozen expression in a single pass over its nodes. Once the
+     * calling thread has evaluated a frozen expression with at least as many nodes, evaluation
+     * does not allocate.
+     *
+     * @param values The value of each variable, indexed like `GetVariable`.
+     * @return The value of the expression.
+     * @throws std::invalid_argument If there are fewer values than variables, or the expression
+     *                               contains anything but real numbers, variables, sums,
+     *                               differences, products, quotients, powers, logarithms, and
+     *                               negations.
+     */
+    [[nodiscard]] auto Evaluate(std::span<const double> values) const -> double;
+
+    /**
+     * Gets the buffer of this frozen expression, which `FromBytes` can view.
+     *
+     * @return The buffer.
+     */
+    [[nodiscard]] auto GetBytes() const -> std::span<const std::byte>;
+
+    /**
+     * Gets the number of nodes in this frozen expression.
+     *
+     * @return The number of nodes.
+     */
+    [[nodiscard]] auto GetNodeCount() const -> std::uint32_t;
+
+    /**
+     * Gets the root of this frozen expression.
+     *
+     * @return The index of the root, which is the last node.
+     */
+    [[nodiscard]] auto GetRoot() const -> std::uint32_t;
+
+    /**
+     * Gets the type of a node.
+     *
+     * @param node The index of the node.
+     * @return The type of the node.
+     */
+    [[nodiscard]] auto GetType(std::uint32_t node) const -> ExpressionType;
+
+    /**
+     * Gets an operand of a node.
+     *
+     * @param node The index of the node.
+     * @param index 0 for the most significant operand, or 1 for the least significant operand.
+     * @return The index of the operand, or `npos` if the node has no such operand.
+     */
+    [[nodiscard]] auto GetChild(std::uint32_t node, std::size_t index) const -> std::uint32_t;
+
+    /**
+     * Gets the value of a real number.
+     *
+     * @param node The index of a node of type `ExpressionType::Real`.
+     * @return The value of the node.
+     */
+    [[nodiscard]] auto GetValue(std::uint32_t node) const -> double;
+
+    /**
+     * Gets the name of a variable.
+     *
+     * @param node The index of a node of type `ExpressionType::Variable`.
+     * @return The name of the node, which views the buffer.
+     */
+    [[nodiscard]] auto GetName(std::uint32_t node) const -> std::string_view;
+
+    /**
+     * Gets the number of rows of a matrix.
+     *
+     * @param node The index of a node of type `ExpressionType::Matrix`.
+     * @return The number of rows of the node.
+     */
+    [[nodiscard]] auto GetMatrixRows(std::uint32_t node) const -> std::uint32_t;
+
+    /**
+     * Gets the number of columns of a matrix.
+     *
+     * @param node The index of a node of type `ExpressionType::Matrix`.
+     * @return The number of columns of the node.
+     */
+    [[nodiscard]] auto GetMatrixCols(std::uint32_t node) const -> std::uint32_t;
+
+    /**
+     * Gets the elements of a matrix.
+     *
+     * @param node The index of a node of type `ExpressionType::Matrix`.
+     * @return The elements of the node in row-major order, which view the buffer.
+     */
+    [[nodiscard]] auto GetMatrixValues(std::uint32_t node) const -> std::span<const double>;
+
+    /**
+     * Gets the number of distinct variables in this frozen expression.
+     *
+     * @return The number of variables.
+     */
+    [[nodiscard]] auto GetVariableCount() const -> std::uint32_t;
+
+    /**
+     * Gets the name of a distinct variable. Variables are numbered in the order they first occur
+     * in postorder.
+     *
+     * @param index The index of the variable.
+     * @return The name of the variable, which views the buffer.
+     */
+    [[nodiscard]] auto GetVariable(std::uint32_t index) const -> std::string_view;
+
+private:
+    FrozenExpression() = default;
+
+    static auto View(std::span<const std::byte> bytes, std::shared_ptr<const void> owner) -> FrozenExpression;
+
+    [[nodiscard]] auto HashAt(std::uint32_t node) const -> std::uint64_t;
+    [[nodiscard]] auto EqualsAt(std::uint32_t node, const FrozenExpression& other, std::uint32_t otherNode, std::unordered_map<std::uint64_t, bool>& memo) const -> bool;
+    [[nodiscard]] auto EqualOperandsAt(std::uint32_t node, const FrozenExpression& other, std::uint32_t otherNode, std::unordered_map<std::uint64_t, bool>& memo) const -> bool;
+    void FlattenAt(std::uint32_t node, ExpressionType type, std::vector<std::pair<std::uint32_t, std::uint64_t>>& out) const;
+
+    std::shared_ptr<const void> owner;
+    std::span<const std::byte> bytes;
+
+    std::uint32_t nodeCount = 0;
+    std::uint32_t nameCount = 0;
+
+    const std::uint64_t* hashes = nullptr;
+    const double* constants = nullptr;
+    const std::uint32_t* first = nullptr;
+    const std::uint32_t* second = nullptr;
+    const std::uint32_t* matrices = nullptr; ///< The rows, columns, and first constant of each matrix.
+    const std::uint32_t* nameOffsets = nullptr; ///< The offset of each name, followed by the end of the last.
+    const std::uint8_t* types = nullptr;
+    const char* names = nullptr;
+};
+
+} // Oasis
+
+#endif // OASIS_FROZENEXPRESSION_HPP
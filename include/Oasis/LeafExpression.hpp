@@ -56,9 +56,7 @@ public:
 
     void Serialize(SerializationVisitor& visitor) const override
     {
-        const auto generalized = Generalize();
-        const auto& derivedGeneralized = dynamic_cast<const DerivedT&>(*generalized);
-        visitor.Serialize(derivedGeneralized);
+        visitor.Serialize(static_cast<const DerivedT&>(*this));
     }
 };
 
@@ -6,6 +6,7 @@
 #define OASIS_LINEAR_HPP
 
 #include "Eigen/Dense"
+#include "Eigen/Sparse"
 #include <iostream>
 #include <map>
 #include <string>
@@ -15,15 +16,32 @@
 
 namespace Oasis {
 
+class Runtime;
+
 typedef Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> MatrixXXD;
 typedef Eigen::Matrix<double, Eigen::Dynamic, 1> Matrix1D;
+typedef Eigen::SparseMatrix<double> SparseMatrixXD;
 
 /**
+ * Solves a system of linear equations on the current `Runtime`.
+ *
+ * Large systems in which each equation involves only a few variables are assembled into a sparse
+ * matrix and solved by sparse LU decomposition. Other systems are solved densely.
+ *
  * @param exprs A vector of expressions
- * @return map of variable to their values
+ * @return map of variable to their values, or an empty map if the system is singular
  */
 auto SolveLinearSystems(std::vector<std::unique_ptr<Expression>>& exprs) -> std::map<std::string, double>;
 
+/**
+ * Solves a system of linear equations like the overload without a runtime.
+ *
+ * @param exprs A vector of expressions
+ * @param runtime The runtime to extract the terms of the equations on.
+ * @return map of variable to their values, or an empty map if the system is singular
+ */
+auto SolveLinearSystems(std::vector<std::unique_ptr<Expression>>& exprs, Runtime& runtime) -> std::map<std::string, double>;
+
 /**
  * @param matrix to solve (in row echelon form)
  * @return matrix of values that solves the input matrix
@@ -34,18 +52,52 @@ auto SolveLinearSystems(MatrixXXD& matrix) -> Matrix1D;
  * From the form Ax=b
  * @param matrixA Matrix that holds coefficients
  * @param matrixb Matrix that holds constants
- * @return x matrix that solves the A and b matrices
+ * @return x matrix that solves the A and b matrices, or an empty matrix if A is singular or the
+ * sizes do not match
  */
 auto SolveLinearSystems(MatrixXXD& matrixA, Matrix1D& matrixb) -> Matrix1D;
 
+/**
+ * From the form Ax=b, where A is sparse
+ * @param matrixA Square matrix that holds coefficients
+ * @param matrixb Matrix that holds constants
+ * @return x matrix that solves the A and b matrices, or an empty matrix if A is singular or the
+ * sizes do not match
+ */
+auto SolveLinearSystems(SparseMatrixXD& matrixA, Matrix1D& matrixb) -> Matrix1D;
+
 /**
  *
  * @param exprs A vector of simplified expressions
  * @return Dynamic Float matrix with the provided expressions inserted
+ * @throws std::invalid_argument If there are more variables than expressions.
  */
 auto ConstructMatrices(const std::vector<std::unique_ptr<Expression>>& exprs)
     -> std::pair<std::pair<MatrixXXD, Matrix1D>, std::map<std::string, Eigen::Index>>;
 
+/**
+ * Constructs the matrices of a system like `ConstructMatrices`, but stores only the nonzero
+ * coefficients, so that memory grows with the number of terms rather than the square of the
+ * number of expressions. The terms of the expressions are extracted on the current `Runtime`.
+ *
+ * @param exprs A vector of simplified expressions
+ * @return Sparse matrix of coefficients, matrix of constants, and the column of each variable
+ * @throws std::invalid_argument If there are more variables than expressions.
+ */
+auto ConstructSparseMatrices(const std::vector<std::unique_ptr<Expression>>& exprs)
+    -> std::pair<std::pair<SparseMatrixXD, Matrix1D>, std::map<std::string, Eigen::Index>>;
+
+/**
+ * Constructs the sparse matrices of a system like the overload without a runtime.
+ *
+ * @param exprs A vector of simplified expressions
+ * @param runtime The runtime to extract the terms of the expressions on.
+ * @return Sparse matrix of coefficients, matrix of constants, and the column of each variable
+ * @throws std::invalid_argument If there are more variables than expressions.
+ */
+auto ConstructSparseMatrices(const std::vector<std::unique_ptr<Expression>>& exprs, Runtime& runtime)
+    -> std::pair<std::pair<SparseMatrixXD, Matrix1D>, std::map<std::string, Eigen::Index>>;
+
 /**
  *
  * @tparam u key type
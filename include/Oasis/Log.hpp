@@ -22,14 +22,14 @@ public:
 
     Log(const Expression& base, const Expression& argument);
 
-    [[nodiscard]] auto Simplify() const -> std::unique_ptr<Expression> final;
-    auto Simplify(tf::Subflow& subflow) const -> std::unique_ptr<Expression> final;
-
     static auto Specialize(const Expression& other) -> std::unique_ptr<Log>;
     static auto Specialize(const Expression& other, tf::Subflow& subflow) -> std::unique_ptr<Log>;
 
     EXPRESSION_TYPE(Log)
     EXPRESSION_CATEGORY(BinExp)
+
+protected:
+    [[nodiscard]] auto SimplifyImpl() const -> std::unique_ptr<Expression> final;
 };
 /// @endcond
 
@@ -0,0 +1,278 @@
+#ifndef OASIS_MATCH_HPP
+#define OASIS_MATCH_HPP
+
+#include <memory>
+#include <optional>
+
+#include "Expression.hpp"
+
+namespace Oasis {
+
+template <typename PatternT>
+struct Matcher;
+
+/**
+ * Matches a typed pattern against an expression without copying or allocating.
+ *
+ * This is the non-owning counterpart to `Specialize`. Where `Specialize` builds a new, fully typed
+ * copy of the expression, `Match` checks the expression in place and returns a view of the matched
+ * operands that borrows from the expression. The view must not outlive the expression. As with
+ * `Specialize`, operands of commutative expressions are also tried in swapped order.
+ *
+ * The result behaves like a pointer: it converts to `false` when the pattern does not match, and
+ * `->GetMostSigOp()`, `->GetLeastSigOp()` and `->GetOperand()` return the matched operands. A leaf
+ * pattern such as `Real` matches to a `const Real*`, and `Expression` matches anything.
+ *
+ * @code
+ * if (auto likeTerms = Match<Add<Multiply<Real, Expression>>>(add)) {
+ *     const Real& coefficient = likeTerms->GetMostSigOp().GetMostSigOp();
+ * }
+ * @endcode
+ *
+ * @tparam PatternT The pattern to match, e.g. `Multiply<Real, Expression>`.
+ * @param expression The expression to match against.
+ * @return A view of the match, or an empty result if the expression does not match.
+ */
+template <typename PatternT>
+auto Match(const Expression& expression) -> typename Matcher<PatternT>::Result
+{
+    return Matcher<PatternT>::Match(expression);
+}
+
+/**
+ * A borrowed view of an expression that matched a binary pattern.
+ *
+ * @tparam DerivedT The matched binary expression template, e.g. `Add`.
+ * @tparam MostSigOpT The pattern of the most significant operand.
+ * @tparam LeastSigOpT The pattern of the least significant operand.
+ */
+template <template <typename, typename> class DerivedT, typename MostSigOpT, typename LeastSigOpT>
+class BinaryMatch {
+public:
+    using MostSigOpResult = typename Matcher<MostSigOpT>::Result;
+    using LeastSigOpResult = typename Matcher<LeastSigOpT>::Result;
+
+    BinaryMatch(const Expression& expression, MostSigOpResult mostSigOp, LeastSigOpResult leastSigOp)
+        : expression(&expression)
+        , mostSigOp(std::move(mostSigOp))
+        , leastSigOp(std::move(leastSigOp))
+    {
+    }
+
+    /**
+     * Gets the matched most significant operand.
+     * @return The matched most significant operand.
+     */
+    [[nodiscard]] auto GetMostSigOp() const -> decltype(auto)
+    {
+        return *mostSigOp;
+    }
+
+    /**
+     * Gets the matched least significant operand.
+     * @return The matched least significant operand.
+     */
+    [[nodiscard]] auto GetLeastSigOp() const -> decltype(auto)
+    {
+        return *leastSigOp;
+    }
+
+    /**
+     * Gets the matched expression. If the operands were matched in swapped order, the operands of
+     * this expression are in the opposite order of `GetMostSigOp` and `GetLeastSigOp`.
+     * @return The matched expression.
+     */
+    [[nodiscard]] auto GetExpression() const -> const Expression&
+    {
+        return *expression;
+    }
+
+    operator const Expression&() const
+    {
+        return *expression;
+    }
+
+    /**
+     * Builds a generalized expression from the matched operands, in matched order.
+     * @return The generalized expression.
+     */
+    [[nodiscard]] auto Generalize() const -> std::unique_ptr<Expression>
+    {
+        return std::make_unique<DerivedT<Expression, Expression>>(AsExpression(GetMostSigOp()), AsExpression(GetLeastSigOp()));
+    }
+
+    [[nodiscard]] auto Copy() const -> std::unique_ptr<Expression>
+    {
+        return Generalize();
+    }
+
+    [[nodiscard]] auto Equals(const Expression& other) const -> bool
+    {
+        return expression->Equals(other);
+    }
+
+private:
+    static auto AsExpression(const Expression& operand) -> const Expression&
+    {
+        return operand;
+    }
+
+    const Expression* expression;
+    MostSigOpResult mostSigOp;
+    LeastSigOpResult leastSigOp;
+};
+
+/**
+ * A borrowed view of an expression that matched a unary pattern.
+ *
+ * @tparam DerivedT The matched unary expression template, e.g. `Negate`.
+ * @tparam OperandT The pattern of the operand.
+ */
+template <template <typename> class DerivedT, typename OperandT>
+class UnaryMatch {
+public:
+    using OperandResult = typename Matcher<OperandT>::Result;
+
+    UnaryMatch(const Expression& expression, OperandResult op)
+        : expression(&expression)
+        , op(std::move(op))
+    {
+    }
+
+    /**
+     * Gets the matched operand.
+     * @return The matched operand.
+     */
+    [[nodiscard]] auto GetOperand() const -> decltype(auto)
+    {
+        return *op;
+    }
+
+    /**
+     * Gets the matched expression.
+     * @return The matched expression.
+     */
+    [[nodiscard]] auto GetExpression() const -> const Expression&
+    {
+        return *expression;
+    }
+
+    operator const Expression&() const
+    {
+        return *expression;
+    }
+
+    [[nodiscard]] auto Generalize() const -> std::unique_ptr<Expression>
+    {
+        return expression->Generalize();
+    }
+
+    [[nodiscard]] auto Copy() const -> std::unique_ptr<Expression>
+    {
+        return expression->Copy();
+    }
+
+    [[nodiscard]] auto Equals(const Expression& other) const -> bool
+    {
+        return expression->Equals(other);
+    }
+
+private:
+    const Expression* expression;
+    OperandResult op;
+};
+
+/**
+ * Matches leaf patterns, such as `Real` or `Variable`, and the `Expression` wildcard.
+ *
+ * @tparam PatternT The leaf type to match.
+ */
+template <typename PatternT>
+struct Matcher {
+    using Result = const PatternT*;
+
+    static auto Match(const Expression& expression) -> Result
+    {
+        if constexpr (std::same_as<PatternT, Expression>) {
+            return &expression;
+        } else {
+            return expression.Is<PatternT>() ? static_cast<const PatternT*>(&expression) : nullptr;
+        }
+    }
+};
+
+/// @cond
+template <template <typename, typename> class DerivedT, typename MostSigOpT, typename LeastSigOpT>
+struct Matcher<DerivedT<MostSigOpT, LeastSigOpT>> {
+    using Result = std::optional<BinaryMatch<DerivedT, MostSigOpT, LeastSigOpT>>;
+
+    static auto Match(const Expression& expression) -> Result
+    {
+        if (!expression.Is<DerivedT>()) {
+            return std::nullopt;
+        }
+
+        const Expression* mostSigOp = expression.GetChild(0);
+        const Expression* leastSigOp = expression.GetChild(1);
+
+        if (mostSigOp == nullptr || leastSigOp == nullptr) {
+            return std::nullopt;
+        }
+
+        if (auto result = MatchOperands(expression, *mostSigOp, *leastSigOp)) {
+            return result;
+        }
+
+        if (!(expression.GetCategory() & Commutative)) {
+            return std::nullopt;
+        }
+
+        return MatchOperands(expression, *leastSigOp, *mostSigOp);
+    }
+
+private:
+    static auto MatchOperands(const Expression& expression, const Expression& mostSigOp, const Expression& leastSigOp) -> Result
+    {
+        auto mostSigOpMatch = Matcher<MostSigOpT>::Match(mostSigOp);
+        if (!mostSigOpMatch) {
+            return std::nullopt;
+        }
+
+        auto leastSigOpMatch = Matcher<LeastSigOpT>::Match(leastSigOp);
+        if (!leastSigOpMatch) {
+            return std::nullopt;
+        }
+
+        return BinaryMatch<DerivedT, MostSigOpT, LeastSigOpT> { expression, std::move(mostSigOpMatch), std::move(leastSigOpMatch) };
+    }
+};
+
+template <template <typename> class DerivedT, typename OperandT>
+struct Matcher<DerivedT<OperandT>> {
+    using Result = std::optional<UnaryMatch<DerivedT, OperandT>>;
+
+    static auto Match(const Expression& expression) -> Result
+    {
+        if (!expression.Is<DerivedT<Expression>>()) {
+            return std::nullopt;
+        }
+
+        const Expression* op = expression.GetChild(0);
+
+        if (op == nullptr) {
+            return std::nullopt;
+        }
+
+        auto opMatch = Matcher<OperandT>::Match(*op);
+        if (!opMatch) {
+            return std::nullopt;
+        }
+
+        return UnaryMatch<DerivedT, OperandT> { expression, std::move(opMatch) };
+    }
+};
+/// @endcond
+
+} // Oasis
+
+#endif // OASIS_MATCH_HPP
@@ -29,9 +29,9 @@ public:
 
     /**
      * Gets the matrix.
-     * @return The matrix.
+     * @return The matrix, which is valid as long as this expression is.
      */
-    [[nodiscard]] auto GetMatrix() const -> MatrixXXD;
+    [[nodiscard]] auto GetMatrix() const -> const MatrixXXD&;
 
     /**
      * Gets the number of rows
@@ -67,6 +67,9 @@ public:
 
     auto operator=(const Matrix& other) -> Matrix& = default;
 
+protected:
+    [[nodiscard]] auto ComputeHash() const -> std::size_t final;
+
 private:
     MatrixXXD matrix {};
 };
@@ -18,7 +18,7 @@ public:
     Modulo(const Expression& dividend, const Expression& divisor)
         : BinaryExpression(dividend, divisor) {}
 
-    [[nodiscard]] auto Simplify() const -> std::unique_ptr<Expression> final {
+    [[nodiscard]] auto SimplifyImpl() const -> std::unique_ptr<Expression> final {
         if (this->GetLeastSigOp().IsZero()) {
             throw std::runtime_error("Division by zero in modulo operation.");
         }
@@ -34,7 +34,7 @@ public:
         return nullptr; // No further simplification possible
     }
 
-    auto Simplify(tf::Subflow& subflow) const -> std::unique_ptr<Expression> final {
+    auto SimplifyImpl(tf::Subflow& subflow) const -> std::unique_ptr<Expression> final {
         auto result = std::make_unique<Modulo>(*this);
 
         subflow.emplace([&]() {
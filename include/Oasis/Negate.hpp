@@ -24,7 +24,8 @@ public:
     {
     }
 
-    [[nodiscard]] auto Simplify() const -> std::unique_ptr<Expression> override
+protected:
+    [[nodiscard]] auto SimplifyImpl() const -> std::unique_ptr<Expression> override
     {
         return Multiply {
             Real { -1.0 },
@@ -33,7 +34,7 @@ public:
             .Simplify();
     }
 
-    auto Simplify(tf::Subflow& subflow) const -> std::unique_ptr<Expression> override
+    auto SimplifyImpl(tf::Subflow& subflow) const -> std::unique_ptr<Expression> override
     {
         return Multiply {
             Real { -1.0 },
@@ -42,6 +43,7 @@ public:
             .Simplify(subflow);
     }
 
+public:
     [[nodiscard]] auto Differentiate(const Expression& var) const -> std::unique_ptr<Expression> override
     {
         const std::unique_ptr<Expression> operandDerivative = this->GetOperand().Differentiate(var);
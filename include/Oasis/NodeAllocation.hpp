@@ -0,0 +1,50 @@
+#ifndef OASIS_NODEALLOCATION_HPP
+#define OASIS_NODEALLOCATION_HPP
+
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include "Expression.hpp"
+
+namespace Oasis {
+
+/// @cond
+// Helpers for readers that build expressions node by node, such as thawing a FrozenExpression or
+// decoding a binary document. They are not part of the public interface.
+
+// The height of the tallest expression a reader builds. Destroying an expression recurses once per
+// level, so this guards against trees too tall to destroy, such as a long chain of negations.
+inline constexpr std::size_t max_height = 4096;
+
+// A node is allocated uniquely if it is the root of an expression and shared if it is an operand,
+// so that every node takes a single allocation.
+template <bool Root>
+using ExpressionNode = std::conditional_t<Root, std::unique_ptr<Expression>, std::shared_ptr<const Expression>>;
+
+template <typename T, bool Root, typename... Args>
+auto AllocateNode(Args&&... args)
+{
+    if constexpr (Root) {
+        return std::make_unique<T>(std::forward<Args>(args)...);
+    } else {
+        return std::make_shared<T>(std::forward<Args>(args)...);
+    }
+}
+
+// Builds a generalized binary expression that shares the given operands, either of which may be
+// missing.
+template <template <typename, typename> typename T, bool Root = true>
+auto MakeBinaryNode(std::shared_ptr<const Expression> mostSigOp, std::shared_ptr<const Expression> leastSigOp) -> ExpressionNode<Root>
+{
+    auto expression = AllocateNode<T<Expression, Expression>, Root>();
+    expression->mostSigOp = std::move(mostSigOp);
+    expression->leastSigOp = std::move(leastSigOp);
+    return expression;
+}
+/// @endcond
+
+} // Oasis
+
+#endif // OASIS_NODEALLOCATION_HPP
@@ -38,6 +38,9 @@ public:
 
     auto operator=(const Real& other) -> Real& = default;
 
+protected:
+    [[nodiscard]] auto ComputeHash() const -> std::size_t final;
+
 private:
     double value {};
 };
@@ -0,0 +1,125 @@
+#ifndef OASIS_RUNTIME_HPP
+#define OASIS_RUNTIME_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace tf {
+class Executor;
+}
+
+namespace Oasis {
+
+/**
+ * Owns the thread pool used by Oasis' asynchronous APIs, such as `SimplifyAsync`.
+ *
+ * Every asynchronous API that is not given a runtime explicitly uses the installed runtime, or the
+ * default runtime if none is installed. The default runtime has one worker per hardware thread and
+ * is started on first use. Applications that need to control the number of workers, pin them to
+ * specific CPUs, or start them at a well-defined point should create their own runtime and install
+ * it before calling any asynchronous API.
+ *
+ * @code
+ * Runtime runtime { 4, { 0, 1, 2, 3 } };
+ * Runtime::Install(&runtime);
+ * auto simplified = expression.SimplifyAsync();
+ * @endcode
+ */
+class Runtime {
+public:
+    /**
+     * Starts a runtime with one worker per hardware thread.
+     */
+    Runtime();
+
+    /**
+     * Starts a runtime.
+     *
+     * @param workers The number of worker threads. Must be at least one.
+     * @param cpus The CPUs to pin workers to. Worker `i` is pinned to `cpus[i % cpus.size()]`. If
+     *             empty, workers are not pinned. Pinning is only supported on Linux and is ignored
+     *             elsewhere.
+     * @throws std::invalid_argument If a CPU index is not less than `CPU_SETSIZE`.
+     */
+    explicit Runtime(std::size_t workers, std::vector<std::size_t> cpus = {});
+
+    Runtime(const Runtime&) = delete;
+    auto operator=(const Runtime&) -> Runtime& = delete;
+
+    /**
+     * Waits for all submitted work to finish and joins the workers. If this runtime is installed,
+     * it is uninstalled first.
+     */
+    ~Runtime();
+
+    /**
+     * Makes a runtime the one used by asynchronous APIs that are not given one explicitly.
+     *
+     * @param runtime The runtime to install, or `nullptr` to revert to the default runtime.
+     * @return The previously installed runtime, if any.
+     */
+    static auto Install(Runtime* runtime) -> Runtime*;
+
+    /**
+     * Gets the runtime used by asynchronous APIs that are not given one explicitly.
+     *
+     * @return The installed runtime, or the default runtime if none is installed.
+     */
+    static auto Current() -> Runtime&;
+
+    /**
+     * Gets the default runtime, starting it if it has not been started yet.
+     *
+     * @return The default runtime.
+     */
+    static auto Default() -> Runtime&;
+
+    /**
+     * Sets the size below which asynchronous operations such as `SimplifyAsync` stop spawning
+     * tasks and continue sequentially. This applies to every runtime.
+     *
+     * @param nodes The number of nodes, as counted by `Expression::NodeCount`, below which
+     *              subexpressions are processed sequentially. Zero always spawns tasks.
+     */
+    static auto SetSequentialCutoff(std::size_t nodes) -> void;
+
+    /**
+     * Gets the size below which asynchronous operations stop spawning tasks.
+     *
+     * @return The sequential cutoff, in nodes.
+     */
+    static auto GetSequentialCutoff() -> std::size_t;
+
+    /**
+     * Gets the executor that runs this runtime's work.
+     *
+     * @return The executor of this runtime.
+     */
+    auto GetExecutor() -> tf::Executor&;
+
+    /**
+     * Gets the number of worker threads of this runtime.
+     *
+     * @return The number of worker threads.
+     */
+    [[nodiscard]] auto GetWorkerCount() const -> std::size_t;
+
+    /**
+     * Gets the number of workers that could not be pinned to their CPU, for example because the
+     * CPU does not exist or is not available to this process. Workers are pinned as they start,
+     * so this count may grow shortly after the runtime is created.
+     *
+     * @return The number of workers that failed to pin themselves.
+     */
+    [[nodiscard]] auto GetPinningFailures() const -> std::size_t;
+
+private:
+    std::shared_ptr<std::atomic<std::size_t>> pinningFailures;
+    std::unique_ptr<tf::Executor> executor;
+};
+
+} // Oasis
+
+#endif // OASIS_RUNTIME_HPP
@@ -0,0 +1,165 @@
+#ifndef OASIS_SIMPLIFYCACHE_HPP
+#define OASIS_SIMPLIFYCACHE_HPP
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "Expression.hpp"
+
+namespace Oasis {
+
+/**
+ * A bounded memo table mapping expressions to their simplified forms.
+ *
+ * Caching is opt-in. Once a cache is installed with `Install`, every call to `Simplify` on any
+ * thread looks the expression up in the cache before simplifying it, and records the result
+ * afterward. Since simplification recurses into subexpressions, expressions that share
+ * subexpressions benefit from each other's entries. Leaves are never cached. While an
+ * `ExpressionArena` is alive, only the results of outermost calls to `Simplify` are recorded.
+ *
+ * Expressions are matched by structural hash and `Expression::Identical`, so an entry is only
+ * reused for an expression with its operands in the same order. When the cache is full, either by
+ * number of entries or by estimated memory use, the least recently used entries are evicted.
+ *
+ * Entries never reference memory owned by an `ExpressionArena`, so a cache may safely outlive the
+ * arenas of the sessions that filled it. It is safe to use from multiple threads concurrently. The
+ * installed cache is shared, so uninstalling it while another thread is simplifying through it
+ * keeps it alive until that thread is done.
+ *
+ * @code
+ * SimplifyCache::Install(std::make_shared<SimplifyCache>(1024));
+ * auto simplified = expression.Simplify();
+ * SimplifyCache::Install(nullptr);
+ * @endcode
+ */
+class SimplifyCache {
+public:
+    /**
+     * Creates an empty cache. The cache is not used until it is installed.
+     *
+     * @param maxEntries The maximum number of entries to keep.
+     * @param maxBytes The maximum estimated memory use of the cached expressions, in bytes.
+     */
+    explicit SimplifyCache(std::size_t maxEntries = 4096, std::size_t maxBytes = 64 * 1024 * 1024);
+
+    SimplifyCache(const SimplifyCache&) = delete;
+    auto operator=(const SimplifyCache&) -> SimplifyCache& = delete;
+
+    /**
+     * Makes a cache the one used by `Simplify` on every thread.
+     *
+     * @param cache The cache to install, or `nullptr` to disable caching.
+     * @return The previously installed cache, if any.
+     */
+    static auto Install(std::shared_ptr<SimplifyCache> cache) -> std::shared_ptr<SimplifyCache>;
+
+    /**
+     * Gets the installed cache.
+     *
+     * @return The installed cache, or `nullptr` if caching is disabled.
+     */
+    static auto Active() -> std::shared_ptr<SimplifyCache>;
+
+    /**
+     * Marks a call to `Simplify` as in progress on the calling thread for as long as it is alive.
+     *
+     * While any `ExpressionArena` is alive, entries must be copied to the heap in full. To copy
+     * each result once rather than once per level of the expression, only the outermost call to
+     * `Simplify` on each thread records its result in that case.
+     */
+    class Scope {
+    public:
+        Scope();
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        auto operator=(const Scope&) -> Scope& = delete;
+    };
+
+    /**
+     * Looks up the simplified form of an expression.
+     *
+     * @param expression The expression to look up.
+     * @return A copy of the cached simplified form, or `nullptr` if the expression is not cached.
+     */
+    auto Find(const Expression& expression) -> std::unique_ptr<Expression>;
+
+    /**
+     * Records the simplified form of an expression, evicting the least recently used entries as
+     * needed. If the expression is already cached, its entry is kept.
+     *
+     * @param expression The expression that was simplified.
+     * @param simplified The simplified form of the expression.
+     */
+    auto Insert(const Expression& expression, const Expression& simplified) -> void;
+
+    /**
+     * Gets the number of entries in this cache.
+     *
+     * @return The number of entries in this cache.
+     */
+    [[nodiscard]] auto Size() const -> std::size_t;
+
+    /**
+     * Gets the estimated memory use of the expressions held by this cache.
+     *
+     * @return The estimated memory use of this cache, in bytes.
+     */
+    [[nodiscard]] auto BytesUsed() const -> std::size_t;
+
+    /**
+     * Gets the number of lookups that found an entry.
+     *
+     * @return The number of cache hits.
+     */
+    [[nodiscard]] auto Hits() const -> std::size_t;
+
+    /**
+     * Gets the number of lookups that did not find an entry.
+     *
+     * @return The number of cache misses.
+     */
+    [[nodiscard]] auto Misses() const -> std::size_t;
+
+    /**
+     * Gets the number of entries evicted to make room for others.
+     *
+     * @return The number of evictions.
+     */
+    [[nodiscard]] auto Evictions() const -> std::size_t;
+
+    /**
+     * Removes every entry and resets the counters.
+     */
+    auto Clear() -> void;
+
+private:
+    struct Entry {
+        std::shared_ptr<const Expression> expression;
+        std::shared_ptr<const Expression> simplified;
+        std::size_t bytes;
+    };
+
+    auto Evict() -> void;
+
+    std::size_t maxEntries;
+    std::size_t maxBytes;
+
+    mutable std::mutex mutex;
+
+    // Ordered from most to least recently used.
+    std::list<Entry> entries;
+    std::unordered_map<const Expression*, std::list<Entry>::iterator, ExpressionHash, ExpressionIdentical> index;
+
+    std::size_t bytesUsed = 0;
+    std::size_t hits = 0;
+    std::size_t misses = 0;
+    std::size_t evictions = 0;
+};
+
+} // Oasis
+
+#endif // OASIS_SIMPLIFYCACHE_HPP
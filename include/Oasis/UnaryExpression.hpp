@@ -5,7 +5,10 @@
 #ifndef UNARYEXPRESSION_HPP
 #define UNARYEXPRESSION_HPP
 
+#include <type_traits>
+
 #include "Expression.hpp"
+#include "ExpressionStore.hpp"
 #include "Serialization.hpp"
 
 namespace Oasis {
@@ -21,10 +24,8 @@ public:
 
     UnaryExpression(const UnaryExpression& other)
         : Expression(other)
+        , op(other.op)
     {
-        if (other.HasOperand()) {
-            SetOperand(other.GetOperand());
-        }
     }
 
     explicit UnaryExpression(const OperandT& operand)
@@ -44,7 +45,7 @@ public:
 
     [[nodiscard]] auto Equals(const Expression& other) const -> bool final
     {
-        if (!other.Is<DerivedSpecialized>()) {
+        if (!other.Is<DerivedSpecialized>() || this->Hash() != other.Hash()) {
             return false;
         }
 
@@ -57,12 +58,20 @@ public:
 
     [[nodiscard]] auto Generalize() const -> std::unique_ptr<Expression> final
     {
-        return std::make_unique<DerivedGeneralized>(*this);
+        auto generalized = std::make_unique<DerivedGeneralized>();
+        generalized->op = this->op;
+
+        return generalized;
+    }
+
+    auto Generalize(tf::Subflow&) const -> std::unique_ptr<Expression> final
+    {
+        return Generalize();
     }
 
-    auto Generalize(tf::Subflow& subflow) const -> std::unique_ptr<Expression> final
+    [[nodiscard]] auto GetChild(std::size_t index) const -> const Expression* final
     {
-        return DerivedGeneralized { *this }.Copy(subflow);
+        return index == 0 ? op.get() : nullptr;
     }
 
     auto GetOperand() const -> const OperandT&
@@ -87,13 +96,25 @@ public:
 
     auto SetOperand(const OperandT& operand) -> void
     {
+        this->Invalidate();
+
         if constexpr (std::same_as<OperandT, Expression>) {
             this->op = operand.Copy();
         } else {
-            this->op = std::make_unique<OperandT>(operand);
+            this->op = std::make_shared<OperandT>(operand);
         }
     }
 
+    /**
+     * Sets the operand of this expression without copying it.
+     * @param operand The operand to set, which may be shared with other expressions.
+     */
+    auto SetOperand(std::shared_ptr<const OperandT> operand) -> void
+    {
+        this->Invalidate();
+        this->op = std::move(operand);
+    }
+
     auto Substitute(const Expression& var, const Expression& val) -> std::unique_ptr<Expression> override
     {
         std::unique_ptr<Expression> right = ((GetOperand().Copy())->Substitute(var, val));
@@ -104,13 +125,45 @@ public:
 
     void Serialize(SerializationVisitor& visitor) const override
     {
-        const auto generalized = Generalize();
-        const auto& derivedGeneralized = dynamic_cast<const DerivedGeneralized&>(*generalized);
-        visitor.Serialize(derivedGeneralized);
+        // As with binary expressions, the operand is shared rather than copied.
+        if constexpr (std::is_same_v<DerivedSpecialized, DerivedGeneralized>) {
+            visitor.Serialize(static_cast<const DerivedGeneralized&>(*this));
+        } else {
+            DerivedGeneralized generalized;
+            generalized.op = this->op;
+            visitor.Serialize(generalized);
+        }
+    }
+
+    auto Intern(ExpressionStore& store) const -> std::shared_ptr<const Expression> final
+    {
+        std::shared_ptr<const Expression> internedOp = op ? op->Intern(store) : nullptr;
+
+        const ExpressionStore::Key key { .type = this->GetType(), .mostSigOp = internedOp.get() };
+
+        if (auto existing = store.Find(key); existing != nullptr) {
+            return existing;
+        }
+
+        auto node = std::make_shared<DerivedGeneralized>();
+        node->op = std::move(internedOp);
+
+        return store.Insert(key, std::move(node));
     }
 
 protected:
-    std::unique_ptr<OperandT> op;
+    [[nodiscard]] auto ComputeHash() const -> std::size_t override
+    {
+        return CombineHash(MixHash(static_cast<std::size_t>(this->GetType())), op ? op->Hash() : 0);
+    }
+
+    template <template <IExpression> class, IExpression>
+    friend class UnaryExpression;
+
+    /**
+     * The operand is immutable and may be shared between any number of expressions.
+     */
+    std::shared_ptr<const OperandT> op;
 };
 
 #define IMPL_SPECIALIZE_UNARYEXPR(DerivedT, OperandT)                                           \
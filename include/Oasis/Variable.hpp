@@ -48,6 +48,9 @@ public:
 
     auto operator=(const Variable& other) -> Variable& = default;
 
+protected:
+    [[nodiscard]] auto ComputeHash() const -> std::size_t final;
+
 private:
     std::string name {};
 };
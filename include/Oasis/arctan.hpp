@@ -13,14 +13,15 @@ public:
 
     explicit ArcTan(const Expression& operand);
 
-    [[nodiscard]] auto Simplify() const -> std::unique_ptr<Expression> final;
-    auto Simplify(tf::Subflow& subflow) const -> std::unique_ptr<Expression> final;
-
     static auto Specialize(const Expression& other) -> std::unique_ptr<ArcTan>;
     static auto Specialize(const Expression& other, tf::Subflow& subflow) -> std::unique_ptr<ArcTan>;
 
     EXPRESSION_TYPE(ArcTan)
     EXPRESSION_CATEGORY(UnExp)
+
+protected:
+    [[nodiscard]] auto SimplifyImpl() const -> std::unique_ptr<Expression> final;
+    auto SimplifyImpl(tf::Subflow& subflow) const -> std::unique_ptr<Expression> final;
 };
 
 } // namespace Oasis
@@ -1,6 +1,7 @@
 //
 // Created by Matthew McCall on 7/2/23.
 //
+#include <optional>
 #include <unordered_map>
 
 #include "Oasis/Add.hpp"
@@ -9,33 +10,34 @@
 #include "Oasis/Integral.hpp"
 #include "Oasis/Log.hpp"
 #include "Oasis/Matrix.hpp"
+#include "Oasis/Match.hpp"
 #include "Oasis/Multiply.hpp"
 
 #define EPSILON 10E-6
 
 namespace Oasis {
 
-auto Add<Expression>::Simplify() const -> std::unique_ptr<Expression>
+auto Add<Expression>::SimplifyImpl() const -> std::unique_ptr<Expression>
 {
     auto simplifiedAugend = mostSigOp ? mostSigOp->Simplify() : nullptr;
     auto simplifiedAddend = leastSigOp ? leastSigOp->Simplify() : nullptr;
 
     Add simplifiedAdd { *simplifiedAugend, *simplifiedAddend };
 
-    if (auto realCase = Add<Real>::Specialize(simplifiedAdd); realCase != nullptr) {
+    if (auto realCase = Match<Add<Real>>(simplifiedAdd)) {
         const Real& firstReal = realCase->GetMostSigOp();
         const Real& secondReal = realCase->GetLeastSigOp();
 
         return std::make_unique<Real>(firstReal.GetValue() + secondReal.GetValue());
     }
 
-    if (auto zeroCase = Add<Real, Expression>::Specialize(simplifiedAdd); zeroCase != nullptr) {
+    if (auto zeroCase = Match<Add<Real, Expression>>(simplifiedAdd)) {
         if (zeroCase->GetMostSigOp().GetValue() == 0) {
             return zeroCase->GetLeastSigOp().Generalize();
         }
     }
 
-    if (auto likeTermsCase = Add<Multiply<Real, Expression>>::Specialize(simplifiedAdd); likeTermsCase != nullptr) {
+    if (auto likeTermsCase = Match<Add<Multiply<Real, Expression>>>(simplifiedAdd)) {
         const Oasis::IExpression auto& leftTerm = likeTermsCase->GetMostSigOp().GetLeastSigOp();
         const Oasis::IExpression auto& rightTerm = likeTermsCase->GetLeastSigOp().GetLeastSigOp();
 
@@ -43,12 +45,12 @@ auto Add<Expression>::Simplify() const -> std::unique_ptr<Expression>
             const Real& coefficient1 = likeTermsCase->GetMostSigOp().GetMostSigOp();
             const Real& coefficient2 = likeTermsCase->GetLeastSigOp().GetMostSigOp();
 
-            return std::make_unique<Multiply<Expression>>(Real(coefficient1.GetValue() + coefficient2.GetValue()), leftTerm);
+            return Multiply<Expression> { Real { coefficient1.GetValue() + coefficient2.GetValue() }, leftTerm }.Simplify();
         }
     }
 
     // matrix + matrix
-    if (auto matrixCase = Add<Matrix, Matrix>::Specialize(simplifiedAdd); matrixCase != nullptr) {
+    if (auto matrixCase = Match<Add<Matrix, Matrix>>(simplifiedAdd)) {
         const Oasis::IExpression auto& leftTerm = matrixCase->GetMostSigOp();
         const Oasis::IExpression auto& rightTerm = matrixCase->GetLeastSigOp();
 
@@ -60,11 +62,11 @@ auto Add<Expression>::Simplify() const -> std::unique_ptr<Expression>
     }
 
     // log(a) + log(b) = log(ab)
-    if (auto logCase = Add<Log<Expression, Expression>, Log<Expression, Expression>>::Specialize(simplifiedAdd); logCase != nullptr) {
+    if (auto logCase = Match<Add<Log<Expression, Expression>, Log<Expression, Expression>>>(simplifiedAdd)) {
         if (logCase->GetMostSigOp().GetMostSigOp().Equals(logCase->GetLeastSigOp().GetMostSigOp())) {
             const IExpression auto& base = logCase->GetMostSigOp().GetMostSigOp();
             const IExpression auto& argument = Multiply<Expression>({ logCase->GetMostSigOp().GetLeastSigOp(), logCase->GetLeastSigOp().GetLeastSigOp() });
-            return std::make_unique<Log<Expression>>(base, argument);
+            return Log<Expression> { base, argument }.Simplify();
         }
     }
 
@@ -74,136 +76,78 @@ auto Add<Expression>::Simplify() const -> std::unique_ptr<Expression>
     }
 
     // 2x + x = 3x
-    if (const auto likeTermsCase2 = Add<Multiply<Real, Expression>, Expression>::Specialize(simplifiedAdd); likeTermsCase2 != nullptr) {
+    if (const auto likeTermsCase2 = Match<Add<Multiply<Real, Expression>, Expression>>(simplifiedAdd)) {
         if (likeTermsCase2->GetMostSigOp().GetLeastSigOp().Equals(likeTermsCase2->GetLeastSigOp())) {
             const Real& coeffiecent = likeTermsCase2->GetMostSigOp().GetMostSigOp();
-            return std::make_unique<Multiply<Real, Expression>>(Real { coeffiecent.GetValue() + 1 }, likeTermsCase2->GetMostSigOp().GetLeastSigOp());
+            return Multiply<Real, Expression> { Real { coeffiecent.GetValue() + 1 }, likeTermsCase2->GetMostSigOp().GetLeastSigOp() }.Simplify();
         }
     }
 
     // simplifies expressions and combines like terms
     // ex: 1 + 2x + 3 + 5x = 4 + 7x (or 7x + 4)
-    std::vector<std::unique_ptr<Expression>> adds;
-    std::vector<std::unique_ptr<Expression>> vals;
+    // Terms are bucketed by their non-coefficient part, so combining n terms takes expected linear time.
+    std::vector<std::shared_ptr<const Expression>> adds;
     simplifiedAdd.Flatten(adds);
-    for (const auto& addend : adds) {
-        // real
-        size_t i = 0;
-        if (auto real = Real::Specialize(*addend); real != nullptr) {
-            for (; i < vals.size(); i++) {
-                if (auto valI = Real::Specialize(*vals[i]); valI != nullptr) {
-                    vals[i] = Real { valI->GetValue() + real->GetValue() }.Generalize();
-                    break;
-                }
-            }
-            if (i >= vals.size()) {
-                // check to make sure it is one thing only
-                vals.push_back(addend->Generalize());
-            }
-            continue;
-        }
-        // single i
-        if (auto img = Imaginary::Specialize(*addend); img != nullptr) {
-            for (; i < vals.size(); i++) {
-                if (auto valI = Multiply<Expression, Imaginary>::Specialize(*vals[i]); valI != nullptr) {
-                    vals[i] = Multiply<Expression> { *(Add<Expression> { valI->GetMostSigOp(), Real { 1.0 } }.Simplify()), Imaginary {} }.Generalize();
-                    break;
-                }
-            }
-            if (i >= vals.size()) {
-                // check to make sure it is one thing only
-                vals.push_back(Multiply<Expression> { Real { 1.0 }, Imaginary {} }.Generalize());
-            }
-            continue;
-        }
-        // n*i
-        if (auto img = Multiply<Expression, Imaginary>::Specialize(*addend); img != nullptr) {
-            for (; i < vals.size(); i++) {
-                if (auto valI = Multiply<Expression, Imaginary>::Specialize(*vals[i]); valI != nullptr) {
-                    vals[i] = Multiply<Expression> { *(Add<Expression> { valI->GetMostSigOp(), img->GetMostSigOp() }.Simplify()), Imaginary {} }.Generalize();
-                    break;
-                }
-            }
-            if (i >= vals.size()) {
-                // check to make sure it is one thing only
-                vals.push_back(img->Generalize());
-            }
-            continue;
-        }
-        // single variable
-        if (auto var = Variable::Specialize(*addend); var != nullptr) {
-            for (; i < vals.size(); i++) {
-                if (auto valI = Multiply<Expression, Variable>::Specialize(*vals[i]); valI != nullptr) {
-                    if (valI->GetLeastSigOp().GetName() == var->GetName()) {
-                        vals[i] = Multiply<Expression> { *(Add<Expression> { valI->GetMostSigOp(), Real { 1.0 } }.Simplify()), *var }.Generalize();
-                        break;
-                    } else
-                        continue;
-                }
-            }
-            if (i >= vals.size()) {
-                // check to make sure it is one thing only
-                vals.push_back(Multiply<Expression> { Real { 1.0 }, *var }.Generalize());
-            }
-            continue;
-        }
-        // n*variable
-        if (auto var = Multiply<Expression, Variable>::Specialize(*addend); var != nullptr) {
-            for (; i < vals.size(); i++) {
-                if (auto valI = Multiply<Expression, Variable>::Specialize(*vals[i]); valI != nullptr) {
-                    // if (auto zeroCase = Multiply<Real, Expression>::Specialize(*valI); zeroCase != nullptr) {}
-                    if (valI->GetLeastSigOp().GetName() == var->GetLeastSigOp().GetName()) {
-                        vals[i] = Multiply<Expression> { *(Add<Expression> { valI->GetMostSigOp(), var->GetMostSigOp() }.Simplify()), valI->GetLeastSigOp() }.Generalize();
-                        break;
-                    } else
-                        continue;
-                }
-            }
-            if (i >= vals.size()) {
-                // check to make sure it is one thing only
-                vals.push_back(var->Generalize());
-            }
-            continue;
+
+    std::vector<std::unique_ptr<Expression>> vals;
+    std::vector<std::unique_ptr<Expression>> coefficients;
+    std::vector<std::unique_ptr<Expression>> terms;
+    std::unordered_map<const Expression*, std::size_t, ExpressionHash, ExpressionEqual> termIndices;
+    std::optional<std::size_t> constantIndex;
+
+    // A term that occurs once is kept as it is. Terms that are combined are rebuilt below.
+    const auto addLikeTerm = [&](const Expression& addend, const Expression& coefficient, const Expression& term) {
+        if (const auto it = termIndices.find(&term); it != termIndices.end()) {
+            coefficients[it->second] = Add<Expression> { *coefficients[it->second], coefficient }.Simplify();
+            vals[it->second] = nullptr;
+            return;
         }
-        // single exponent
-        if (auto exp = Exponent<Expression>::Specialize(*addend); exp != nullptr) {
-            for (; i < vals.size(); i++) {
-                if (auto valI = Multiply<Expression, Exponent<Expression>>::Specialize(*vals[i]); valI != nullptr) {
-                    if (valI->GetLeastSigOp().Equals(*exp)) {
-                        vals[i] = Multiply<Expression> { *(Add<Expression> { valI->GetMostSigOp(), Real { 1.0 } }.Simplify()), *exp }.Generalize();
-                        break;
-                    } else
-                        continue;
-                }
-            }
-            if (i >= vals.size()) {
-                // check to make sure it is one thing only
-                vals.push_back(Multiply<Expression> { Real { 1.0 }, *exp }.Generalize());
+
+        termIndices.emplace(terms.emplace_back(term.Generalize()).get(), vals.size());
+        coefficients.push_back(coefficient.Generalize());
+        vals.push_back(addend.Copy());
+    };
+
+    for (const auto& addend : adds) {
+        if (auto real = Match<Real>(*addend)) {
+            if (constantIndex) {
+                vals[*constantIndex] = Real { Match<Real>(*vals[*constantIndex])->GetValue() + real->GetValue() }.Generalize();
+            } else {
+                constantIndex = vals.size();
+                vals.push_back(real->Generalize());
+                coefficients.emplace_back(nullptr);
+                terms.emplace_back(nullptr);
             }
-            continue;
+        } else if (Match<Imaginary>(*addend)) {
+            addLikeTerm(*addend, Real { 1.0 }, Imaginary {});
+        } else if (auto img = Match<Multiply<Expression, Imaginary>>(*addend)) {
+            addLikeTerm(*addend, img->GetMostSigOp(), img->GetLeastSigOp());
+        } else if (auto var = Match<Variable>(*addend)) {
+            addLikeTerm(*addend, Real { 1.0 }, *var);
+        } else if (auto varTerm = Match<Multiply<Expression, Variable>>(*addend)) {
+            addLikeTerm(*addend, varTerm->GetMostSigOp(), varTerm->GetLeastSigOp());
+        } else if (auto exp = Match<Exponent<Expression>>(*addend)) {
+            addLikeTerm(*addend, Real { 1.0 }, *exp);
+        } else if (auto expTerm = Match<Multiply<Expression, Exponent<Expression>>>(*addend)) {
+            addLikeTerm(*addend, expTerm->GetMostSigOp(), expTerm->GetLeastSigOp());
+        } else {
+            // terms with no recognized coefficient are kept as they are
+            vals.push_back(addend->Copy());
+            coefficients.emplace_back(nullptr);
+            terms.emplace_back(nullptr);
         }
-        // n*exponent
-        if (auto exp = Multiply<Expression, Exponent<Expression>>::Specialize(*addend); exp != nullptr) {
-            for (; i < vals.size(); i++) {
-                if (auto valI = Multiply<Expression, Exponent<Expression>>::Specialize(*vals[i]); valI != nullptr) {
-                    if (valI->GetLeastSigOp().Equals(exp->GetLeastSigOp())) {
-                        vals[i] = Multiply<Expression> { *(Add<Expression> { valI->GetMostSigOp(), exp->GetMostSigOp() }.Simplify()), valI->GetLeastSigOp() }.Generalize();
-                        break;
-                    } else
-                        continue;
-                }
-            }
-            if (i >= vals.size()) {
-                // check to make sure it is one thing only
-                vals.push_back(exp->Generalize());
-            }
-            continue;
+    }
+
+    for (std::size_t i = 0; i < vals.size(); ++i) {
+        if (vals[i] == nullptr) {
+            vals[i] = Multiply<Expression> { *coefficients[i], *terms[i] }.Simplify();
         }
     }
+
     // rebuild equation after simplification.
 
     for (auto& val : vals) {
-        if (auto mul = Multiply<Real, Expression>::Specialize(*val); mul != nullptr) {
+        if (auto mul = Match<Multiply<Real, Expression>>(*val)) {
             if (mul->GetMostSigOp().GetValue() == 1.0) {
                 val = mul->GetLeastSigOp().Generalize();
             }
@@ -213,12 +157,12 @@ auto Add<Expression>::Simplify() const -> std::unique_ptr<Expression>
     // filter out zero-equivalent expressions
     std::vector<std::unique_ptr<Expression>> avals;
     for (auto& val : vals) {
-        if (auto real = Real::Specialize(*val); real != nullptr) {
+        if (auto real = Match<Real>(*val)) {
             if (std::abs(real->GetValue()) <= EPSILON) {
                 continue;
             }
         }
-        if (auto mul = Multiply<Real, Expression>::Specialize(*val); mul != nullptr) {
+        if (auto mul = Match<Multiply<Real, Expression>>(*val)) {
             if (std::abs(mul->GetMostSigOp().GetValue()) <= EPSILON) {
                 continue;
             }
@@ -227,65 +171,20 @@ auto Add<Expression>::Simplify() const -> std::unique_ptr<Expression>
     }
 
     if (auto vec = BuildFromVector<Add>(avals); vec != nullptr) {
-        return vec;
-    }
-
-    return simplifiedAdd.Copy();
-}
-
-auto Add<Expression>::Simplify(tf::Subflow& subflow) const -> std::unique_ptr<Expression>
-{
-    std::unique_ptr<Expression> simplifiedAugend, simplifiedAddend;
-
-    tf::Task leftSimplifyTask = subflow.emplace([this, &simplifiedAugend](tf::Subflow& sbf) {
-        if (!mostSigOp) {
-            return;
-        }
-
-        simplifiedAugend = mostSigOp->Simplify(sbf);
-    });
-
-    tf::Task rightSimplifyTask = subflow.emplace([this, &simplifiedAddend](tf::Subflow& sbf) {
-        if (!leastSigOp) {
-            return;
-        }
-
-        simplifiedAddend = leastSigOp->Simplify(sbf);
-    });
-
-    Add simplifiedAdd;
-
-    // While this task isn't actually parallelized, it exists as a prerequisite for check possible cases in parallel
-    tf::Task simplifyTask = subflow.emplace([&simplifiedAdd, &simplifiedAugend, &simplifiedAddend](tf::Subflow&) {
-        if (simplifiedAugend) {
-            simplifiedAdd.SetMostSigOp(*simplifiedAugend);
-        }
-
-        if (simplifiedAddend) {
-            simplifiedAdd.SetLeastSigOp(*simplifiedAddend);
+        // an unchanged sum keeps its simplified operands
+        if (vec->Identical(simplifiedAdd)) {
+            return simplifiedAdd.Copy();
         }
-    });
-
-    simplifyTask.succeed(leftSimplifyTask, rightSimplifyTask);
-
-    std::unique_ptr<Add<Real>> realCase;
-
-    tf::Task realCaseTask = subflow.emplace([&simplifiedAdd, &realCase](tf::Subflow& sbf) {
-        realCase = Add<Real>::Specialize(simplifiedAdd, sbf);
-    });
 
-    simplifyTask.precede(realCaseTask);
-
-    subflow.join();
-
-    if (realCase) {
-        const Real& firstReal = realCase->GetMostSigOp();
-        const Real& secondReal = realCase->GetLeastSigOp();
+        return vec;
+    }
 
-        return std::make_unique<Real>(firstReal.GetValue() + secondReal.GetValue());
+    // at most one term is left after cancelling the others
+    if (avals.size() == 1) {
+        return std::move(avals.front());
     }
 
-    return simplifiedAdd.Copy();
+    return std::make_unique<Real>(0.0);
 }
 
 auto Add<Expression>::Specialize(const Expression& other) -> std::unique_ptr<Add<Expression, Expression>>
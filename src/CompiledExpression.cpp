@@ -0,0 +1,954 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "taskflow/taskflow.hpp"
+
+#include "Oasis/CompiledExpression.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Runtime.hpp"
+#include "Oasis/Variable.hpp"
+
+namespace Oasis {
+
+namespace {
+
+    using OpCode = CompiledExpression::OpCode;
+    using Instruction = CompiledExpression::Instruction;
+
+    auto Apply(OpCode opCode, double lhs, double rhs) -> double
+    {
+        switch (opCode) {
+        case OpCode::Add:
+            return lhs + rhs;
+        case OpCode::Subtract:
+            return lhs - rhs;
+        case OpCode::Multiply:
+            return lhs * rhs;
+        case OpCode::Divide:
+            return lhs / rhs;
+        case OpCode::Exponent:
+            return std::pow(lhs, rhs);
+        case OpCode::Log:
+            return std::log(rhs) / std::log(lhs);
+        default:
+            return std::nan("");
+        }
+    }
+
+    class Compiler {
+    public:
+        Compiler(std::vector<Instruction>& instructions, std::vector<double>& constants, std::vector<std::string>& variables)
+            : instructions(instructions)
+            , constants(constants)
+            , variables(variables)
+        {
+            for (std::size_t i = 0; i < variables.size(); ++i) {
+                slots.try_emplace(variables[i], static_cast<std::uint32_t>(i));
+            }
+        }
+
+        // Counts the occurrences of each subexpression. Occurrences inside a repeated
+        // subexpression are not counted again, since they are only compiled once.
+        auto Count(const Expression& expression) -> void
+        {
+            if (expression.GetChild(0) == nullptr || ++repeats[&expression].count > 1) {
+                return;
+            }
+
+            for (std::size_t i = 0; const Expression* child = expression.GetChild(i); ++i) {
+                Count(*child);
+            }
+        }
+
+        // Compiles an expression. The first occurrence of a repeated subexpression stores its
+        // value to a temporary, and later occurrences load it.
+        auto Compile(const Expression& expression) -> void
+        {
+            const auto it = expression.GetChild(0) != nullptr ? repeats.find(&expression) : repeats.end();
+
+            if (it == repeats.end() || it->second.count < 2) {
+                return CompileNode(expression);
+            }
+
+            Repeat& repeat = it->second;
+
+            if (repeat.temporary) {
+                return Push({ OpCode::Load, *repeat.temporary });
+            }
+
+            if (repeat.constant) {
+                return EmitConstant(*repeat.constant);
+            }
+
+            CompileNode(expression);
+
+            if (IsConstant(instructions.size() - 1)) {
+                repeat.constant = constants[instructions.back().operand];
+                return;
+            }
+
+            repeat.temporary = static_cast<std::uint32_t>(temporaryCount++);
+            instructions.push_back({ OpCode::Store, *repeat.temporary });
+        }
+
+        [[nodiscard]] auto GetTemporaryCount() const -> std::size_t
+        {
+            return temporaryCount;
+        }
+
+        [[nodiscard]] auto GetStackSize() const -> std::size_t
+        {
+            return maxDepth;
+        }
+
+    private:
+        struct Repeat {
+            std::size_t count = 0;
+            std::optional<std::uint32_t> temporary;
+            std::optional<double> constant;
+        };
+
+        auto CompileNode(const Expression& expression) -> void
+        {
+            switch (expression.GetType()) {
+            case ExpressionType::Real:
+                EmitConstant(static_cast<const Real&>(expression).GetValue());
+                return;
+            case ExpressionType::Variable:
+                EmitVariable(static_cast<const Variable&>(expression).GetName());
+                return;
+            case ExpressionType::Add:
+                return CompileBinary(expression, OpCode::Add);
+            case ExpressionType::Subtract:
+                return CompileBinary(expression, OpCode::Subtract);
+            case ExpressionType::Multiply:
+                return CompileBinary(expression, OpCode::Multiply);
+            case ExpressionType::Divide:
+                return CompileBinary(expression, OpCode::Divide);
+            case ExpressionType::Exponent:
+                return CompileBinary(expression, OpCode::Exponent);
+            case ExpressionType::Log:
+                return CompileBinary(expression, OpCode::Log);
+            case ExpressionType::Negate:
+                return CompileNegate(expression);
+            default:
+                throw std::invalid_argument("Expression cannot be evaluated numerically.");
+            }
+        }
+
+        auto CompileBinary(const Expression& expression, OpCode opCode) -> void
+        {
+            const Expression* mostSigOp = expression.GetChild(0);
+            const Expression* leastSigOp = expression.GetChild(1);
+
+            if (mostSigOp == nullptr || leastSigOp == nullptr) {
+                throw std::invalid_argument("Expression cannot be evaluated numerically.");
+            }
+
+            Compile(*mostSigOp);
+            Compile(*leastSigOp);
+
+            // Both operands are constants, so fold them.
+            if (const std::size_t size = instructions.size(); IsConstant(size - 1) && IsConstant(size - 2)) {
+                const double lhs = constants[instructions[size - 2].operand];
+                const double rhs = constants[instructions[size - 1].operand];
+                Pop(2);
+                EmitConstant(Apply(opCode, lhs, rhs));
+                return;
+            }
+
+            instructions.push_back({ opCode, 0 });
+            --depth;
+        }
+
+        auto CompileNegate(const Expression& expression) -> void
+        {
+            const Expression* operand = expression.GetChild(0);
+
+            if (operand == nullptr) {
+                throw std::invalid_argument("Expression cannot be evaluated numerically.");
+            }
+
+            Compile(*operand);
+
+            if (IsConstant(instructions.size() - 1)) {
+                const double value = constants[instructions.back().operand];
+                Pop(1);
+                EmitConstant(-value);
+                return;
+            }
+
+            instructions.push_back({ OpCode::Negate, 0 });
+        }
+
+        auto EmitConstant(double value) -> void
+        {
+            constants.push_back(value);
+            Push({ OpCode::Constant, static_cast<std::uint32_t>(constants.size() - 1) });
+        }
+
+        auto EmitVariable(const std::string& name) -> void
+        {
+            const auto [it, inserted] = slots.try_emplace(name, static_cast<std::uint32_t>(variables.size()));
+
+            if (inserted) {
+                variables.push_back(name);
+            }
+
+            Push({ OpCode::Variable, it->second });
+        }
+
+        auto Push(Instruction instruction) -> void
+        {
+            instructions.push_back(instruction);
+            maxDepth = std::max(maxDepth, ++depth);
+        }
+
+        // Removes trailing constants, which are always the most recently added ones.
+        auto Pop(std::size_t count) -> void
+        {
+            instructions.resize(instructions.size() - count);
+            constants.resize(constants.size() - count);
+            depth -= count;
+        }
+
+        [[nodiscard]] auto IsConstant(std::size_t index) const -> bool
+        {
+            return index < instructions.size() && instructions[index].opCode == OpCode::Constant;
+        }
+
+        std::vector<Instruction>& instructions;
+        std::vector<double>& constants;
+        std::vector<std::string>& variables;
+        std::unordered_map<std::string, std::uint32_t> slots;
+        std::unordered_map<const Expression*, Repeat, ExpressionHash, ExpressionIdentical> repeats;
+        std::size_t temporaryCount = 0;
+        std::size_t depth = 0;
+        std::size_t maxDepth = 0;
+    };
+
+    // The number of points each instruction is applied to at once. Large enough to amortize
+    // dispatching on the opcode, small enough for a block per stack entry to stay in L1.
+    constexpr std::size_t BlockSize = 256;
+
+    // A stack entry of the block evaluator. Constants are kept as a single value instead of being
+    // broadcast to a whole block.
+    struct BlockOperand {
+        const double* values;
+        bool uniform;
+    };
+
+// Applies `expression`, in terms of `a` and `b`, to each point of a block. Constants are always
+// folded at compile time, so at most one operand is uniform.
+#define OASIS_MAP_BLOCK(expression)                                  \
+    if (!lhs.uniform && !rhs.uniform) {                              \
+        for (std::size_t i = 0; i < count; ++i) {                    \
+            [[maybe_unused]] const double a = lhs.values[i];         \
+            [[maybe_unused]] const double b = rhs.values[i];         \
+            out[i] = (expression);                                   \
+        }                                                            \
+    } else if (!lhs.uniform) {                                       \
+        [[maybe_unused]] const double b = *rhs.values;               \
+        for (std::size_t i = 0; i < count; ++i) {                    \
+            [[maybe_unused]] const double a = lhs.values[i];         \
+            out[i] = (expression);                                   \
+        }                                                            \
+    } else {                                                         \
+        [[maybe_unused]] const double a = *lhs.values;               \
+        for (std::size_t i = 0; i < count; ++i) {                    \
+            [[maybe_unused]] const double b = rhs.values[i];         \
+            out[i] = (expression);                                   \
+        }                                                            \
+    }
+
+#if defined(__x86_64__) && defined(__linux__) && defined(__GNUC__)
+#define OASIS_TARGET_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define OASIS_TARGET_CLONES
+#endif
+
+    // Evaluates a block of `count` points starting at `offset`. Each stack entry that holds an
+    // intermediate result writes it to its own block of `scratch`, and each temporary is copied to
+    // its own block of `stores` so that later stack entries do not overwrite it.
+    OASIS_TARGET_CLONES
+    auto EvaluateBlock(std::span<const Instruction> instructions, std::span<const double> constants, std::span<const std::span<const double>> columns,
+        std::size_t offset, std::size_t count, double* scratch, BlockOperand* stack, double* stores, BlockOperand* temporaries) -> BlockOperand
+    {
+        std::size_t size = 0;
+
+        for (const Instruction& instruction : instructions) {
+            if (instruction.opCode == OpCode::Constant) {
+                stack[size++] = { &constants[instruction.operand], true };
+                continue;
+            }
+
+            if (instruction.opCode == OpCode::Load) {
+                stack[size++] = temporaries[instruction.operand];
+                continue;
+            }
+
+            if (instruction.opCode == OpCode::Store) {
+                const BlockOperand operand = stack[size - 1];
+                double* const out = stores + instruction.operand * BlockSize;
+
+                if (operand.uniform) {
+                    temporaries[instruction.operand] = operand;
+                } else {
+                    std::copy_n(operand.values, count, out);
+                    temporaries[instruction.operand] = { out, false };
+                }
+
+                continue;
+            }
+
+            if (instruction.opCode == OpCode::Variable) {
+                stack[size++] = { columns[instruction.operand].data() + offset, false };
+                continue;
+            }
+
+            if (instruction.opCode == OpCode::Negate) {
+                const BlockOperand operand = stack[size - 1];
+                double* const out = scratch + (size - 1) * BlockSize;
+
+                for (std::size_t i = 0; i < count; ++i) {
+                    out[i] = -operand.values[i];
+                }
+
+                stack[size - 1] = { out, false };
+                continue;
+            }
+
+            const BlockOperand rhs = stack[--size];
+            const BlockOperand lhs = stack[size - 1];
+            double* const out = scratch + (size - 1) * BlockSize;
+
+            switch (instruction.opCode) {
+            case OpCode::Add:
+                OASIS_MAP_BLOCK(a + b)
+                break;
+            case OpCode::Subtract:
+                OASIS_MAP_BLOCK(a - b)
+                break;
+            case OpCode::Multiply:
+                OASIS_MAP_BLOCK(a * b)
+                break;
+            case OpCode::Divide:
+                OASIS_MAP_BLOCK(a / b)
+                break;
+            case OpCode::Exponent:
+                // Only powers for which pow is exact are special cased, so that the results match
+                // Evaluate bit for bit. Squares, cubes, square roots and reciprocals would be
+                // cheaper, but round differently from pow and disagree with it on values such as
+                // -0 and -inf.
+                if (rhs.uniform && *rhs.values == 0.0) {
+                    OASIS_MAP_BLOCK(1.0)
+                } else if (rhs.uniform && *rhs.values == 1.0) {
+                    OASIS_MAP_BLOCK(a)
+                } else {
+                    OASIS_MAP_BLOCK(std::pow(a, b))
+                }
+                break;
+            case OpCode::Log:
+                if (lhs.uniform) {
+                    // Hoisting the logarithm of the base does not change the rounding of the quotient.
+                    const double logBase = std::log(*lhs.values);
+                    OASIS_MAP_BLOCK(std::log(b) / logBase)
+                } else {
+                    OASIS_MAP_BLOCK(std::log(b) / std::log(a))
+                }
+                break;
+            default:
+                break;
+            }
+
+            stack[size - 1] = { out, false };
+        }
+
+        return stack[0];
+    }
+
+#undef OASIS_TARGET_CLONES
+#undef OASIS_MAP_BLOCK
+
+    // The number of grid points per task. The results of a chunk fill about half of a typical L2.
+    constexpr std::size_t ChunkSize = 64 * BlockSize;
+
+    // Per-thread buffers of the block evaluator, grown as needed and reused across calls.
+    struct BlockWorkspace {
+        std::vector<double> scratch;
+        std::vector<BlockOperand> stack;
+        std::vector<double> stores;
+        std::vector<BlockOperand> temporaries;
+        std::vector<double> coordinates;
+        std::vector<std::span<const double>> columns;
+        std::vector<std::size_t> index;
+    };
+
+    auto GetWorkspace(std::size_t stackSize, std::size_t temporaryCount, std::size_t axes) -> BlockWorkspace&
+    {
+        thread_local BlockWorkspace workspace;
+
+        if (workspace.stack.size() < stackSize) {
+            workspace.scratch.resize(stackSize * BlockSize);
+            workspace.stack.resize(stackSize);
+        }
+
+        if (workspace.temporaries.size() < temporaryCount) {
+            workspace.stores.resize(temporaryCount * BlockSize);
+            workspace.temporaries.resize(temporaryCount);
+        }
+
+        if (workspace.columns.size() < axes) {
+            workspace.coordinates.resize(axes * BlockSize);
+            workspace.columns.resize(axes);
+            workspace.index.resize(axes);
+
+            for (std::size_t axis = 0; axis < axes; ++axis) {
+                workspace.columns[axis] = { workspace.coordinates.data() + axis * BlockSize, BlockSize };
+            }
+        }
+
+        return workspace;
+    }
+
+    auto CountPoints(std::span<const CompiledExpression::Axis> axes, std::size_t variables) -> std::size_t
+    {
+        if (axes.size() < variables) {
+            throw std::invalid_argument("Grid has fewer axes than the expression has variables.");
+        }
+
+        std::size_t points = 1;
+
+        for (const CompiledExpression::Axis& axis : axes) {
+            points *= axis.count;
+        }
+
+        return points;
+    }
+
+    // Evaluates the grid points in [begin, end) block by block, passing each block of values to
+    // `consume` along with the index of its first point.
+    template <typename ConsumeT>
+    auto ForEachGridBlock(const CompiledExpression& compiled, std::span<const CompiledExpression::Axis> axes, std::size_t begin, std::size_t end, ConsumeT consume) -> void
+    {
+        BlockWorkspace& workspace = GetWorkspace(compiled.GetStackSize(), compiled.GetTemporaryCount(), axes.size());
+        std::size_t* const index = workspace.index.data();
+
+        for (std::size_t axis = axes.size(), rest = begin; axis-- > 0;) {
+            index[axis] = rest % axes[axis].count;
+            rest /= axes[axis].count;
+        }
+
+        for (std::size_t offset = begin; offset < end; offset += BlockSize) {
+            const std::size_t count = std::min(BlockSize, end - offset);
+
+            for (std::size_t i = 0; i < count; ++i) {
+                for (std::size_t axis = 0; axis < axes.size(); ++axis) {
+                    workspace.coordinates[axis * BlockSize + i] = axes[axis].start + static_cast<double>(index[axis]) * axes[axis].step;
+                }
+
+                for (std::size_t axis = axes.size(); axis-- > 0;) {
+                    if (++index[axis] < axes[axis].count) {
+                        break;
+                    }
+
+                    index[axis] = 0;
+                }
+            }
+
+            consume(offset, count,
+                EvaluateBlock(compiled.GetInstructions(), compiled.GetConstants(), workspace.columns, 0, count, workspace.scratch.data(), workspace.stack.data(),
+                    workspace.stores.data(), workspace.temporaries.data()));
+        }
+    }
+
+} // namespace
+
+CompiledExpression::CompiledExpression(const Expression& expression, std::vector<std::string> variables)
+    : CompiledExpression(std::array { &expression }, std::move(variables))
+{
+}
+
+CompiledExpression::CompiledExpression(std::span<const Expression* const> expressions, std::vector<std::string> variables)
+    : variables(std::move(variables))
+{
+    if (expressions.empty()) {
+        throw std::invalid_argument("No expressions to compile.");
+    }
+
+    Compiler compiler { instructions, constants, this->variables };
+
+    for (const Expression* expression : expressions) {
+        compiler.Count(*expression);
+    }
+
+    for (const Expression* expression : expressions) {
+        compiler.Compile(*expression);
+        outputs.push_back(static_cast<std::uint32_t>(instructions.size() - 1));
+    }
+
+    stackSize = compiler.GetStackSize();
+    temporaryCount = compiler.GetTemporaryCount();
+}
+
+auto CompiledExpression::Evaluate(std::span<const double> values) const -> double
+{
+    return *Run(values);
+}
+
+auto CompiledExpression::Evaluate(std::span<const double> values, std::span<double> outputs) const -> void
+{
+    if (outputs.size() != this->outputs.size()) {
+        throw std::invalid_argument("Outputs do not have one element per expression.");
+    }
+
+    std::copy_n(Run(values), outputs.size(), outputs.begin());
+}
+
+auto CompiledExpression::Run(std::span<const double> values) const -> const double*
+{
+    thread_local std::vector<double> stack;
+    thread_local std::vector<double> temporaries;
+
+    if (stack.size() < stackSize) {
+        stack.resize(stackSize);
+    }
+
+    if (temporaries.size() < temporaryCount) {
+        temporaries.resize(temporaryCount);
+    }
+
+    double* const top = stack.data();
+    std::size_t size = 0;
+
+    for (const Instruction& instruction : instructions) {
+        switch (instruction.opCode) {
+        case OpCode::Constant:
+            top[size++] = constants[instruction.operand];
+            break;
+        case OpCode::Variable:
+            top[size++] = values[instruction.operand];
+            break;
+        case OpCode::Store:
+            temporaries[instruction.operand] = top[size - 1];
+            break;
+        case OpCode::Load:
+            top[size++] = temporaries[instruction.operand];
+            break;
+        case OpCode::Negate:
+            top[size - 1] = -top[size - 1];
+            break;
+        default:
+            --size;
+            top[size - 1] = Apply(instruction.opCode, top[size - 1], top[size]);
+            break;
+        }
+    }
+
+    return top;
+}
+
+auto CompiledExpression::EvaluateDual(std::span<const double> values, std::span<const double> tangent) const -> Dual
+{
+    Dual dual {};
+    dual.value = EvaluateDual(values, tangent.first(variables.size()), { &dual.derivative, 1 });
+    return dual;
+}
+
+auto CompiledExpression::EvaluateDual(std::span<const double> values, std::span<const double> tangents, std::span<double> derivatives) const -> double
+{
+    thread_local std::vector<double> stack;
+    thread_local std::vector<double> tangentStack;
+    thread_local std::vector<double> temporaries;
+    thread_local std::vector<double> temporaryTangents;
+
+    const std::size_t directions = derivatives.size();
+    const std::size_t slots = variables.size();
+
+    if (stack.size() < stackSize) {
+        stack.resize(stackSize);
+    }
+
+    if (tangentStack.size() < stackSize * directions) {
+        tangentStack.resize(stackSize * directions);
+    }
+
+    if (temporaries.size() < temporaryCount) {
+        temporaries.resize(temporaryCount);
+    }
+
+    if (temporaryTangents.size() < temporaryCount * directions) {
+        temporaryTangents.resize(temporaryCount * directions);
+    }
+
+    double* const top = stack.data();
+    std::size_t size = 0;
+
+    // The tangents of stack entry `i`, one per direction.
+    const auto tangentsOf = [&](std::size_t i) { return tangentStack.data() + i * directions; };
+
+    for (const Instruction& instruction : instructions) {
+        switch (instruction.opCode) {
+        case OpCode::Constant:
+            top[size] = constants[instruction.operand];
+            std::fill_n(tangentsOf(size), directions, 0.0);
+            ++size;
+            continue;
+        case OpCode::Variable:
+            top[size] = values[instruction.operand];
+
+            for (std::size_t d = 0; d < directions; ++d) {
+                tangentsOf(size)[d] = tangents[d * slots + instruction.operand];
+            }
+
+            ++size;
+            continue;
+        case OpCode::Store:
+            temporaries[instruction.operand] = top[size - 1];
+            std::copy_n(tangentsOf(size - 1), directions, temporaryTangents.data() + instruction.operand * directions);
+            continue;
+        case OpCode::Load:
+            top[size] = temporaries[instruction.operand];
+            std::copy_n(temporaryTangents.data() + instruction.operand * directions, directions, tangentsOf(size));
+            ++size;
+            continue;
+        case OpCode::Negate:
+            top[size - 1] = -top[size - 1];
+
+            for (std::size_t d = 0; d < directions; ++d) {
+                tangentsOf(size - 1)[d] = -tangentsOf(size - 1)[d];
+            }
+
+            continue;
+        default:
+            break;
+        }
+
+        --size;
+        const double a = top[size - 1];
+        const double b = top[size];
+        const double value = Apply(instruction.opCode, a, b);
+        double* const ta = tangentsOf(size - 1);
+        const double* const tb = tangentsOf(size);
+
+        switch (instruction.opCode) {
+        case OpCode::Add:
+            for (std::size_t d = 0; d < directions; ++d) {
+                ta[d] += tb[d];
+            }
+            break;
+        case OpCode::Subtract:
+            for (std::size_t d = 0; d < directions; ++d) {
+                ta[d] -= tb[d];
+            }
+            break;
+        case OpCode::Multiply:
+            for (std::size_t d = 0; d < directions; ++d) {
+                ta[d] = ta[d] * b + a * tb[d];
+            }
+            break;
+        case OpCode::Divide:
+            for (std::size_t d = 0; d < directions; ++d) {
+                ta[d] = (ta[d] - value * tb[d]) / b;
+            }
+            break;
+        case OpCode::Exponent: {
+            // The power rule, plus the exponential rule only where the exponent varies, so that
+            // constant powers of non-positive bases do not pick up a NaN from log(a).
+            const double power = b * std::pow(a, b - 1.0);
+
+            for (std::size_t d = 0; d < directions; ++d) {
+                ta[d] = power * ta[d] + (tb[d] != 0.0 ? value * std::log(a) * tb[d] : 0.0);
+            }
+            break;
+        }
+        case OpCode::Log: {
+            // Likewise, the base only contributes where it varies.
+            const double scale = 1.0 / std::log(a);
+
+            for (std::size_t d = 0; d < directions; ++d) {
+                ta[d] = (tb[d] / b - (ta[d] != 0.0 ? value * ta[d] / a : 0.0)) * scale;
+            }
+            break;
+        }
+        default:
+            break;
+        }
+
+        top[size - 1] = value;
+    }
+
+    std::copy_n(tangentsOf(0), directions, derivatives.begin());
+    return top[0];
+}
+
+auto CompiledExpression::EvaluateGradient(std::span<const double> values, std::span<double> gradient) const -> double
+{
+    // One entry per instruction: its value, its adjoint, and the instructions of its operands.
+    struct TapeEntry {
+        double value;
+        double adjoint;
+        std::uint32_t lhs;
+        std::uint32_t rhs;
+    };
+
+    thread_local std::vector<TapeEntry> tape;
+    thread_local std::vector<std::uint32_t> stack;
+    thread_local std::vector<std::uint32_t> stores;
+
+    if (tape.size() < instructions.size()) {
+        tape.resize(instructions.size());
+    }
+
+    if (stack.size() < stackSize) {
+        stack.resize(stackSize);
+    }
+
+    if (stores.size() < temporaryCount) {
+        stores.resize(temporaryCount);
+    }
+
+    std::size_t size = 0;
+
+    for (std::size_t i = 0; i < instructions.size(); ++i) {
+        const Instruction& instruction = instructions[i];
+        TapeEntry& entry = tape[i];
+        entry.adjoint = 0.0;
+
+        switch (instruction.opCode) {
+        case OpCode::Constant:
+            entry.value = constants[instruction.operand];
+            break;
+        case OpCode::Variable:
+            entry.value = values[instruction.operand];
+            break;
+        case OpCode::Negate:
+            entry.lhs = stack[--size];
+            entry.value = -tape[entry.lhs].value;
+            break;
+        // Stores and loads pass their operand through, so their adjoints flow back to it.
+        case OpCode::Store:
+            entry.lhs = stack[--size];
+            entry.value = tape[entry.lhs].value;
+            stores[instruction.operand] = static_cast<std::uint32_t>(i);
+            break;
+        case OpCode::Load:
+            entry.lhs = stores[instruction.operand];
+            entry.value = tape[entry.lhs].value;
+            break;
+        default:
+            entry.rhs = stack[--size];
+            entry.lhs = stack[--size];
+            entry.value = Apply(instruction.opCode, tape[entry.lhs].value, tape[entry.rhs].value);
+            break;
+        }
+
+        stack[size++] = static_cast<std::uint32_t>(i);
+    }
+
+    std::fill_n(gradient.begin(), variables.size(), 0.0);
+    tape[outputs.front()].adjoint = 1.0;
+
+    for (std::size_t i = instructions.size(); i-- > 0;) {
+        const Instruction& instruction = instructions[i];
+        const TapeEntry& entry = tape[i];
+        const double adjoint = entry.adjoint;
+
+        switch (instruction.opCode) {
+        case OpCode::Constant:
+            break;
+        case OpCode::Variable:
+            gradient[instruction.operand] += adjoint;
+            break;
+        case OpCode::Negate:
+            tape[entry.lhs].adjoint -= adjoint;
+            break;
+        case OpCode::Store:
+        case OpCode::Load:
+            tape[entry.lhs].adjoint += adjoint;
+            break;
+        case OpCode::Add:
+            tape[entry.lhs].adjoint += adjoint;
+            tape[entry.rhs].adjoint += adjoint;
+            break;
+        case OpCode::Subtract:
+            tape[entry.lhs].adjoint += adjoint;
+            tape[entry.rhs].adjoint -= adjoint;
+            break;
+        case OpCode::Multiply:
+            tape[entry.lhs].adjoint += adjoint * tape[entry.rhs].value;
+            tape[entry.rhs].adjoint += adjoint * tape[entry.lhs].value;
+            break;
+        case OpCode::Divide:
+            tape[entry.lhs].adjoint += adjoint / tape[entry.rhs].value;
+            tape[entry.rhs].adjoint -= adjoint * entry.value / tape[entry.rhs].value;
+            break;
+        case OpCode::Exponent: {
+            const double a = tape[entry.lhs].value;
+            const double b = tape[entry.rhs].value;
+            tape[entry.lhs].adjoint += adjoint * b * std::pow(a, b - 1.0);
+
+            // As in forward mode, constant exponents skip log(a), which is NaN for a <= 0.
+            if (instructions[entry.rhs].opCode != OpCode::Constant) {
+                tape[entry.rhs].adjoint += adjoint * entry.value * std::log(a);
+            }
+            break;
+        }
+        case OpCode::Log: {
+            const double a = tape[entry.lhs].value;
+            const double b = tape[entry.rhs].value;
+            const double logA = std::log(a);
+            tape[entry.rhs].adjoint += adjoint / (b * logA);
+
+            if (instructions[entry.lhs].opCode != OpCode::Constant) {
+                tape[entry.lhs].adjoint -= adjoint * entry.value / (a * logA);
+            }
+            break;
+        }
+        }
+    }
+
+    return tape[outputs.front()].value;
+}
+
+auto CompiledExpression::EvaluateMany(std::span<const std::span<const double>> columns, std::span<double> results) const -> void
+{
+    BlockWorkspace& workspace = GetWorkspace(stackSize, temporaryCount, 0);
+
+    for (std::size_t offset = 0; offset < results.size(); offset += BlockSize) {
+        const std::size_t count = std::min(BlockSize, results.size() - offset);
+        const BlockOperand result = EvaluateBlock(instructions, constants, columns, offset, count, workspace.scratch.data(), workspace.stack.data(),
+            workspace.stores.data(), workspace.temporaries.data());
+
+        if (result.uniform) {
+            std::fill_n(results.begin() + offset, count, *result.values);
+        } else {
+            std::copy_n(result.values, count, results.begin() + offset);
+        }
+    }
+}
+
+auto CompiledExpression::EvaluateGrid(std::span<const Axis> axes, std::span<double> results) const -> void
+{
+    EvaluateGrid(axes, results, Runtime::Current());
+}
+
+auto CompiledExpression::EvaluateGrid(std::span<const Axis> axes, std::span<double> results, Runtime& runtime) const -> void
+{
+    if (CountPoints(axes, variables.size()) != results.size()) {
+        throw std::invalid_argument("Results do not have one element per grid point.");
+    }
+
+    const std::size_t chunks = (results.size() + ChunkSize - 1) / ChunkSize;
+
+    tf::Taskflow taskflow;
+
+    taskflow.for_each_index(std::size_t { 0 }, chunks, std::size_t { 1 }, [this, axes, results](std::size_t chunk) {
+        const std::size_t begin = chunk * ChunkSize;
+        const std::size_t end = std::min(begin + ChunkSize, results.size());
+
+        ForEachGridBlock(*this, axes, begin, end, [results](std::size_t offset, std::size_t count, BlockOperand values) {
+            if (values.uniform) {
+                std::fill_n(results.begin() + offset, count, *values.values);
+            } else {
+                std::copy_n(values.values, count, results.begin() + offset);
+            }
+        });
+    });
+
+    runtime.GetExecutor().run(taskflow).wait();
+}
+
+auto CompiledExpression::ReduceGrid(std::span<const Axis> axes) const -> Reduction
+{
+    return ReduceGrid(axes, Runtime::Current());
+}
+
+auto CompiledExpression::ReduceGrid(std::span<const Axis> axes, Runtime& runtime) const -> Reduction
+{
+    static constexpr Reduction Identity { .sum = 0.0, .min = std::numeric_limits<double>::infinity(), .max = -std::numeric_limits<double>::infinity() };
+
+    const std::size_t points = CountPoints(axes, variables.size());
+    const std::size_t chunks = (points + ChunkSize - 1) / ChunkSize;
+
+    // Partial results are combined in chunk order, so the sum does not depend on scheduling.
+    std::vector<Reduction> partials(chunks, Identity);
+
+    tf::Taskflow taskflow;
+
+    taskflow.for_each_index(std::size_t { 0 }, chunks, std::size_t { 1 }, [this, axes, points, &partials](std::size_t chunk) {
+        const std::size_t begin = chunk * ChunkSize;
+        const std::size_t end = std::min(begin + ChunkSize, points);
+        Reduction partial = Identity;
+
+        ForEachGridBlock(*this, axes, begin, end, [&partial](std::size_t, std::size_t count, BlockOperand values) {
+            const std::size_t stride = values.uniform ? 0 : 1;
+
+            for (std::size_t i = 0; i < count; ++i) {
+                const double value = values.values[i * stride];
+                partial.sum += value;
+                partial.min = value < partial.min ? value : partial.min;
+                partial.max = value > partial.max ? value : partial.max;
+            }
+        });
+
+        partials[chunk] = partial;
+    });
+
+    runtime.GetExecutor().run(taskflow).wait();
+
+    Reduction reduction = Identity;
+
+    for (const Reduction& partial : partials) {
+        reduction.sum += partial.sum;
+        reduction.min = std::min(reduction.min, partial.min);
+        reduction.max = std::max(reduction.max, partial.max);
+    }
+
+    return reduction;
+}
+
+auto CompiledExpression::GetVariables() const -> const std::vector<std::string>&
+{
+    return variables;
+}
+
+auto CompiledExpression::GetSlot(const std::string& name) const -> std::optional<std::size_t>
+{
+    if (const auto it = std::ranges::find(variables, name); it != variables.end()) {
+        return static_cast<std::size_t>(it - variables.begin());
+    }
+
+    return std::nullopt;
+}
+
+auto CompiledExpression::GetInstructions() const -> std::span<const Instruction>
+{
+    return instructions;
+}
+
+auto CompiledExpression::GetConstants() const -> std::span<const double>
+{
+    return constants;
+}
+
+auto CompiledExpression::GetStackSize() const -> std::size_t
+{
+    return stackSize;
+}
+
+auto CompiledExpression::GetTemporaryCount() const -> std::size_t
+{
+    return temporaryCount;
+}
+
+auto CompiledExpression::GetOutputCount() const -> std::size_t
+{
+    return outputs.size();
+}
+
+} // Oasis
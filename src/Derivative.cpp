@@ -22,17 +22,18 @@ Derivative<Expression>::Derivative(const Expression& exp, const Expression& var)
 {
 }
 
-auto Derivative<Expression>::Simplify() const -> std::unique_ptr<Expression>
+auto Derivative<Expression>::SimplifyImpl() const -> std::unique_ptr<Expression>
 {
     auto simplifiedExpression = mostSigOp ? mostSigOp->Simplify() : nullptr;
     auto simplifiedVar = leastSigOp ? leastSigOp->Simplify() : nullptr;
-    return simplifiedExpression->Differentiate(*simplifiedVar);
-}
+    auto differentiated = simplifiedExpression->Differentiate(*simplifiedVar);
 
-std::unique_ptr<Expression> Derivative<Expression, Expression>::Simplify(tf::Subflow&) const
-{
-    // TODO: Actually implement
-    return Simplify();
+    // An expression with no matching rule differentiates to another Derivative, which is already simplified.
+    if (differentiated == nullptr || differentiated->Is<Oasis::Derivative>()) {
+        return differentiated;
+    }
+
+    return differentiated->Simplify();
 }
 
 std::unique_ptr<Expression> Derivative<Expression, Expression>::Differentiate(const Expression& differentiationVariable) const
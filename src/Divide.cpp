@@ -22,7 +22,7 @@ Divide<Expression>::Divide(const Expression& dividend, const Expression& divisor
 {
 }
 
-auto Divide<Expression>::Simplify() const -> std::unique_ptr<Expression>
+auto Divide<Expression>::SimplifyImpl() const -> std::unique_ptr<Expression>
 {
     auto simplifiedDividend = mostSigOp->Simplify(); // numerator
     auto simplifiedDivider = leastSigOp->Simplify(); // denominator
@@ -39,7 +39,7 @@ auto Divide<Expression>::Simplify() const -> std::unique_ptr<Expression>
         if (logCase->GetMostSigOp().GetMostSigOp().Equals(logCase->GetLeastSigOp().GetMostSigOp())) {
             const IExpression auto& base = logCase->GetLeastSigOp().GetLeastSigOp();
             const IExpression auto& argument = logCase->GetMostSigOp().GetLeastSigOp();
-            return std::make_unique<Log<Expression>>(base, argument);
+            return Log<Expression> { base, argument }.Simplify();
         }
     }
     // convert the terms in numerator and denominator into a vector to make manipulations easier
@@ -97,7 +97,7 @@ auto Divide<Expression>::Simplify() const -> std::unique_ptr<Expression>
             for (; i < result.size(); i++) {
                 if (auto resIexp = Exponent<Variable, Expression>::Specialize(*result[i]); resIexp != nullptr) {
                     if (resIexp->GetMostSigOp().Equals(*var)) {
-                        result[i] = Exponent<Expression> { *var, *(Subtract<Expression> { resIexp->GetLeastSigOp(), Real { 1.0 } }.Simplify()) }.Generalize();
+                        result[i] = Exponent<Expression> { *var, *(Subtract<Expression> { resIexp->GetLeastSigOp(), Real { 1.0 } }.Simplify()) }.Simplify();
                         break;
                     }
                 } else if (auto resI = Variable::Specialize(*result[i]); resI != nullptr) {
@@ -116,12 +116,12 @@ auto Divide<Expression>::Simplify() const -> std::unique_ptr<Expression>
             for (; i < result.size(); i++) {
                 if (auto resIexp = Exponent<Variable, Expression>::Specialize(*result[i]); resIexp != nullptr) {
                     if (resIexp->GetMostSigOp().Equals(var->GetMostSigOp())) {
-                        result[i] = Exponent<Expression> { var->GetMostSigOp(), *(Subtract<Expression> { resIexp->GetLeastSigOp(), var->GetLeastSigOp() }.Simplify()) }.Generalize();
+                        result[i] = Exponent<Expression> { var->GetMostSigOp(), *(Subtract<Expression> { resIexp->GetLeastSigOp(), var->GetLeastSigOp() }.Simplify()) }.Simplify();
                         break;
                     }
                 } else if (auto resI = Variable::Specialize(*result[i]); resI != nullptr) {
                     if (resI->Equals(*var)) {
-                        result[i] = Exponent<Expression> { var->GetMostSigOp(), *(Subtract<Expression> { Real { 1.0 }, var->GetLeastSigOp() }.Simplify()) }.Generalize();
+                        result[i] = Exponent<Expression> { var->GetMostSigOp(), *(Subtract<Expression> { Real { 1.0 }, var->GetLeastSigOp() }.Simplify()) }.Simplify();
                     }
                 }
             }
@@ -138,7 +138,7 @@ auto Divide<Expression>::Simplify() const -> std::unique_ptr<Expression>
                         break;
                     }
                 } else if (result[i]->Equals(expExpr->GetMostSigOp())) {
-                    result[i] = Exponent { expExpr->GetMostSigOp(), *(Subtract { Real { 1.0 }, resExpr->GetLeastSigOp() }.Simplify()) }.Simplify();
+                    result[i] = Exponent { expExpr->GetMostSigOp(), *(Subtract { Real { 1.0 }, expExpr->GetLeastSigOp() }.Simplify()) }.Simplify();
                     break;
                 }
             }
@@ -211,6 +211,9 @@ auto Divide<Expression>::Simplify() const -> std::unique_ptr<Expression>
     auto divisor = denominatorVals.size() == 1 ? std::move(denominatorVals.front()) : BuildFromVector<Multiply>(denominatorVals);
 
     // rebuild subtrees
+    if (!dividend && !divisor)
+        return Real { 1.0 }.Copy();
+
     if (!dividend && divisor)
         return Divide { Real { 1.0 }, *divisor }.Copy();
 
@@ -220,61 +223,6 @@ auto Divide<Expression>::Simplify() const -> std::unique_ptr<Expression>
     return Divide { *dividend, *divisor }.Copy();
 }
 
-auto Divide<Expression>::Simplify(tf::Subflow& subflow) const -> std::unique_ptr<Expression>
-{
-    std::unique_ptr<Expression> simplifiedDividend, simplifiedDivisor;
-
-    tf::Task leftSimplifyTask = subflow.emplace([this, &simplifiedDividend](tf::Subflow& sbf) {
-        if (!mostSigOp) {
-            return;
-        }
-
-        simplifiedDividend = mostSigOp->Simplify(sbf);
-    });
-
-    tf::Task rightSimplifyTask = subflow.emplace([this, &simplifiedDivisor](tf::Subflow& sbf) {
-        if (!leastSigOp) {
-            return;
-        }
-
-        simplifiedDivisor = leastSigOp->Simplify(sbf);
-    });
-
-    Divide simplifiedDivide;
-
-    // While this task isn't actually parallelized, it exists as a prerequisite for check possible cases in parallel
-    tf::Task simplifyTask = subflow.emplace([&simplifiedDivide, &simplifiedDividend, &simplifiedDivisor](tf::Subflow&) {
-        if (simplifiedDividend) {
-            simplifiedDivide.SetMostSigOp(*simplifiedDividend);
-        }
-
-        if (simplifiedDivisor) {
-            simplifiedDivide.SetLeastSigOp(*simplifiedDivisor);
-        }
-    });
-
-    simplifyTask.succeed(leftSimplifyTask, rightSimplifyTask);
-
-    std::unique_ptr<Divide<Real>> realCase;
-
-    tf::Task realCaseTask = subflow.emplace([&simplifiedDivide, &realCase](tf::Subflow& sbf) {
-        realCase = Divide<Real>::Specialize(simplifiedDivide, sbf);
-    });
-
-    simplifyTask.precede(realCaseTask);
-
-    subflow.join();
-
-    if (realCase) {
-        const Real& multiplicand = realCase->GetMostSigOp();
-        const Real& multiplier = realCase->GetLeastSigOp();
-
-        return std::make_unique<Real>(multiplicand.GetValue() / multiplier.GetValue());
-    }
-
-    return simplifiedDivide.Copy();
-}
-
 auto Divide<Expression>::Specialize(const Expression& other) -> std::unique_ptr<Divide<Expression, Expression>>
 {
     if (!other.Is<Oasis::Divide>()) {
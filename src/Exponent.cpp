@@ -21,7 +21,7 @@ Exponent<Expression>::Exponent(const Expression& base, const Expression& power)
 {
 }
 
-auto Exponent<Expression>::Simplify() const -> std::unique_ptr<Expression>
+auto Exponent<Expression>::SimplifyImpl() const -> std::unique_ptr<Expression>
 {
     auto simplifiedBase = mostSigOp->Simplify();
     auto simplifiedPower = leastSigOp->Simplify();
@@ -81,15 +81,17 @@ auto Exponent<Expression>::Simplify() const -> std::unique_ptr<Expression>
     if (auto ImgCase = Exponent<Multiply<Real, Expression>, Real>::Specialize(simplifiedExponent); ImgCase != nullptr) {
         if (ImgCase->GetMostSigOp().GetMostSigOp().GetValue() < 0 && ImgCase->GetLeastSigOp().GetValue() == 0.5) {
             return std::make_unique<Multiply<Expression>>(
-                Multiply<Expression> { Real { pow(std::abs(ImgCase->GetMostSigOp().GetMostSigOp().GetValue()), 0.5) },
-                    Exponent<Expression> { ImgCase->GetMostSigOp().GetLeastSigOp(), Real { 0.5 } } },
+                *(Multiply<Expression> { Real { pow(std::abs(ImgCase->GetMostSigOp().GetMostSigOp().GetValue()), 0.5) },
+                    *(Exponent<Expression> { ImgCase->GetMostSigOp().GetLeastSigOp(), Real { 0.5 } }.Simplify()) }
+                        .Simplify()),
                 Imaginary {});
         }
     }
 
     if (auto expExpCase = Exponent<Exponent<Expression, Expression>, Expression>::Specialize(simplifiedExponent); expExpCase != nullptr) {
-        return std::make_unique<Exponent<Expression>>(expExpCase->GetMostSigOp().GetMostSigOp(),
-            *(Multiply { expExpCase->GetMostSigOp().GetLeastSigOp(), expExpCase->GetLeastSigOp() }.Simplify()));
+        return Exponent<Expression> { expExpCase->GetMostSigOp().GetMostSigOp(),
+            *(Multiply { expExpCase->GetMostSigOp().GetLeastSigOp(), expExpCase->GetLeastSigOp() }.Simplify()) }
+            .Simplify();
     }
 
     // a^log[a](x) = x - maybe add domain stuff (should only be defined for x >= 0)
@@ -102,59 +104,6 @@ auto Exponent<Expression>::Simplify() const -> std::unique_ptr<Expression>
     return simplifiedExponent.Copy();
 }
 
-auto Exponent<Expression>::Simplify(tf::Subflow& subflow) const -> std::unique_ptr<Expression>
-{
-    std::unique_ptr<Expression> simplifiedBase, simplifiedPower;
-
-    tf::Task baseSimplifyTask = subflow.emplace([this, &simplifiedBase](tf::Subflow& sbf) {
-        if (!mostSigOp) {
-            return;
-        }
-        simplifiedBase = mostSigOp->Simplify(sbf);
-    });
-
-    tf::Task powerSimplifyTask = subflow.emplace([this, &simplifiedPower](tf::Subflow& sbf) {
-        if (!leastSigOp) {
-            return;
-        }
-
-        simplifiedPower = leastSigOp->Simplify(sbf);
-    });
-
-    Exponent simplifiedExponent;
-
-    tf::Task simplifyTask = subflow.emplace([&simplifiedExponent, &simplifiedBase, &simplifiedPower](tf::Subflow&) {
-        if (simplifiedPower) {
-            simplifiedExponent.SetMostSigOp(*simplifiedBase);
-        }
-
-        if (simplifiedPower) {
-            simplifiedExponent.SetLeastSigOp(*simplifiedPower);
-        }
-    });
-
-    simplifyTask.succeed(baseSimplifyTask, powerSimplifyTask);
-
-    std::unique_ptr<Exponent<Real>> realCase;
-
-    tf::Task realCaseTask = subflow.emplace([&simplifiedExponent, &realCase](tf::Subflow& sbf) {
-        realCase = Exponent<Real>::Specialize(simplifiedExponent, sbf);
-    });
-
-    simplifyTask.precede(realCaseTask);
-
-    subflow.join();
-
-    if (realCase) {
-        const Real& base = realCase->GetMostSigOp();
-        const Real& power = realCase->GetLeastSigOp();
-
-        return std::make_unique<Real>(pow(base.GetValue(), power.GetValue()));
-    }
-
-    return simplifiedExponent.Copy();
-}
-
 auto Exponent<Expression>::Specialize(const Oasis::Expression& other) -> std::unique_ptr<Exponent<Expression, Expression>>
 {
     if (!other.Is<Oasis::Exponent>()) {
@@ -217,6 +166,9 @@ auto Exponent<Expression>::Differentiate(const Expression& differentiationVariab
                 }
                     .Simplify();
             }
+
+            // A constant power of another variable is constant.
+            return Real { 0.0 }.Copy();
         }
     }
 
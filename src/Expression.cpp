@@ -1,7 +1,18 @@
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include "taskflow/taskflow.hpp"
 
 #include "Oasis/Expression.hpp"
+#include "Oasis/ExpressionArena.hpp"
+#include "Oasis/ExpressionStore.hpp"
+#include "Oasis/Imaginary.hpp"
 #include "Oasis/Integral.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Runtime.hpp"
+#include "Oasis/SimplifyCache.hpp"
 
 #include <Oasis/Add.hpp>
 #include <Oasis/Divide.hpp>
@@ -44,6 +55,21 @@ long long gcf(long long a, long long b)
 
 namespace Oasis {
 
+Expression::Expression(const Expression& other)
+    : cachedHash(other.cachedHash.load(std::memory_order_relaxed))
+    , cachedNodeCount(other.cachedNodeCount.load(std::memory_order_relaxed))
+    , simplified(other.simplified)
+{
+}
+
+auto Expression::operator=(const Expression& other) -> Expression&
+{
+    cachedHash.store(other.cachedHash.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    cachedNodeCount.store(other.cachedNodeCount.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    simplified = other.simplified;
+    return *this;
+}
+
 // currently only supports polynomials of one variable.
 /**
  * The FindZeros function finds all rational zeros of a polynomial. Currently assumes an expression of the form a+bx+cx^2+dx^3+... where a, b, c, d are a integers.
@@ -223,6 +249,12 @@ auto Expression::Differentiate(const Expression&) const -> std::unique_ptr<Expre
 {
     return Copy();
 }
+
+auto Expression::GetChild(std::size_t) const -> const Expression*
+{
+    return nullptr;
+}
+
 auto Expression::GetType() const -> ExpressionType
 {
     return ExpressionType::None;
@@ -262,19 +294,228 @@ auto Expression::IntegrateWithBounds(const Expression& variable, const Expressio
     return integral.Copy();
 }
 
+auto Expression::Hash() const -> std::size_t
+{
+    auto hash = cachedHash.load(std::memory_order_relaxed);
+
+    if (hash == 0) {
+        // Zero marks an uncomputed hash. Racing threads compute the same value, so storing it
+        // more than once is harmless.
+        hash = ComputeHash();
+        hash = hash == 0 ? 1 : hash;
+        cachedHash.store(hash, std::memory_order_relaxed);
+    }
+
+    return hash;
+}
+
+auto Expression::ComputeHash() const -> std::size_t
+{
+    return MixHash(static_cast<std::size_t>(GetType()));
+}
+
+auto Expression::NodeCount() const -> std::size_t
+{
+    auto count = cachedNodeCount.load(std::memory_order_relaxed);
+
+    if (count == 0) {
+        count = 1;
+
+        for (std::size_t i = 0; const Expression* child = GetChild(i); ++i) {
+            count += child->NodeCount();
+        }
+
+        cachedNodeCount.store(count, std::memory_order_relaxed);
+    }
+
+    return count;
+}
+
+auto Expression::Identical(const Expression& other) const -> bool
+{
+    std::vector<std::pair<const Expression*, const Expression*>> stack { { this, &other } };
+
+    while (!stack.empty()) {
+        const auto [lhs, rhs] = stack.back();
+        stack.pop_back();
+
+        if (lhs == rhs) {
+            continue;
+        }
+
+        if (lhs->GetType() != rhs->GetType() || lhs->Hash() != rhs->Hash()) {
+            return false;
+        }
+
+        // No expression has more than two operands, and an operand may be missing.
+        const Expression* lhsChildren[] = { lhs->GetChild(0), lhs->GetChild(1) };
+        const Expression* rhsChildren[] = { rhs->GetChild(0), rhs->GetChild(1) };
+
+        if (lhsChildren[0] == nullptr && lhsChildren[1] == nullptr && rhsChildren[0] == nullptr && rhsChildren[1] == nullptr) {
+            // Leaves have no operands to reorder, so equality is identity.
+            if (!lhs->Equals(*rhs)) {
+                return false;
+            }
+
+            continue;
+        }
+
+        for (std::size_t i = 0; i < 2; ++i) {
+            if ((lhsChildren[i] == nullptr) != (rhsChildren[i] == nullptr)) {
+                return false;
+            }
+
+            if (lhsChildren[i] != nullptr) {
+                stack.emplace_back(lhsChildren[i], rhsChildren[i]);
+            }
+        }
+    }
+
+    return true;
+}
+
+auto Expression::IsSimplified() const -> bool
+{
+    return simplified;
+}
+
+auto Expression::Invalidate() -> void
+{
+    cachedHash.store(0, std::memory_order_relaxed);
+    cachedNodeCount.store(0, std::memory_order_relaxed);
+    simplified = false;
+}
+
+auto Expression::Intern(ExpressionStore& store) const -> std::shared_ptr<const Expression>
+{
+    // Interned nodes are kept alive by their store, which may outlive the active arena.
+    const bool suspended = ExpressionArena::Suspend();
+    auto interned = InternLeaf(store);
+    ExpressionArena::Resume(suspended);
+
+    return interned;
+}
+
+auto Expression::InternLeaf(ExpressionStore& store) const -> std::shared_ptr<const Expression>
+{
+    ExpressionStore::Key key { .type = GetType() };
+
+    if (auto real = Real::Specialize(*this); real != nullptr) {
+        key.value = real->GetValue();
+    } else if (auto variable = Variable::Specialize(*this); variable != nullptr) {
+        key.name = variable->GetName();
+    } else if (!Is<Imaginary>()) {
+        // Leaves such as Undefined and Matrix are not deduplicated.
+        return Copy();
+    }
+
+    if (auto existing = store.Find(key); existing != nullptr) {
+        return existing;
+    }
+
+    return store.Insert(key, Copy());
+}
+
 auto Expression::Simplify() const -> std::unique_ptr<Expression>
 {
-    return Copy();
+    if (simplified) {
+        return Copy();
+    }
+
+    const SimplifyCache::Scope scope;
+    const std::shared_ptr<SimplifyCache> cache = GetChild(0) != nullptr ? SimplifyCache::Active() : nullptr;
+
+    if (cache != nullptr) {
+        if (auto cached = cache->Find(*this); cached != nullptr) {
+            cached->simplified = true;
+            return cached;
+        }
+    }
+
+    auto result = SimplifyImpl();
+
+    result = Settle(std::move(result));
+
+    if (result != nullptr && result->simplified && cache != nullptr) {
+        cache->Insert(*this, *result);
+    }
+
+    return result;
 }
 
 auto Expression::Simplify(tf::Subflow& subflow) const -> std::unique_ptr<Expression>
+{
+    if (simplified) {
+        return Copy();
+    }
+
+    // Below the cutoff, spawning tasks costs more than it saves.
+    if (NodeCount() < Runtime::GetSequentialCutoff()) {
+        return Simplify();
+    }
+
+    const SimplifyCache::Scope scope;
+    const std::shared_ptr<SimplifyCache> cache = GetChild(0) != nullptr ? SimplifyCache::Active() : nullptr;
+
+    if (cache != nullptr) {
+        if (auto cached = cache->Find(*this); cached != nullptr) {
+            cached->simplified = true;
+            return cached;
+        }
+    }
+
+    auto result = SimplifyImpl(subflow);
+
+    result = Settle(std::move(result));
+
+    if (result != nullptr && result->simplified && cache != nullptr) {
+        cache->Insert(*this, *result);
+    }
+
+    return result;
+}
+
+auto Expression::Settle(std::unique_ptr<Expression> result) -> std::unique_ptr<Expression>
+{
+    // Rules rebuild unchanged expressions from their marked operands, so checking a result usually
+    // only applies the rules at its root again.
+    constexpr int maxPasses = 4;
+
+    for (int pass = 0; pass < maxPasses && result != nullptr && !result->simplified; ++pass) {
+        auto again = result->SimplifyImpl();
+
+        if (again != nullptr && again->Identical(*result)) {
+            again->simplified = true;
+        }
+
+        result = std::move(again);
+    }
+
+    return result;
+}
+
+auto Expression::SimplifyImpl() const -> std::unique_ptr<Expression>
+{
+    return Copy();
+}
+
+auto Expression::SimplifyImpl(tf::Subflow& subflow) const -> std::unique_ptr<Expression>
 {
     return Copy(subflow);
 }
 
+auto Expression::SimplifyImpl(const Expression& expression) -> std::unique_ptr<Expression>
+{
+    return expression.SimplifyImpl();
+}
+
 auto Expression::SimplifyAsync() const -> std::unique_ptr<Expression>
 {
-    static tf::Executor executor;
+    return SimplifyAsync(Runtime::Current());
+}
+
+auto Expression::SimplifyAsync(Runtime& runtime) const -> std::unique_ptr<Expression>
+{
     tf::Taskflow taskflow;
 
     std::unique_ptr<Expression> simplifiedExpression;
@@ -283,13 +524,17 @@ auto Expression::SimplifyAsync() const -> std::unique_ptr<Expression>
         simplifiedExpression = Simplify(subflow);
     });
 
-    executor.run(taskflow).wait();
+    runtime.GetExecutor().run(taskflow).wait();
     return simplifiedExpression;
 }
 
 auto Expression::StructurallyEquivalentAsync(const Expression& other) const -> bool
 {
-    static tf::Executor executor;
+    return StructurallyEquivalentAsync(other, Runtime::Current());
+}
+
+auto Expression::StructurallyEquivalentAsync(const Expression& other, Runtime& runtime) const -> bool
+{
     tf::Taskflow taskflow;
 
     bool equivalent = false;
@@ -298,10 +543,94 @@ auto Expression::StructurallyEquivalentAsync(const Expression& other) const -> b
         equivalent = StructurallyEquivalent(other, subflow);
     });
 
-    executor.run(taskflow).wait();
+    runtime.GetExecutor().run(taskflow).wait();
     return equivalent;
 }
 
+auto SimplifyMany(std::span<const Expression* const> expressions) -> std::vector<std::unique_ptr<Expression>>
+{
+    return SimplifyMany(expressions, Runtime::Current());
+}
+
+auto SimplifyMany(std::span<const Expression* const> expressions, Runtime& runtime) -> std::vector<std::unique_ptr<Expression>>
+{
+    std::vector<std::unique_ptr<Expression>> results(expressions.size());
+
+    // For each expression, the index of the first expression in the batch identical to it.
+    std::vector<std::size_t> firstEqual(expressions.size());
+    std::vector<std::size_t> distinct;
+
+    tf::Taskflow taskflow;
+
+    // Hashes are cached, so computing them up front in parallel keeps deduplication cheap.
+    tf::Task hash = taskflow.for_each_index(std::size_t { 0 }, expressions.size(), std::size_t { 1 }, [expressions](std::size_t i) {
+        if (expressions[i] != nullptr) {
+            [[maybe_unused]] const std::size_t h = expressions[i]->Hash();
+        }
+    });
+
+    tf::Task simplify = taskflow.emplace([expressions, &results, &firstEqual, &distinct](tf::Subflow& subflow) {
+        std::unordered_map<const Expression*, std::size_t, ExpressionHash, ExpressionIdentical> seen;
+
+        for (std::size_t i = 0; i < expressions.size(); ++i) {
+            if (expressions[i] == nullptr) {
+                firstEqual[i] = i;
+                continue;
+            }
+
+            const auto [it, inserted] = seen.try_emplace(expressions[i], i);
+            firstEqual[i] = it->second;
+
+            if (inserted) {
+                distinct.push_back(i);
+            }
+        }
+
+        // Scheduling the largest expressions first keeps one large expression from finishing alone
+        // after every worker has run out of small ones.
+        std::ranges::stable_sort(distinct, std::ranges::greater {}, [expressions](std::size_t i) { return expressions[i]->NodeCount(); });
+
+        const std::size_t cutoff = std::max<std::size_t>(Runtime::GetSequentialCutoff(), 1);
+
+        for (std::size_t begin = 0; begin < distinct.size();) {
+            if (expressions[distinct[begin]]->NodeCount() >= cutoff) {
+                subflow.emplace([expressions, &results, i = distinct[begin]](tf::Subflow& sbf) {
+                    results[i] = expressions[i]->Simplify(sbf);
+                });
+                ++begin;
+                continue;
+            }
+
+            std::size_t end = begin;
+
+            for (std::size_t nodes = 0; end < distinct.size() && nodes < cutoff; ++end) {
+                nodes += expressions[distinct[end]]->NodeCount();
+            }
+
+            subflow.emplace([expressions, &results, &distinct, begin, end] {
+                for (std::size_t j = begin; j < end; ++j) {
+                    results[distinct[j]] = expressions[distinct[j]]->Simplify();
+                }
+            });
+
+            begin = end;
+        }
+
+        subflow.join();
+    });
+
+    hash.precede(simplify);
+    runtime.GetExecutor().run(taskflow).wait();
+
+    for (std::size_t i = 0; i < expressions.size(); ++i) {
+        if (firstEqual[i] != i && results[firstEqual[i]] != nullptr) {
+            results[i] = results[firstEqual[i]]->Copy();
+        }
+    }
+
+    return results;
+}
+
 } // namespace Oasis
 std::unique_ptr<Oasis::Expression> operator+(const std::unique_ptr<Oasis::Expression>& lhs, const std::unique_ptr<Oasis::Expression>& rhs)
 {
@@ -0,0 +1,182 @@
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <new>
+#include <shared_mutex>
+#include <utility>
+
+#include "Oasis/ExpressionArena.hpp"
+#include "Oasis/ExpressionStore.hpp"
+
+namespace Oasis {
+
+namespace {
+
+    // The innermost arena of the calling thread, which stays the innermost while suspended.
+    thread_local ExpressionArena* innermostArena = nullptr;
+    thread_local bool arenasSuspended = false;
+    thread_local std::size_t threadArenas = 0;
+    std::atomic<std::size_t> liveArenas = 0;
+
+    // The blocks of every live arena, by their first byte, so that a node freed on another thread
+    // than its arena's can still be found.
+    std::shared_mutex blocksMutex;
+    std::map<const std::byte*, const std::byte*, std::less<>> allBlocks;
+
+} // namespace
+
+auto ExpressionArena::BlockResource::Owns(const void* ptr) const -> bool
+{
+    const auto* const byte = static_cast<const std::byte*>(ptr);
+
+    for (const auto& [first, last] : blocks) {
+        if (std::less_equal<> {}(first, byte) && std::less<> {}(byte, last)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+auto ExpressionArena::BlockResource::do_allocate(const std::size_t bytes, const std::size_t alignment) -> void*
+{
+    auto* const first = static_cast<std::byte*>(std::pmr::new_delete_resource()->allocate(bytes, alignment));
+    blocks.emplace_back(first, first + bytes);
+
+    const std::unique_lock lock { blocksMutex };
+    allBlocks.emplace(first, first + bytes);
+
+    return first;
+}
+
+auto ExpressionArena::BlockResource::do_deallocate(void* ptr, const std::size_t bytes, const std::size_t alignment) -> void
+{
+    std::erase_if(blocks, [ptr](const auto& block) { return block.first == ptr; });
+
+    {
+        const std::unique_lock lock { blocksMutex };
+        allBlocks.erase(static_cast<const std::byte*>(ptr));
+    }
+
+    std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+}
+
+auto ExpressionArena::BlockResource::do_is_equal(const std::pmr::memory_resource& other) const noexcept -> bool
+{
+    return this == &other;
+}
+
+ExpressionArena::ExpressionArena(std::size_t initialSize)
+    : resource(initialSize, &blocks)
+    , previous(innermostArena)
+{
+    innermostArena = this;
+    ++threadArenas;
+    liveArenas.fetch_add(1, std::memory_order_relaxed);
+}
+
+ExpressionArena::~ExpressionArena()
+{
+    // Nodes of the arenas created after this one would be left in freed memory.
+    if (innermostArena != this) {
+        std::terminate();
+    }
+
+    innermostArena = previous;
+    --threadArenas;
+    liveArenas.fetch_sub(1, std::memory_order_relaxed);
+}
+
+auto ExpressionArena::Promote(const Expression& expression) -> std::unique_ptr<Expression>
+{
+    // Suspend whichever arena is active so that the copy is made on the heap.
+    const bool suspended = Suspend();
+
+    ExpressionStore store;
+    auto promoted = store.Intern(expression)->Copy();
+
+    Resume(suspended);
+    return promoted;
+}
+
+auto ExpressionArena::Current() -> ExpressionArena*
+{
+    return arenasSuspended ? nullptr : innermostArena;
+}
+
+auto ExpressionArena::InUse() -> bool
+{
+    return liveArenas.load(std::memory_order_relaxed) != 0;
+}
+
+auto ExpressionArena::BytesAllocated() const -> std::size_t
+{
+    return bytesAllocated;
+}
+
+auto ExpressionArena::Owns(const void* ptr) -> bool
+{
+    for (const ExpressionArena* arena = innermostArena; arena != nullptr; arena = arena->previous) {
+        if (arena->blocks.Owns(ptr)) {
+            return true;
+        }
+    }
+
+    // Only arenas of other threads are left to search.
+    if (liveArenas.load(std::memory_order_relaxed) == threadArenas) {
+        return false;
+    }
+
+    const std::shared_lock lock { blocksMutex };
+    const auto* const byte = static_cast<const std::byte*>(ptr);
+    const auto next = allBlocks.upper_bound(byte);
+
+    return next != allBlocks.begin() && std::less<> {}(byte, std::prev(next)->second);
+}
+
+auto ExpressionArena::Suspend() -> bool
+{
+    return std::exchange(arenasSuspended, true);
+}
+
+auto ExpressionArena::Resume(const bool suspended) -> void
+{
+    arenasSuspended = suspended;
+}
+
+auto ExpressionArena::Allocate(std::size_t size) -> void*
+{
+    bytesAllocated += size;
+    return resource.allocate(size, alignof(std::max_align_t));
+}
+
+auto Expression::operator new(std::size_t size) -> void*
+{
+    if (ExpressionArena* const arena = ExpressionArena::Current(); arena != nullptr) {
+        return arena->Allocate(size);
+    }
+
+    return ::operator new(size);
+}
+
+auto Expression::operator new(std::size_t, void* ptr) noexcept -> void*
+{
+    return ptr;
+}
+
+auto Expression::operator delete(void* ptr) noexcept -> void
+{
+    if (ptr == nullptr) {
+        return;
+    }
+
+    // Arena memory is released all at once when its arena is destroyed.
+    if (!ExpressionArena::InUse() || !ExpressionArena::Owns(ptr)) {
+        ::operator delete(ptr);
+    }
+}
+
+} // Oasis
@@ -0,0 +1,62 @@
+#include <bit>
+#include <cstdint>
+#include <functional>
+
+#include "Oasis/ExpressionStore.hpp"
+
+namespace Oasis {
+
+auto ExpressionStore::Key::operator==(const Key& other) const -> bool
+{
+    // Compare the bit patterns so that -0.0 and 0.0 stay distinct and a NaN matches itself.
+    return type == other.type
+        && mostSigOp == other.mostSigOp
+        && leastSigOp == other.leastSigOp
+        && std::bit_cast<std::uint64_t>(value) == std::bit_cast<std::uint64_t>(other.value)
+        && name == other.name;
+}
+
+auto ExpressionStore::KeyHash::operator()(const Key& key) const -> std::size_t
+{
+    std::size_t seed = MixHash(static_cast<std::size_t>(key.type));
+    seed = CombineHash(seed, std::hash<const Expression*> {}(key.mostSigOp));
+    seed = CombineHash(seed, std::hash<const Expression*> {}(key.leastSigOp));
+    seed = CombineHash(seed, std::hash<std::uint64_t> {}(std::bit_cast<std::uint64_t>(key.value)));
+    return CombineHash(seed, std::hash<std::string> {}(key.name));
+}
+
+auto ExpressionStore::Intern(const Expression& expression) -> std::shared_ptr<const Expression>
+{
+    return expression.Intern(*this);
+}
+
+auto ExpressionStore::Find(const Key& key) const -> std::shared_ptr<const Expression>
+{
+    std::lock_guard lock { mutex };
+
+    if (const auto it = nodes.find(key); it != nodes.end()) {
+        return it->second;
+    }
+
+    return nullptr;
+}
+
+auto ExpressionStore::Insert(const Key& key, std::shared_ptr<const Expression> expression) -> std::shared_ptr<const Expression>
+{
+    std::lock_guard lock { mutex };
+    return nodes.try_emplace(key, std::move(expression)).first->second;
+}
+
+auto ExpressionStore::Size() const -> std::size_t
+{
+    std::lock_guard lock { mutex };
+    return nodes.size();
+}
+
+auto ExpressionStore::Clear() -> void
+{
+    std::lock_guard lock { mutex };
+    nodes.clear();
+}
+
+} // Oasis
@@ -0,0 +1,977 @@
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+#include "Oasis/FrozenExpression.hpp"
+
+#include "Oasis/Add.hpp"
+#include "Oasis/Derivative.hpp"
+#include "Oasis/Divide.hpp"
+#include "Oasis/Exponent.hpp"
+#include "Oasis/Imaginary.hpp"
+#include "Oasis/Integral.hpp"
+#include "Oasis/Log.hpp"
+#include "Oasis/Matrix.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Negate.hpp"
+#include "Oasis/NodeAllocation.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Serialization.hpp"
+#include "Oasis/Subtract.hpp"
+#include "Oasis/Undefined.hpp"
+#include "Oasis/Variable.hpp"
+
+namespace {
+
+using Oasis::AllocateNode;
+using Oasis::ExpressionType;
+using Oasis::FrozenExpression;
+using Oasis::MakeBinaryNode;
+
+constexpr char magic[4] = { 'O', 'A', 'S', 'F' };
+constexpr std::uint32_t byte_order_mark = 0x01020304;
+
+struct Header {
+    char magic[4];
+    std::uint32_t byteOrder;
+    std::uint32_t version;
+    std::uint32_t nodeCount;
+    std::uint32_t constantCount;
+    std::uint32_t matrixCount;
+    std::uint32_t nameCount;
+    std::uint32_t nameBytes;
+};
+
+// The offset of each array in the buffer. Arrays of wider elements come first, so that every
+// array is aligned as long as the buffer is.
+struct Layout {
+    explicit Layout(const Header& header)
+        : hashes(sizeof(Header))
+        , constants(hashes + sizeof(std::uint64_t) * header.nodeCount)
+        , first(constants + sizeof(double) * header.constantCount)
+        , second(first + sizeof(std::uint32_t) * header.nodeCount)
+        , matrices(second + sizeof(std::uint32_t) * header.nodeCount)
+        , nameOffsets(matrices + 3 * sizeof(std::uint32_t) * header.matrixCount)
+        , types(nameOffsets + sizeof(std::uint32_t) * (std::uint64_t { header.nameCount } + 1))
+        , names(types + header.nodeCount)
+        , size((names + header.nameBytes + 7) / 8 * 8)
+    {
+    }
+
+    std::uint64_t hashes, constants, first, second, matrices, nameOffsets, types, names, size;
+};
+
+auto isBinary(const ExpressionType type) -> bool
+{
+    switch (type) {
+    case ExpressionType::Add:
+    case ExpressionType::Subtract:
+    case ExpressionType::Multiply:
+    case ExpressionType::Divide:
+    case ExpressionType::Exponent:
+    case ExpressionType::Log:
+    case ExpressionType::Derivative:
+    case ExpressionType::Integral:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Mirrors the categories of the expression classes, which Equals consults.
+auto isAssociative(const ExpressionType type) -> bool
+{
+    return type == ExpressionType::Add || type == ExpressionType::Multiply || type == ExpressionType::Integral;
+}
+
+// FNV-1a, which gives the same hash on every platform, unlike std::hash.
+constexpr std::uint64_t fnv_offset = 0xcbf29ce484222325ULL;
+constexpr std::uint64_t fnv_prime = 0x100000001b3ULL;
+
+auto fnv(std::uint64_t hash, const std::uint64_t value, const int bytes) -> std::uint64_t
+{
+    // Least significant byte first, whatever the byte order of the machine.
+    for (int i = 0; i < bytes; ++i) {
+        hash = (hash ^ ((value >> (8 * i)) & 0xFF)) * fnv_prime;
+    }
+
+    return hash;
+}
+
+// Equal numbers, 0 and -0 included, hash alike.
+auto fnv(const std::uint64_t hash, const double value) -> std::uint64_t
+{
+    return fnv(hash, std::bit_cast<std::uint64_t>(value == 0.0 ? 0.0 : value), 8);
+}
+
+auto mix(std::uint64_t x) -> std::uint64_t
+{
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+// Identifies a pair of nodes, one from each of two frozen expressions.
+auto pairKey(const std::uint32_t node, const std::uint32_t otherNode) -> std::uint64_t
+{
+    return std::uint64_t { node } << 32 | otherNode;
+}
+
+template <typename T>
+void append(std::vector<std::uint64_t>& storage, const std::uint64_t offset, const std::vector<T>& values)
+{
+    if (!values.empty()) {
+        std::memcpy(reinterpret_cast<std::byte*>(storage.data()) + offset, values.data(), values.size() * sizeof(T));
+    }
+}
+
+template <bool Root>
+auto thaw(const FrozenExpression& frozen, const std::vector<std::shared_ptr<const Oasis::Expression>>& nodes, const std::uint32_t node) -> Oasis::ExpressionNode<Root>
+{
+    const std::uint32_t mostSigOp = frozen.GetChild(node, 0);
+    const std::uint32_t leastSigOp = frozen.GetChild(node, 1);
+
+    const auto operand = [&nodes](const std::uint32_t child) -> std::shared_ptr<const Oasis::Expression> {
+        return child != FrozenExpression::npos ? nodes[child] : nullptr;
+    };
+
+    switch (frozen.GetType(node)) {
+    case ExpressionType::Real:
+        return AllocateNode<Oasis::Real, Root>(frozen.GetValue(node));
+    case ExpressionType::Imaginary:
+        return AllocateNode<Oasis::Imaginary, Root>();
+    case ExpressionType::Variable:
+        return AllocateNode<Oasis::Variable, Root>(std::string { frozen.GetName(node) });
+    case ExpressionType::Matrix: {
+        Oasis::MatrixXXD matrix(frozen.GetMatrixRows(node), frozen.GetMatrixCols(node));
+        std::ranges::copy(frozen.GetMatrixValues(node), matrix.data());
+        return AllocateNode<Oasis::Matrix, Root>(std::move(matrix));
+    }
+    case ExpressionType::Add:
+        return MakeBinaryNode<Oasis::Add, Root>(operand(mostSigOp), operand(leastSigOp));
+    case ExpressionType::Subtract:
+        return MakeBinaryNode<Oasis::Subtract, Root>(operand(mostSigOp), operand(leastSigOp));
+    case ExpressionType::Multiply:
+        return MakeBinaryNode<Oasis::Multiply, Root>(operand(mostSigOp), operand(leastSigOp));
+    case ExpressionType::Divide:
+        return MakeBinaryNode<Oasis::Divide, Root>(operand(mostSigOp), operand(leastSigOp));
+    case ExpressionType::Exponent:
+        return MakeBinaryNode<Oasis::Exponent, Root>(operand(mostSigOp), operand(leastSigOp));
+    case ExpressionType::Log:
+        return MakeBinaryNode<Oasis::Log, Root>(operand(mostSigOp), operand(leastSigOp));
+    case ExpressionType::Derivative:
+        return MakeBinaryNode<Oasis::Derivative, Root>(operand(mostSigOp), operand(leastSigOp));
+    case ExpressionType::Integral:
+        return MakeBinaryNode<Oasis::Integral, Root>(operand(mostSigOp), operand(leastSigOp));
+    case ExpressionType::Negate: {
+        auto negate = AllocateNode<Oasis::Negate<Oasis::Expression>, Root>();
+
+        if (mostSigOp != FrozenExpression::npos) {
+            negate->SetOperand(nodes[mostSigOp]);
+        }
+
+        return negate;
+    }
+    default:
+        return AllocateNode<Oasis::Undefined, Root>();
+    }
+}
+
+// Visits a node through a generalized expression on the stack that shares the thawed operands.
+template <template <typename, typename> typename T>
+void serializeBinary(Oasis::SerializationVisitor& visitor, std::shared_ptr<const Oasis::Expression> mostSigOp, std::shared_ptr<const Oasis::Expression> leastSigOp)
+{
+    T<Oasis::Expression, Oasis::Expression> expression;
+    expression.mostSigOp = std::move(mostSigOp);
+    expression.leastSigOp = std::move(leastSigOp);
+    visitor.Serialize(expression);
+}
+
+}
+
+namespace Oasis {
+
+auto FrozenExpression::Freeze(const Expression& expression) -> FrozenExpression
+{
+    std::vector<double> constants;
+    std::vector<std::uint32_t> firsts;
+    std::vector<std::uint32_t> seconds;
+    std::vector<std::uint32_t> matrixInfo;
+    std::vector<std::uint32_t> offsets { 0 };
+    std::vector<std::uint8_t> nodeTypes;
+    std::string nameChars;
+
+    std::unordered_map<std::string, std::uint32_t> nameIndices;
+    std::unordered_map<const Expression*, std::uint32_t> indices;
+
+    const auto indexOf = [&indices](const Expression* operand) {
+        return operand == nullptr ? npos : indices.at(operand);
+    };
+
+    // Nodes are numbered in postorder with an explicit stack, so deep expressions do not exhaust
+    // the call stack. A node already numbered through another parent is not numbered again.
+    std::vector<std::pair<const Expression*, bool>> stack { { &expression, false } };
+
+    while (!stack.empty()) {
+        const auto [node, expanded] = stack.back();
+
+        if (indices.contains(node)) {
+            stack.pop_back();
+            continue;
+        }
+
+        const ExpressionType type = node->GetType();
+
+        if (!expanded) {
+            stack.back().second = true;
+
+            if (!isBinary(type) && type != ExpressionType::Negate) {
+                continue;
+            }
+
+            for (std::size_t i = 2; i-- > 0;) {
+                if (const Expression* child = node->GetChild(i); child != nullptr && !indices.contains(child)) {
+                    stack.emplace_back(child, false);
+                }
+            }
+
+            continue;
+        }
+
+        if (nodeTypes.size() >= npos - 1) {
+            throw std::invalid_argument("Expression has too many nodes to freeze.");
+        }
+
+        std::uint32_t firstIndex = npos;
+        std::uint32_t secondIndex = npos;
+
+        switch (type) {
+        case ExpressionType::Real:
+            firstIndex = static_cast<std::uint32_t>(constants.size());
+            constants.push_back(static_cast<const Real&>(*node).GetValue());
+            break;
+        case ExpressionType::Variable: {
+            const auto name = static_cast<const Variable&>(*node).GetName();
+            const auto [it, inserted] = nameIndices.try_emplace(name, static_cast<std::uint32_t>(nameIndices.size()));
+
+            if (inserted) {
+                nameChars += name;
+                offsets.push_back(static_cast<std::uint32_t>(nameChars.size()));
+            }
+
+            firstIndex = it->second;
+            break;
+        }
+        case ExpressionType::Matrix: {
+            const MatrixXXD& matrix = static_cast<const Matrix&>(*node).GetMatrix();
+            firstIndex = static_cast<std::uint32_t>(matrixInfo.size() / 3);
+            matrixInfo.insert(matrixInfo.end(), { static_cast<std::uint32_t>(matrix.rows()), static_cast<std::uint32_t>(matrix.cols()), static_cast<std::uint32_t>(constants.size()) });
+            constants.insert(constants.end(), matrix.data(), matrix.data() + matrix.size());
+            break;
+        }
+        case ExpressionType::Imaginary:
+        case ExpressionType::None:
+            break;
+        case ExpressionType::Negate:
+            firstIndex = indexOf(node->GetChild(0));
+            break;
+        default:
+            if (!isBinary(type)) {
+                throw std::invalid_argument("Expression contains a node that cannot be frozen.");
+            }
+
+            firstIndex = indexOf(node->GetChild(0));
+            secondIndex = indexOf(node->GetChild(1));
+        }
+
+        if (constants.size() >= npos || nameChars.size() >= npos) {
+            throw std::invalid_argument("Expression is too large to freeze.");
+        }
+
+        indices.emplace(node, static_cast<std::uint32_t>(nodeTypes.size()));
+        nodeTypes.push_back(static_cast<std::uint8_t>(type));
+        firsts.push_back(firstIndex);
+        seconds.push_back(secondIndex);
+        stack.pop_back();
+    }
+
+    Header header {
+        .magic = {},
+        .byteOrder = byte_order_mark,
+        .version = version,
+        .nodeCount = static_cast<std::uint32_t>(nodeTypes.size()),
+        .constantCount = static_cast<std::uint32_t>(constants.size()),
+        .matrixCount = static_cast<std::uint32_t>(matrixInfo.size() / 3),
+        .nameCount = static_cast<std::uint32_t>(nameIndices.size()),
+        .nameBytes = static_cast<std::uint32_t>(nameChars.size()),
+    };
+    std::memcpy(header.magic, magic, sizeof magic);
+    const Layout layout { header };
+
+    // Words rather than bytes, so that the buffer is aligned for every array.
+    auto storage = std::make_shared<std::vector<std::uint64_t>>(layout.size / sizeof(std::uint64_t));
+    std::memcpy(storage->data(), &header, sizeof header);
+    append(*storage, layout.constants, constants);
+    append(*storage, layout.first, firsts);
+    append(*storage, layout.second, seconds);
+    append(*storage, layout.matrices, matrixInfo);
+    append(*storage, layout.nameOffsets, offsets);
+    append(*storage, layout.types, nodeTypes);
+    std::memcpy(reinterpret_cast<std::byte*>(storage->data()) + layout.names, nameChars.data(), nameChars.size());
+
+    const std::span<const std::byte> bytes = std::as_bytes(std::span { *storage });
+
+    // Each hash depends only on those of earlier nodes, so one pass in postorder fills them in.
+    const FrozenExpression unhashed = View(bytes, nullptr);
+    auto* const nodeHashes = reinterpret_cast<std::uint64_t*>(reinterpret_cast<std::byte*>(storage->data()) + layout.hashes);
+
+    for (std::uint32_t node = 0; node < header.nodeCount; ++node) {
+        nodeHashes[node] = unhashed.HashAt(node);
+    }
+
+    return FromBytes(bytes, std::move(storage));
+}
+
+auto FrozenExpression::FromBytes(const std::span<const std::byte> bytes, std::shared_ptr<const void> owner) -> FrozenExpression
+{
+    if (reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(std::uint64_t) != 0) {
+        throw std::invalid_argument("Frozen expression buffer is not aligned to 8 bytes.");
+    }
+
+    Header header {};
+
+    if (bytes.size() < sizeof header) {
+        throw std::invalid_argument("Frozen expression buffer is too small.");
+    }
+
+    std::memcpy(&header, bytes.data(), sizeof header);
+
+    if (std::memcmp(header.magic, magic, sizeof magic) != 0) {
+        throw std::invalid_argument("Not a frozen expression.");
+    }
+
+    if (header.byteOrder != byte_order_mark) {
+        throw std::invalid_argument("Frozen expression was written with another byte order.");
+    }
+
+    if (header.version != version) {
+        throw std::invalid_argument("Unsupported frozen expression version.");
+    }
+
+    if (header.nodeCount == 0 || header.nodeCount >= npos) {
+        throw std::invalid_argument("Frozen expression has no nodes.");
+    }
+
+    if (bytes.size() < Layout { header }.size) {
+        throw std::invalid_argument("Frozen expression buffer is truncated.");
+    }
+
+    FrozenExpression frozen = View(bytes, std::move(owner));
+
+    // Check every index once, so that nothing that reads the buffer afterwards needs to.
+    if (frozen.nameOffsets[0] != 0 || frozen.nameOffsets[header.nameCount] != header.nameBytes) {
+        throw std::invalid_argument("Frozen expression has a malformed name table.");
+    }
+
+    for (std::uint32_t i = 0; i < header.nameCount; ++i) {
+        if (frozen.nameOffsets[i] > frozen.nameOffsets[i + 1]) {
+            throw std::invalid_argument("Frozen expression has a malformed name table.");
+        }
+    }
+
+    for (std::uint32_t i = 0; i < header.matrixCount; ++i) {
+        const std::uint64_t size = std::uint64_t { frozen.matrices[3 * i] } * frozen.matrices[3 * i + 1];
+
+        if (frozen.matrices[3 * i + 2] + size > header.constantCount) {
+            throw std::invalid_argument("Frozen expression has a malformed matrix.");
+        }
+    }
+
+    // The height of each node, which fits in 16 bits since it is at most max_height.
+    std::vector<std::uint16_t> heights(header.nodeCount);
+
+    for (std::uint32_t node = 0; node < header.nodeCount; ++node) {
+        const auto type = static_cast<ExpressionType>(frozen.types[node]);
+        const std::uint32_t firstIndex = frozen.first[node];
+        const std::uint32_t secondIndex = frozen.second[node];
+
+        // Operands must precede their parent, which also rules out cycles.
+        const auto isOperand = [node](const std::uint32_t index) { return index == npos || index < node; };
+
+        bool valid;
+
+        switch (type) {
+        case ExpressionType::Real:
+            valid = firstIndex < header.constantCount;
+            break;
+        case ExpressionType::Variable:
+            valid = firstIndex < header.nameCount;
+            break;
+        case ExpressionType::Matrix:
+            valid = firstIndex < header.matrixCount;
+            break;
+        case ExpressionType::Imaginary:
+        case ExpressionType::None:
+            valid = true;
+            break;
+        case ExpressionType::Negate:
+            valid = isOperand(firstIndex) && secondIndex == npos;
+            break;
+        default:
+            valid = isBinary(type) && isOperand(firstIndex) && isOperand(secondIndex);
+        }
+
+        if (!valid) {
+            throw std::invalid_argument("Frozen expression has a malformed node.");
+        }
+
+        std::size_t height = 1;
+
+        if (isBinary(type) || type == ExpressionType::Negate) {
+            for (const std::uint32_t index : { firstIndex, secondIndex }) {
+                if (index != npos) {
+                    height = std::max<std::size_t>(height, heights[index] + 1);
+                }
+            }
+        }
+
+        if (height > max_height) {
+            throw std::invalid_argument("Frozen expression is nested too deeply.");
+        }
+
+        heights[node] = static_cast<std::uint16_t>(height);
+
+        // The operands have been checked by now, so the hash of this node can be computed.
+        if (frozen.hashes[node] != frozen.HashAt(node)) {
+            throw std::invalid_argument("Frozen expression has a wrong hash.");
+        }
+    }
+
+    return frozen;
+}
+
+auto FrozenExpression::Thaw() const -> std::unique_ptr<Expression>
+{
+    // Operands come before their parents, so one pass builds every node from its operands.
+    std::vector<std::shared_ptr<const Expression>> nodes(nodeCount - 1);
+
+    for (std::uint32_t node = 0; node < nodeCount - 1; ++node) {
+        nodes[node] = thaw<false>(*this, nodes, node);
+    }
+
+    return thaw<true>(*this, nodes, GetRoot());
+}
+
+auto FrozenExpression::Equals(const FrozenExpression& other) const -> bool
+{
+    // Most equal expressions are identical node for node, which is checked without recursing, so
+    // only expressions that differ somewhere need the full comparison.
+    // Pairs already compared are skipped, so that shared operands are compared once rather than
+    // once per path to them.
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> pending { { GetRoot(), other.GetRoot() } };
+    std::unordered_set<std::uint64_t> visited;
+    std::unordered_map<std::uint64_t, bool> memo;
+    bool identical = true;
+
+    while (identical && !pending.empty()) {
+        const auto [node, otherNode] = pending.back();
+        pending.pop_back();
+
+        if (!visited.insert(pairKey(node, otherNode)).second) {
+            continue;
+        }
+
+        const ExpressionType type = GetType(node);
+
+        if (type != other.GetType(otherNode) || hashes[node] != other.hashes[otherNode]) {
+            identical = false;
+        } else if (!isBinary(type) && type != ExpressionType::Negate) {
+            identical = EqualsAt(node, other, otherNode, memo);
+        } else {
+            for (std::size_t i = 0; i < 2; ++i) {
+                const std::uint32_t child = GetChild(node, i);
+                const std::uint32_t otherChild = other.GetChild(otherNode, i);
+
+                if ((child == npos) != (otherChild == npos)) {
+                    identical = false;
+                } else if (child != npos) {
+                    pending.emplace_back(child, otherChild);
+                }
+            }
+        }
+    }
+
+    return identical || EqualsAt(GetRoot(), other, other.GetRoot(), memo);
+}
+
+auto FrozenExpression::StructurallyEquivalent(const FrozenExpression& other) const -> bool
+{
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> pending { { GetRoot(), other.GetRoot() } };
+    std::unordered_set<std::uint64_t> visited;
+
+    while (!pending.empty()) {
+        const auto [node, otherNode] = pending.back();
+        pending.pop_back();
+
+        if (!visited.insert(pairKey(node, otherNode)).second) {
+            continue;
+        }
+
+        const ExpressionType type = GetType(node);
+
+        if (type != other.GetType(otherNode)) {
+            return false;
+        }
+
+        // Like the expression classes, only the operands present in both are compared.
+        if (isBinary(type)) {
+            for (std::size_t i = 0; i < 2; ++i) {
+                const std::uint32_t child = GetChild(node, i);
+                const std::uint32_t otherChild = other.GetChild(otherNode, i);
+
+                if (child != npos && otherChild != npos) {
+                    pending.emplace_back(child, otherChild);
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+auto FrozenExpression::Hash() const -> std::uint64_t
+{
+    return hashes[GetRoot()];
+}
+
+void FrozenExpression::Serialize(SerializationVisitor& visitor) const
+{
+    // The visitor recurses into operands as expressions and may inspect them, so they are thawed.
+    // Only the root is visited in place, as it has no parent to keep it.
+    const std::uint32_t root = GetRoot();
+    std::vector<std::shared_ptr<const Expression>> nodes(root);
+
+    for (std::uint32_t node = 0; node < root; ++node) {
+        nodes[node] = thaw<false>(*this, nodes, node);
+    }
+
+    const std::uint32_t mostSigOp = GetChild(root, 0);
+    const std::uint32_t leastSigOp = GetChild(root, 1);
+
+    const auto operand = [&nodes](const std::uint32_t child) -> std::shared_ptr<const Expression> {
+        return child != npos ? nodes[child] : nullptr;
+    };
+
+    switch (GetType(root)) {
+    case ExpressionType::Add:
+        serializeBinary<Add>(visitor, operand(mostSigOp), operand(leastSigOp));
+        break;
+    case ExpressionType::Subtract:
+        serializeBinary<Subtract>(visitor, operand(mostSigOp), operand(leastSigOp));
+        break;
+    case ExpressionType::Multiply:
+        serializeBinary<Multiply>(visitor, operand(mostSigOp), operand(leastSigOp));
+        break;
+    case ExpressionType::Divide:
+        serializeBinary<Divide>(visitor, operand(mostSigOp), operand(leastSigOp));
+        break;
+    case ExpressionType::Exponent:
+        serializeBinary<Exponent>(visitor, operand(mostSigOp), operand(leastSigOp));
+        break;
+    case ExpressionType::Log:
+        serializeBinary<Log>(visitor, operand(mostSigOp), operand(leastSigOp));
+        break;
+    case ExpressionType::Derivative:
+        serializeBinary<Derivative>(visitor, operand(mostSigOp), operand(leastSigOp));
+        break;
+    case ExpressionType::Integral:
+        serializeBinary<Integral>(visitor, operand(mostSigOp), operand(leastSigOp));
+        break;
+    case ExpressionType::Negate: {
+        Negate<Expression> negate;
+
+        if (mostSigOp != npos) {
+            negate.SetOperand(nodes[mostSigOp]);
+        }
+
+        visitor.Serialize(negate);
+        break;
+    }
+    default:
+        // A leaf is cheap to thaw, and thawing it once handles every kind of leaf.
+        thaw<true>(*this, nodes, root)->Serialize(visitor);
+    }
+}
+
+auto FrozenExpression::Evaluate(const std::span<const double> values) const -> double
+{
+    if (values.size() < nameCount) {
+        throw std::invalid_argument("Too few values for the variables of the frozen expression.");
+    }
+
+    thread_local std::vector<double> results;
+
+    if (results.size() < nodeCount) {
+        results.resize(nodeCount);
+    }
+
+    const auto operand = [](const std::uint32_t index) {
+        if (index == npos) {
+            throw std::invalid_argument("Cannot evaluate an operation with a missing operand.");
+        }
+
+        return index;
+    };
+
+    for (std::uint32_t node = 0; node < nodeCount; ++node) {
+        const auto type = static_cast<ExpressionType>(types[node]);
+
+        if (type == ExpressionType::Real) {
+            results[node] = constants[first[node]];
+            continue;
+        }
+
+        if (type == ExpressionType::Variable) {
+            results[node] = values[first[node]];
+            continue;
+        }
+
+        if (type == ExpressionType::Negate) {
+            results[node] = -results[operand(first[node])];
+            continue;
+        }
+
+        if (!isBinary(type) || type == ExpressionType::Derivative || type == ExpressionType::Integral) {
+            throw std::invalid_argument("Only real numbers, variables, and arithmetic can be evaluated.");
+        }
+
+        const double lhs = results[operand(first[node])];
+        const double rhs = results[operand(second[node])];
+
+        switch (type) {
+        case ExpressionType::Add:
+            results[node] = lhs + rhs;
+            break;
+        case ExpressionType::Subtract:
+            results[node] = lhs - rhs;
+            break;
+        case ExpressionType::Multiply:
+            results[node] = lhs * rhs;
+            break;
+        case ExpressionType::Divide:
+            results[node] = lhs / rhs;
+            break;
+        case ExpressionType::Exponent:
+            results[node] = std::pow(lhs, rhs);
+            break;
+        default:
+            results[node] = std::log(rhs) / std::log(lhs);
+        }
+    }
+
+    return results[GetRoot()];
+}
+
+auto FrozenExpression::GetBytes() const -> std::span<const std::byte>
+{
+    return bytes;
+}
+
+auto FrozenExpression::GetNodeCount() const -> std::uint32_t
+{
+    return nodeCount;
+}
+
+auto FrozenExpression::GetRoot() const -> std::uint32_t
+{
+    return nodeCount - 1;
+}
+
+auto FrozenExpression::GetType(const std::uint32_t node) const -> ExpressionType
+{
+    return static_cast<ExpressionType>(types[node]);
+}
+
+auto FrozenExpression::GetChild(const std::uint32_t node, const std::size_t index) const -> std::uint32_t
+{
+    const ExpressionType type = GetType(node);
+
+    if (index == 0 && (isBinary(type) || type == ExpressionType::Negate)) {
+        return first[node];
+    }
+
+    if (index == 1 && isBinary(type)) {
+        return second[node];
+    }
+
+    return npos;
+}
+
+auto FrozenExpression::GetValue(const std::uint32_t node) const -> double
+{
+    return constants[first[node]];
+}
+
+auto FrozenExpression::GetName(const std::uint32_t node) const -> std::string_view
+{
+    return GetVariable(first[node]);
+}
+
+auto FrozenExpression::GetMatrixRows(const std::uint32_t node) const -> std::uint32_t
+{
+    return matrices[3 * first[node]];
+}
+
+auto FrozenExpression::GetMatrixCols(const std::uint32_t node) const -> std::uint32_t
+{
+    return matrices[3 * first[node] + 1];
+}
+
+auto FrozenExpression::GetMatrixValues(const std::uint32_t node) const -> std::span<const double>
+{
+    const std::uint32_t* info = matrices + 3 * first[node];
+    return { constants + info[2], std::size_t { info[0] } * info[1] };
+}
+
+auto FrozenExpression::GetVariableCount() const -> std::uint32_t
+{
+    return nameCount;
+}
+
+auto FrozenExpression::GetVariable(const std::uint32_t index) const -> std::string_view
+{
+    return { names + nameOffsets[index], nameOffsets[index + 1] - nameOffsets[index] };
+}
+
+auto FrozenExpression::View(const std::span<const std::byte> bytes, std::shared_ptr<const void> owner) -> FrozenExpression
+{
+    Header header {};
+    std::memcpy(&header, bytes.data(), sizeof header);
+    const Layout layout { header };
+
+    FrozenExpression frozen;
+    frozen.owner = std::move(owner);
+    frozen.bytes = bytes.first(layout.size);
+    frozen.nodeCount = header.nodeCount;
+    frozen.nameCount = header.nameCount;
+    frozen.hashes = reinterpret_cast<const std::uint64_t*>(bytes.data() + layout.hashes);
+    frozen.constants = reinterpret_cast<const double*>(bytes.data() + layout.constants);
+    frozen.first = reinterpret_cast<const std::uint32_t*>(bytes.data() + layout.first);
+    frozen.second = reinterpret_cast<const std::uint32_t*>(bytes.data() + layout.second);
+    frozen.matrices = reinterpret_cast<const std::uint32_t*>(bytes.data() + layout.matrices);
+    frozen.nameOffsets = reinterpret_cast<const std::uint32_t*>(bytes.data() + layout.nameOffsets);
+    frozen.types = reinterpret_cast<const std::uint8_t*>(bytes.data() + layout.types);
+    frozen.names = reinterpret_cast<const char*>(bytes.data() + layout.names);
+    return frozen;
+}
+
+auto FrozenExpression::HashAt(const std::uint32_t node) const -> std::uint64_t
+{
+    const ExpressionType type = GetType(node);
+    const std::uint64_t typeSeed = fnv(fnv_offset, static_cast<std::uint64_t>(type), 1);
+
+    switch (type) {
+    case ExpressionType::Real:
+        return fnv(typeSeed, GetValue(node));
+    case ExpressionType::Variable: {
+        std::uint64_t hash = typeSeed;
+
+        for (const char c : GetName(node)) {
+            hash = fnv(hash, static_cast<unsigned char>(c), 1);
+        }
+
+        return hash;
+    }
+    case ExpressionType::Matrix: {
+        std::uint64_t hash = fnv(fnv(typeSeed, GetMatrixRows(node), 4), GetMatrixCols(node), 4);
+
+        for (const double value : GetMatrixValues(node)) {
+            hash = fnv(hash, value);
+        }
+
+        return hash;
+    }
+    default:
+        break;
+    }
+
+    if (!isBinary(type) && type != ExpressionType::Negate) {
+        return typeSeed;
+    }
+
+    const std::uint32_t firstIndex = first[node];
+    const std::uint32_t secondIndex = type == ExpressionType::Negate ? npos : second[node];
+
+    if (!isAssociative(type)) {
+        const auto operandHash = [this](const std::uint32_t operand) { return operand == npos ? 0 : hashes[operand]; };
+        return fnv(fnv(typeSeed, operandHash(firstIndex), 8), operandHash(secondIndex), 8);
+    }
+
+    // Like Expression::Hash, the operands of associative operations are summed, and operands of
+    // the same operation contribute their own sums, so that every grouping and order of the same
+    // flattened operands hashes alike.
+    const auto operandHash = [this, type, typeSeed](const std::uint32_t operand) -> std::uint64_t {
+        if (operand == npos) {
+            return 0;
+        }
+
+        return GetType(operand) == type ? hashes[operand] - typeSeed : mix(hashes[operand]);
+    };
+
+    return typeSeed + operandHash(firstIndex) + operandHash(secondIndex);
+}
+
+auto FrozenExpression::EqualsAt(const std::uint32_t node, const FrozenExpression& other, const std::uint32_t otherNode, std::unordered_map<std::uint64_t, bool>& memo) const -> bool
+{
+    const ExpressionType type = GetType(node);
+
+    if (type != other.GetType(otherNode) || hashes[node] != other.hashes[otherNode]) {
+        return false;
+    }
+
+    if (const auto known = memo.find(pairKey(node, otherNode)); known != memo.end()) {
+        return known->second;
+    }
+
+    const bool equal = EqualOperandsAt(node, other, otherNode, memo);
+    memo.emplace(pairKey(node, otherNode), equal);
+    return equal;
+}
+
+auto FrozenExpression::EqualOperandsAt(const std::uint32_t node, const FrozenExpression& other, const std::uint32_t otherNode, std::unordered_map<std::uint64_t, bool>& memo) const -> bool
+{
+    const ExpressionType type = GetType(node);
+
+    switch (type) {
+    case ExpressionType::None:
+        // Undefined is not equal to anything, not even itself.
+        return false;
+    case ExpressionType::Imaginary:
+        return true;
+    case ExpressionType::Real:
+        return GetValue(node) == other.GetValue(otherNode);
+    case ExpressionType::Variable:
+        return GetName(node) == other.GetName(otherNode);
+    case ExpressionType::Matrix:
+        return GetMatrixRows(node) == other.GetMatrixRows(otherNode) && GetMatrixCols(node) == other.GetMatrixCols(otherNode)
+            && std::ranges::equal(GetMatrixValues(node), other.GetMatrixValues(otherNode));
+    default:
+        break;
+    }
+
+    // Like the expression classes, operands are compared in order first, and the operands of
+    // associative operations are then compared in any grouping and order.
+    const auto mismatch = [&](const std::uint32_t child, const std::uint32_t otherChild) {
+        if ((child == npos) != (otherChild == npos)) {
+            return true;
+        }
+
+        return child != npos && !EqualsAt(child, other, otherChild, memo);
+    };
+
+    if (type == ExpressionType::Negate) {
+        return !mismatch(first[node], other.first[otherNode]);
+    }
+
+    if (!mismatch(first[node], other.first[otherNode]) && !mismatch(second[node], other.second[otherNode])) {
+        return true;
+    }
+
+    if (!isAssociative(type)) {
+        return false;
+    }
+
+    std::vector<std::pair<std::uint32_t, std::uint64_t>> operands;
+    std::vector<std::pair<std::uint32_t, std::uint64_t>> otherOperands;
+    FlattenAt(node, type, operands);
+    other.FlattenAt(otherNode, type, otherOperands);
+
+    const auto total = [](const auto& counted) {
+        std::uint64_t sum = 0;
+
+        for (const auto& [operand, count] : counted) {
+            sum += count;
+        }
+
+        return sum;
+    };
+
+    if (total(operands) != total(otherOperands)) {
+        return false;
+    }
+
+    // Each occurrence of an operand of the other expression may only be matched once, so that
+    // repeated operands must appear equally often on both sides.
+    return std::all_of(operands.begin(), operands.end(), [&](const std::pair<std::uint32_t, std::uint64_t>& counted) {
+        std::uint64_t unmatched = counted.second;
+
+        for (auto& [otherOperand, otherCount] : otherOperands) {
+            if (unmatched == 0) {
+                break;
+            }
+
+            if (otherCount != 0 && EqualsAt(counted.first, other, otherOperand, memo)) {
+                const std::uint64_t matched = std::min(unmatched, otherCount);
+                unmatched -= matched;
+                otherCount -= matched;
+            }
+        }
+
+        return unmatched == 0;
+    });
+}
+
+void FrozenExpression::FlattenAt(const std::uint32_t node, const ExpressionType type, std::vector<std::pair<std::uint32_t, std::uint64_t>>& out) const
+{
+    // An operation shared by several others is visited once, with the number of paths to it, so
+    // that flattening takes time in proportion to the nodes rather than to the paths.
+    std::vector<std::uint32_t> operations;
+    std::vector<std::uint32_t> pending { node };
+    std::unordered_set<std::uint32_t> seen { node };
+
+    while (!pending.empty()) {
+        const std::uint32_t current = pending.back();
+        pending.pop_back();
+        operations.push_back(current);
+
+        for (const std::uint32_t child : { first[current], second[current] }) {
+            if (child != npos && GetType(child) == type && seen.insert(child).second) {
+                pending.push_back(child);
+            }
+        }
+    }
+
+    // Operands precede their parents, so visiting in descending order counts every path to an
+    // operation before passing the count on to its operands.
+    std::ranges::sort(operations, std::greater {});
+    std::unordered_map<std::uint32_t, std::uint64_t> counts { { node, 1 } };
+
+    for (const std::uint32_t operation : operations) {
+        const std::uint64_t count = counts[operation];
+
+        for (const std::uint32_t child : { first[operation], second[operation] }) {
+            if (child != npos) {
+                std::uint64_t& childCount = counts[child];
+                childCount = count > UINT64_MAX - childCount ? UINT64_MAX : childCount + count;
+            }
+        }
+    }
+
+    for (const auto& [operand, count] : counts) {
+        if (operand != node && GetType(operand) != type) {
+            out.emplace_back(operand, count);
+        }
+    }
+
+    std::ranges::sort(out);
+}
+
+} // Oasis
@@ -19,14 +19,21 @@ Integral<Expression>::Integral(const Expression& integrand, const Expression& di
 {
 }
 
-auto Integral<Expression>::Simplify() const -> std::unique_ptr<Expression>
+auto Integral<Expression>::SimplifyImpl() const -> std::unique_ptr<Expression>
 {
     // Returns simplified Integral
 
     auto simplifiedIntegrand = mostSigOp ? mostSigOp->Simplify() : nullptr;
     auto simplifiedDifferential = leastSigOp ? leastSigOp->Simplify() : nullptr;
 
-    return simplifiedIntegrand->Integrate(*simplifiedDifferential);
+    auto integrated = simplifiedIntegrand->Integrate(*simplifiedDifferential);
+
+    // An integrand with no matching rule integrates to another Integral, which is already simplified.
+    if (integrated == nullptr || integrated->Is<Oasis::Integral>()) {
+        return integrated;
+    }
+
+    return integrated->Simplify();
 }
 
 auto Integral<Expression>::Simplify(const Expression& upper, const Expression& lower) const -> std::unique_ptr<Expression>
@@ -146,15 +153,6 @@ auto Integral<Expression>::Simplify(const Expression& upper, const Expression& l
         */
 }
 
-auto Integral<Expression>::Simplify(tf::Subflow&) const -> std::unique_ptr<Expression>
-{
-    std::unique_ptr<Expression> simplifiedIntegrand, simplifiedDifferential;
-
-    // To be Implemented : Performs Integration on simplified Expression
-
-    return Copy();
-}
-
 auto Integral<Expression>::Specialize(const Expression& other) -> std::unique_ptr<Integral<Expression, Expression>>
 {
     if (!other.Is<Oasis::Integral>()) {
@@ -2,28 +2,210 @@
 // Created by Andrew Nazareth on 2/16/24.
 //
 
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+#include "taskflow/taskflow.hpp"
+
 #include "Oasis/Linear.hpp"
 #include "Oasis/Add.hpp"
 #include "Oasis/Multiply.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Runtime.hpp"
 #include "Oasis/Variable.hpp"
 #include "iostream"
 
+namespace {
+
+// The number of equations each task extracts the terms of. Enough to amortize scheduling a task.
+constexpr std::size_t equations_per_task = 256;
+
+// Systems with at least this many equations are solved sparsely if few enough of their
+// coefficients are nonzero. Below it, a dense inverse is cheaper than a sparse decomposition.
+constexpr std::size_t sparse_threshold = 64;
+constexpr std::size_t sparse_density = 8; // at most one in this many coefficients is nonzero
+
+struct LinearTerm {
+    std::string variable;
+    double coefficient;
+};
+
+struct LinearEquation {
+    std::vector<LinearTerm> terms;
+    double constant = 0.0;
+};
+
+struct LinearSystem {
+    std::vector<Eigen::Triplet<double>> coefficients;
+    Oasis::Matrix1D constants;
+    std::map<std::string, Eigen::Index> variables;
+};
+
+auto ExtractTerm(const Oasis::Expression& term, LinearEquation& equation) -> void
+{
+    if (term.Is<Oasis::Real>()) { // real number
+        equation.constant = -1 * static_cast<const Oasis::Real&>(term).GetValue();
+    } else if (term.Is<Oasis::Variable>()) { // variable by itself (coefficient of 1)
+        equation.terms.push_back({ static_cast<const Oasis::Variable&>(term).GetName(), 1 });
+    } else if (term.Is<Oasis::Multiply>()) { // a real number times a variable, in either order
+        const Oasis::Expression* coefficient = term.GetChild(0);
+        const Oasis::Expression* variable = term.GetChild(1);
+
+        if (coefficient == nullptr || variable == nullptr) {
+            return;
+        }
+
+        if (coefficient->Is<Oasis::Variable>()) {
+            std::swap(coefficient, variable);
+        }
+
+        if (coefficient->Is<Oasis::Real>() && variable->Is<Oasis::Variable>()) {
+            equation.terms.push_back({ static_cast<const Oasis::Variable&>(*variable).GetName(), static_cast<const Oasis::Real&>(*coefficient).GetValue() });
+        }
+    }
+}
+
+auto ExtractEquation(const Oasis::Expression& expr) -> LinearEquation
+{
+    LinearEquation equation;
+
+    if (!expr.Is<Oasis::Add>()) {
+        ExtractTerm(expr, equation);
+        return equation;
+    }
+
+    // The operands are shared with the expression, not copied.
+    std::vector<std::shared_ptr<const Oasis::Expression>> terms;
+    const auto generalized = expr.Generalize();
+    static_cast<const Oasis::Add<>&>(*generalized).Flatten(terms);
+
+    for (const auto& term : terms) {
+        ExtractTerm(*term, equation);
+    }
+
+    return equation;
+}
+
+// Extracts the terms of every equation in parallel, then numbers the variables in the order they
+// first occur, so that the columns do not depend on how the work was scheduled.
+auto ExtractSystem(const std::vector<std::unique_ptr<Oasis::Expression>>& exprs, Oasis::Runtime& runtime) -> LinearSystem
+{
+    std::vector<LinearEquation> equations(exprs.size());
+    const std::size_t tasks = (exprs.size() + equations_per_task - 1) / equations_per_task;
+
+    const auto extract = [&exprs, &equations](std::size_t task) {
+        const std::size_t end = std::min((task + 1) * equations_per_task, exprs.size());
+
+        for (std::size_t row = task * equations_per_task; row < end; ++row) {
+            equations[row] = ExtractEquation(*exprs[row]);
+        }
+    };
+
+    if (tasks > 1) {
+        tf::Taskflow taskflow;
+        taskflow.for_each_index(std::size_t { 0 }, tasks, std::size_t { 1 }, extract);
+        runtime.GetExecutor().run(taskflow).wait();
+    } else if (tasks == 1) {
+        extract(0);
+    }
+
+    const auto size = static_cast<Eigen::Index>(exprs.size());
+
+    LinearSystem system;
+    system.constants = Oasis::Matrix1D::Zero(size);
+
+    std::size_t termCount = 0;
+
+    for (const auto& equation : equations) {
+        termCount += equation.terms.size();
+    }
+
+    system.coefficients.reserve(termCount);
+
+    std::unordered_map<std::string, Eigen::Index> columns; // variable name, column in matrix
+    columns.reserve(exprs.size());
+
+    for (Eigen::Index row = 0; row < size; ++row) {
+        auto& equation = equations[static_cast<std::size_t>(row)];
+        system.constants(row) = equation.constant;
+
+        for (auto& term : equation.terms) {
+            const auto column = columns.try_emplace(std::move(term.variable), static_cast<Eigen::Index>(columns.size())).first;
+
+            if (column->second >= size) {
+                throw std::invalid_argument("The system has more variables than equations.");
+            }
+
+            system.coefficients.emplace_back(row, column->second, term.coefficient);
+        }
+    }
+
+    system.variables.insert(columns.begin(), columns.end());
+    return system;
+}
+
+auto AssembleDense(const LinearSystem& system) -> Oasis::MatrixXXD
+{
+    const Eigen::Index size = system.constants.rows();
+    Oasis::MatrixXXD A = Oasis::MatrixXXD::Zero(size, size);
+
+    for (const auto& coefficient : system.coefficients) {
+        A(coefficient.row(), coefficient.col()) = coefficient.value();
+    }
+
+    return A;
+}
+
+auto AssembleSparse(const LinearSystem& system) -> Oasis::SparseMatrixXD
+{
+    const Eigen::Index size = system.constants.rows();
+    Oasis::SparseMatrixXD A(size, size);
+
+    // Like the dense matrix, a variable that occurs twice in an equation keeps its last coefficient.
+    A.setFromTriplets(system.coefficients.begin(), system.coefficients.end(), [](const double&, const double& last) { return last; });
+
+    return A;
+}
+
+}
+
 namespace Oasis {
 
 auto SolveLinearSystems(std::vector<std::unique_ptr<Expression>>& exprs) -> std::map<std::string, double>
+{
+    return SolveLinearSystems(exprs, Runtime::Current());
+}
+
+auto SolveLinearSystems(std::vector<std::unique_ptr<Expression>>& exprs, Runtime& runtime) -> std::map<std::string, double>
 {
     for (auto& expr : exprs) {
         expr = expr->Simplify();
     }
-    auto matrices = ConstructMatrices(exprs);
-    auto A = matrices.first.first;
-    auto b = matrices.first.second;
-    auto varMap = matrices.second;
+    auto system = ExtractSystem(exprs, runtime);
+    auto b = system.constants;
+    auto varMap = system.variables;
+
+    const bool sparse = exprs.size() >= sparse_threshold && system.coefficients.size() * sparse_density <= exprs.size() * exprs.size();
 
     // get result vector from A^{-1}*b=x
-    Matrix1D x = SolveLinearSystems(A, b);
+    Matrix1D x;
+
+    if (sparse) {
+        auto A = AssembleSparse(system);
+        x = SolveLinearSystems(A, b);
+    } else {
+        auto A = AssembleDense(system);
+        x = SolveLinearSystems(A, b);
+    }
 
     std::map<std::string, double> values;
+
+    if (x.size() == 0) {
+        return values;
+    }
+
     for (auto& kv : varMap) {
         auto key = kv.first;
         auto index = kv.second;
@@ -37,49 +219,25 @@ auto SolveLinearSystems(std::vector<std::unique_ptr<Expression>>& exprs) -> std:
 auto ConstructMatrices(const std::vector<std::unique_ptr<Expression>>& exprs)
     -> std::pair<std::pair<MatrixXXD, Matrix1D>, std::map<std::string, Eigen::Index>>
 {
-    size_t numRows = exprs.size();
-    size_t numCols = exprs.size();
+    auto system = ExtractSystem(exprs, Runtime::Current());
+    auto A = AssembleDense(system);
 
-    MatrixXXD A(numRows, numCols);
-    Matrix1D b(numRows);
+    return std::make_pair(std::make_pair(std::move(A), std::move(system.constants)), std::move(system.variables));
+}
 
-    // init to 0 (to prevent unwanted behavior)
-    for (Eigen::Index r = 0; r < A.rows(); r++) {
-        for (Eigen::Index c = 0; c < A.cols(); c++) {
-            A(r, c) = 0.0;
-        }
-    }
-    for (Eigen::Index c = 0; c < b.rows(); c++) {
-        b(c) = 0.0;
-    }
+auto ConstructSparseMatrices(const std::vector<std::unique_ptr<Expression>>& exprs)
+    -> std::pair<std::pair<SparseMatrixXD, Matrix1D>, std::map<std::string, Eigen::Index>>
+{
+    return ConstructSparseMatrices(exprs, Runtime::Current());
+}
 
-    size_t varCount = 0;
-    std::map<std::string, Eigen::Index> vars; // variable name, column in matrix
-    for (size_t row = 0; row < exprs.size(); row++) {
-        std::vector<std::unique_ptr<Expression>> terms;
-        auto expr = Add<Expression>::Specialize(*exprs[row]);
-        expr->Flatten(terms);
-        for (auto& term : terms) {
-            if (auto r = Real::Specialize(*term); r != nullptr) { // real number
-                b[Eigen::Index(row)] = -1 * r->GetValue();
-            } else if (auto v = Variable::Specialize(*term); v != nullptr) { // variable by itself (coefficient of 1)
-                std::pair<size_t, bool> keyloc = GetMapValue<std::string, Eigen::Index>(vars, v->GetName(), varCount);
-                if (keyloc.second)
-                    varCount++;
-                A(Eigen::Index(row), Eigen::Index(keyloc.first)) = 1;
-            } else if (auto exprV = Multiply<Real, Variable>::Specialize(*term); exprV != nullptr) {
-                // any expression times a variable
-                std::pair<size_t, bool> keyloc = GetMapValue<std::string, Eigen::Index>(vars,
-                    exprV->GetLeastSigOp().GetName(),
-                    varCount);
-                if (keyloc.second)
-                    varCount++;
-                A(Eigen::Index(row), Eigen::Index(keyloc.first)) = exprV->GetMostSigOp().GetValue();
-            }
-        }
-    }
+auto ConstructSparseMatrices(const std::vector<std::unique_ptr<Expression>>& exprs, Runtime& runtime)
+    -> std::pair<std::pair<SparseMatrixXD, Matrix1D>, std::map<std::string, Eigen::Index>>
+{
+    auto system = ExtractSystem(exprs, runtime);
+    auto A = AssembleSparse(system);
 
-    return std::make_pair(std::make_pair(A, b), vars);
+    return std::make_pair(std::make_pair(std::move(A), std::move(system.constants)), std::move(system.variables));
 }
 
 auto SolveLinearSystems(MatrixXXD& matrix) -> Matrix1D
@@ -113,7 +271,30 @@ auto SolveLinearSystems(MatrixXXD& matrixA, Matrix1D& matrixb) -> Matrix1D
     if (matrixA.rows() != matrixb.rows())
         return Matrix1D {};
 
-    Matrix1D x = matrixA.inverse() * matrixb;
+    const auto lu = matrixA.fullPivLu();
+
+    if (!lu.isInvertible())
+        return Matrix1D {}; // singular, like the sparse solver
+
+    Matrix1D x = lu.solve(matrixb);
+
+    return x;
+}
+
+auto SolveLinearSystems(SparseMatrixXD& matrixA, Matrix1D& matrixb) -> Matrix1D
+{
+    if (matrixA.rows() != matrixb.rows() || matrixA.rows() != matrixA.cols())
+        return Matrix1D {};
+
+    matrixA.makeCompressed();
+
+    Eigen::SparseLU<SparseMatrixXD> solver;
+    solver.compute(matrixA);
+
+    if (solver.info() != Eigen::Success)
+        return Matrix1D {}; // singular
+
+    Matrix1D x = solver.solve(matrixb);
 
     return x;
 }
@@ -6,6 +6,7 @@
 #include "Oasis/Log.hpp"
 #include "Oasis/Exponent.hpp"
 #include "Oasis/Expression.hpp"
+#include "Oasis/Match.hpp"
 #include "Oasis/Multiply.hpp"
 #include "Oasis/Undefined.hpp"
 #include <cmath>
@@ -16,7 +17,7 @@ Log<Expression>::Log(const Expression& base, const Expression& argument)
 {
 }
 
-auto Log<Expression>::Simplify() const -> std::unique_ptr<Expression>
+auto Log<Expression>::SimplifyImpl() const -> std::unique_ptr<Expression>
 {
     const auto simplifiedBase = mostSigOp ? mostSigOp->Simplify() : nullptr;
     const auto simplifiedArgument = leastSigOp ? leastSigOp->Simplify() : nullptr;
@@ -27,13 +28,13 @@ auto Log<Expression>::Simplify() const -> std::unique_ptr<Expression>
 
     const Log simplifiedLog { *simplifiedBase, *simplifiedArgument };
 
-    if (const auto realBaseCase = Log<Real, Expression>::Specialize(simplifiedLog); realBaseCase != nullptr) {
+    if (const auto realBaseCase = Match<Log<Real, Expression>>(simplifiedLog)) {
         if (const Real& b = realBaseCase->GetMostSigOp(); b.GetValue() <= 0.0 || b.GetValue() == 1) {
             return std::make_unique<Undefined>();
         }
     }
 
-    if (const auto realExponentCase = Log<Expression, Real>::Specialize(simplifiedLog); realExponentCase != nullptr) {
+    if (const auto realExponentCase = Match<Log<Expression, Real>>(simplifiedLog)) {
         const Real& argument = realExponentCase->GetLeastSigOp();
 
         if (argument.GetValue() <= 0.0) {
@@ -45,7 +46,7 @@ auto Log<Expression>::Simplify() const -> std::unique_ptr<Expression>
         }
     }
 
-    if (const auto realCase = Log<Real>::Specialize(simplifiedLog); realCase != nullptr) {
+    if (const auto realCase = Match<Log<Real>>(simplifiedLog)) {
         const Real& base = realCase->GetMostSigOp();
         const Real& argument = realCase->GetLeastSigOp();
 
@@ -53,7 +54,7 @@ auto Log<Expression>::Simplify() const -> std::unique_ptr<Expression>
     }
 
     // log[a](b^x) = x * log[a](b)
-    if (const auto expCase = Log<Expression, Exponent<>>::Specialize(simplifiedLog); expCase != nullptr) {
+    if (const auto expCase = Match<Log<Expression, Exponent<>>>(simplifiedLog)) {
         const auto exponent = expCase->GetLeastSigOp();
         const IExpression auto& log = Log<Expression>(expCase->GetMostSigOp(), exponent.GetMostSigOp()); // might need to check that it isnt nullptr
         const IExpression auto& factor = exponent.GetLeastSigOp();
@@ -63,11 +64,6 @@ auto Log<Expression>::Simplify() const -> std::unique_ptr<Expression>
     return simplifiedLog.Copy();
 }
 
-auto Log<Expression>::Simplify(tf::Subflow& subflow) const -> std::unique_ptr<Expression>
-{
-    return Copy(subflow);
-}
-
 auto Log<Expression>::Specialize(const Expression& other) -> std::unique_ptr<Log>
 {
     if (!other.Is<Oasis::Log>()) {
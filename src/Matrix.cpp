@@ -44,7 +44,20 @@ auto Matrix::Equals(const Expression& other) const -> bool
         && matrix == dynamic_cast<const Matrix&>(other).matrix;
 }
 
-auto Matrix::GetMatrix() const -> MatrixXXD
+auto Matrix::ComputeHash() const -> std::size_t
+{
+    std::size_t hash = CombineHash(Expression::ComputeHash(), static_cast<std::size_t>(matrix.rows()));
+    hash = CombineHash(hash, static_cast<std::size_t>(matrix.cols()));
+
+    for (Eigen::Index i = 0; i < matrix.size(); ++i) {
+        const double entry = matrix.data()[i];
+        hash = CombineHash(hash, std::hash<double> {}(entry == 0.0 ? 0.0 : entry));
+    }
+
+    return hash;
+}
+
+auto Matrix::GetMatrix() const -> const MatrixXXD&
 {
     return matrix;
 }
@@ -5,7 +5,7 @@ namespace Oasis {
 Modulo<Expression, Expression>::Modulo(const Expression& dividend, const Expression& divisor)
     : BinaryExpression(dividend, divisor) {}
 
-auto Modulo<Expression, Expression>::Simplify() const -> std::unique_ptr<Expression> {
+auto Modulo<Expression, Expression>::SimplifyImpl() const -> std::unique_ptr<Expression> {
     if (this->GetLeastSigOp().IsZero()) {
         throw std::runtime_error("Division by zero in modulo operation.");
     }
@@ -21,7 +21,7 @@ auto Modulo<Expression, Expression>::Simplify() const -> std::unique_ptr<Express
     return nullptr; // No further simplification possible
 }
 
-auto Modulo<Expression, Expression>::Simplify(tf::Subflow& subflow) const -> std::unique_ptr<Expression> {
+auto Modulo<Expression, Expression>::SimplifyImpl(tf::Subflow& subflow) const -> std::unique_ptr<Expression> {
     auto result = std::make_unique<Modulo>(*this);
 
     subflow.emplace([&]() {
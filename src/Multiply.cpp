@@ -2,11 +2,15 @@
 // Created by Matthew McCall on 8/10/23.
 //
 
+#include <optional>
+#include <unordered_map>
+
 #include "Oasis/Multiply.hpp"
 #include "Oasis/Add.hpp"
 #include "Oasis/Exponent.hpp"
 #include "Oasis/Imaginary.hpp"
 #include "Oasis/Integral.hpp"
+#include "Oasis/Match.hpp"
 #include "Oasis/Matrix.hpp"
 #include "Oasis/Negate.hpp"
 #include "Oasis/Subtract.hpp"
@@ -15,13 +19,13 @@
 
 namespace Oasis {
 
-auto Multiply<Expression>::Simplify() const -> std::unique_ptr<Expression>
+auto Multiply<Expression>::SimplifyImpl() const -> std::unique_ptr<Expression>
 {
     auto simplifiedMultiplicand = mostSigOp->Simplify();
     auto simplifiedMultiplier = leastSigOp->Simplify();
 
     Multiply simplifiedMultiply { *simplifiedMultiplicand, *simplifiedMultiplier };
-    if (auto onezerocase = Multiply<Real, Expression>::Specialize(simplifiedMultiply); onezerocase != nullptr) {
+    if (auto onezerocase = Match<Multiply<Real, Expression>>(simplifiedMultiply)) {
         const Real& multiplicand = onezerocase->GetMostSigOp();
         const Expression& multiplier = onezerocase->GetLeastSigOp();
         if (std::abs(multiplicand.GetValue()) <= EPSILON) {
@@ -31,26 +35,26 @@ auto Multiply<Expression>::Simplify() const -> std::unique_ptr<Expression>
             return multiplier.Simplify();
         }
     }
-    if (auto realCase = Multiply<Real>::Specialize(simplifiedMultiply); realCase != nullptr) {
+    if (auto realCase = Match<Multiply<Real>>(simplifiedMultiply)) {
         const Real& multiplicand = realCase->GetMostSigOp();
         const Real& multiplier = realCase->GetLeastSigOp();
         return std::make_unique<Real>(multiplicand.GetValue() * multiplier.GetValue());
     }
 
-    if (auto ImgCase = Multiply<Imaginary>::Specialize(simplifiedMultiply); ImgCase != nullptr) {
+    if (auto ImgCase = Match<Multiply<Imaginary>>(simplifiedMultiply)) {
         return std::make_unique<Real>(-1.0);
     }
-    if (auto exprCase = Multiply<Expression>::Specialize(simplifiedMultiply); exprCase != nullptr) {
+    if (auto exprCase = Match<Multiply<Expression>>(simplifiedMultiply)) {
         if (exprCase->GetMostSigOp().Equals(exprCase->GetLeastSigOp())) {
-            return std::make_unique<Exponent<Expression, Expression>>(exprCase->GetMostSigOp(), Real { 2.0 });
+            return Exponent<Expression> { exprCase->GetMostSigOp(), Real { 2.0 } }.Simplify();
         }
     }
 
-    if (auto rMatrixCase = Multiply<Real, Matrix>::Specialize(simplifiedMultiply); rMatrixCase != nullptr) {
+    if (auto rMatrixCase = Match<Multiply<Real, Matrix>>(simplifiedMultiply)) {
         return std::make_unique<Matrix>(rMatrixCase->GetLeastSigOp().GetMatrix() * rMatrixCase->GetMostSigOp().GetValue());
     }
 
-    if (auto matrixCase = Multiply<Matrix, Matrix>::Specialize(simplifiedMultiply); matrixCase != nullptr) {
+    if (auto matrixCase = Match<Multiply<Matrix, Matrix>>(simplifiedMultiply)) {
         const Oasis::IExpression auto& leftTerm = matrixCase->GetMostSigOp();
         const Oasis::IExpression auto& rightTerm = matrixCase->GetLeastSigOp();
 
@@ -64,7 +68,7 @@ auto Multiply<Expression>::Simplify() const -> std::unique_ptr<Expression>
 
     //    Commented out to not cause massive problems with things that need factored expressions
     //    // c*(a-b)
-    //    if (auto negated = Multiply<Real, Subtract<Expression>>::Specialize(simplifiedMultiply); negated != nullptr) {
+    //    if (auto negated = Match<Multiply<Real, Subtract<Expression>>>(simplifiedMultiply)) {
     //        if (negated->GetMostSigOp().GetValue()<0){
     //            return Add{Multiply{negated->GetMostSigOp(), negated->GetLeastSigOp().GetMostSigOp()},
     //                       Multiply{negated->GetMostSigOp(), negated->GetLeastSigOp().GetLeastSigOp()}}.Simplify();
@@ -78,289 +82,221 @@ auto Multiply<Expression>::Simplify() const -> std::unique_ptr<Expression>
     //    }
     //
     //    // c*(a+b)
-    //    if (auto negated = Multiply<Real, Add<Expression>>::Specialize(simplifiedMultiply); negated != nullptr) {
+    //    if (auto negated = Match<Multiply<Real, Add<Expression>>>(simplifiedMultiply)) {
     //        return Add{Multiply{negated->GetMostSigOp(), negated->GetLeastSigOp().GetMostSigOp()},
     //                   Multiply{negated->GetMostSigOp(), negated->GetLeastSigOp().GetLeastSigOp()}}.Simplify();
     //    }
 
-    if (auto exprCase = Multiply<Expression, Exponent<Expression, Expression>>::Specialize(simplifiedMultiply); exprCase != nullptr) {
+    if (auto exprCase = Match<Multiply<Expression, Exponent<Expression, Expression>>>(simplifiedMultiply)) {
         if (exprCase->GetMostSigOp().Equals(exprCase->GetLeastSigOp().GetMostSigOp())) {
-            return std::make_unique<Exponent<Expression>>(exprCase->GetMostSigOp(),
-                *(Add<Expression> { exprCase->GetLeastSigOp().GetLeastSigOp(), Real { 1.0 } }.Simplify()));
+            return Exponent<Expression> { exprCase->GetMostSigOp(),
+                *(Add<Expression> { exprCase->GetLeastSigOp().GetLeastSigOp(), Real { 1.0 } }.Simplify()) }
+                .Simplify();
         }
     }
 
     // x*x^n
-    if (auto exprCase = Multiply<Expression, Exponent<Expression>>::Specialize(simplifiedMultiply); exprCase != nullptr) {
+    if (auto exprCase = Match<Multiply<Expression, Exponent<Expression>>>(simplifiedMultiply)) {
         if (exprCase->GetMostSigOp().Equals(exprCase->GetLeastSigOp().GetMostSigOp())) {
-            return std::make_unique<Exponent<Expression>>(exprCase->GetMostSigOp(),
-                *(Add<Expression> { exprCase->GetLeastSigOp().GetLeastSigOp(), Real { 1.0 } }.Simplify()));
+            return Exponent<Expression> { exprCase->GetMostSigOp(),
+                *(Add<Expression> { exprCase->GetLeastSigOp().GetLeastSigOp(), Real { 1.0 } }.Simplify()) }
+                .Simplify();
         }
     }
 
-    if (auto exprCase = Multiply<Exponent<Expression>, Expression>::Specialize(simplifiedMultiply); exprCase != nullptr) {
+    if (auto exprCase = Match<Multiply<Exponent<Expression>, Expression>>(simplifiedMultiply)) {
         if (exprCase->GetLeastSigOp().Equals(exprCase->GetMostSigOp().GetMostSigOp())) {
-            return std::make_unique<Exponent<Expression>>(exprCase->GetLeastSigOp(),
-                *(Add<Expression> { exprCase->GetMostSigOp().GetLeastSigOp(), Real { 1.0 } }.Simplify()));
+            return Exponent<Expression> { exprCase->GetLeastSigOp(),
+                *(Add<Expression> { exprCase->GetMostSigOp().GetLeastSigOp(), Real { 1.0 } }.Simplify()) }
+                .Simplify();
         }
     }
 
     // x^n*x^m
-    if (auto exprCase = Multiply<Exponent<Expression>, Exponent<Expression>>::Specialize(simplifiedMultiply); exprCase != nullptr) {
+    if (auto exprCase = Match<Multiply<Exponent<Expression>, Exponent<Expression>>>(simplifiedMultiply)) {
         if (exprCase->GetMostSigOp().GetMostSigOp().Equals(exprCase->GetLeastSigOp().GetMostSigOp())) {
-            return std::make_unique<Exponent<Expression>>(exprCase->GetMostSigOp().GetMostSigOp(),
-                *(Add<Expression> { exprCase->GetMostSigOp().GetLeastSigOp(), exprCase->GetLeastSigOp().GetLeastSigOp() }.Simplify()));
+            return Exponent<Expression> { exprCase->GetMostSigOp().GetMostSigOp(),
+                *(Add<Expression> { exprCase->GetMostSigOp().GetLeastSigOp(), exprCase->GetLeastSigOp().GetLeastSigOp() }.Simplify()) }
+                .Simplify();
         }
     }
 
     // a*x*x
-    if (auto exprCase = Multiply<Multiply<Expression>, Expression>::Specialize(simplifiedMultiply); exprCase != nullptr) {
+    if (auto exprCase = Match<Multiply<Multiply<Expression>, Expression>>(simplifiedMultiply)) {
         if (exprCase->GetMostSigOp().GetLeastSigOp().Equals(exprCase->GetLeastSigOp())) {
-            return std::make_unique<Multiply<Expression, Expression>>(exprCase->GetMostSigOp().GetMostSigOp(),
-                Exponent<Expression> { exprCase->GetMostSigOp().GetLeastSigOp(), Real { 2.0 } });
+            return Multiply<Expression> { exprCase->GetMostSigOp().GetMostSigOp(),
+                Exponent<Expression> { exprCase->GetMostSigOp().GetLeastSigOp(), Real { 2.0 } } }
+                .Simplify();
         }
     }
 
     // a*x*b*x
-    if (auto exprCase = Multiply<Multiply<Expression>, Multiply<Expression>>::Specialize(simplifiedMultiply); exprCase != nullptr) {
+    if (auto exprCase = Match<Multiply<Multiply<Expression>, Multiply<Expression>>>(simplifiedMultiply)) {
         if (exprCase->GetMostSigOp().GetLeastSigOp().Equals(exprCase->GetLeastSigOp().GetLeastSigOp())) {
-            return std::make_unique<Multiply<Expression>>(
+            return Multiply<Expression> {
                 *(Multiply<Expression> { exprCase->GetMostSigOp().GetMostSigOp(), exprCase->GetLeastSigOp().GetMostSigOp() }.Simplify()),
-                *(Exponent<Expression> { exprCase->GetMostSigOp().GetLeastSigOp(), Real { 2.0 } }.Simplify()));
+                *(Exponent<Expression> { exprCase->GetMostSigOp().GetLeastSigOp(), Real { 2.0 } }.Simplify()) }
+                .Simplify();
         }
     }
 
     // a*x^n*x
-    if (auto exprCase = Multiply<Multiply<Expression, Exponent<Expression>>, Expression>::Specialize(simplifiedMultiply); exprCase != nullptr) {
+    if (auto exprCase = Match<Multiply<Multiply<Expression, Exponent<Expression>>, Expression>>(simplifiedMultiply)) {
         if (exprCase->GetMostSigOp().GetLeastSigOp().GetMostSigOp().Equals(exprCase->GetLeastSigOp())) {
-            return std::make_unique<Multiply<Expression>>(exprCase->GetMostSigOp().GetMostSigOp(),
+            return Multiply<Expression> { exprCase->GetMostSigOp().GetMostSigOp(),
                 Exponent<Expression> { exprCase->GetMostSigOp().GetLeastSigOp().GetMostSigOp(),
-                    *(Add<Expression> { exprCase->GetMostSigOp().GetLeastSigOp().GetLeastSigOp(), Real { 1.0 } }.Simplify()) });
+                    *(Add<Expression> { exprCase->GetMostSigOp().GetLeastSigOp().GetLeastSigOp(), Real { 1.0 } }.Simplify()) } }
+                .Simplify();
         }
     }
 
     // a*x*x^n
-    if (auto exprCase = Multiply<Multiply<Expression>, Exponent<Expression>>::Specialize(simplifiedMultiply); exprCase != nullptr) {
+    if (auto exprCase = Match<Multiply<Multiply<Expression>, Exponent<Expression>>>(simplifiedMultiply)) {
         if (exprCase->GetMostSigOp().GetLeastSigOp().Equals(exprCase->GetLeastSigOp().GetMostSigOp())) {
-            return std::make_unique<Multiply<Expression>>(exprCase->GetMostSigOp().GetMostSigOp(),
+            return Multiply<Expression> { exprCase->GetMostSigOp().GetMostSigOp(),
                 Exponent<Expression> { exprCase->GetMostSigOp().GetLeastSigOp(),
-                    *(Add<Expression> { exprCase->GetLeastSigOp().GetLeastSigOp(), Real { 1.0 } }.Simplify()) });
+                    *(Add<Expression> { exprCase->GetLeastSigOp().GetLeastSigOp(), Real { 1.0 } }.Simplify()) } }
+                .Simplify();
         }
         if (exprCase->GetMostSigOp().GetMostSigOp().Equals(exprCase->GetLeastSigOp().GetMostSigOp())) {
-            return std::make_unique<Multiply<Expression>>(exprCase->GetMostSigOp().GetLeastSigOp(),
+            return Multiply<Expression> { exprCase->GetMostSigOp().GetLeastSigOp(),
                 Exponent<Expression> { exprCase->GetMostSigOp().GetMostSigOp(),
-                    *(Add<Expression> { exprCase->GetLeastSigOp().GetLeastSigOp(), Real { 1.0 } }.Simplify()) });
+                    *(Add<Expression> { exprCase->GetLeastSigOp().GetLeastSigOp(), Real { 1.0 } }.Simplify()) } }
+                .Simplify();
         }
     }
 
     // a*x^n*b*x
-    if (auto exprCase = Multiply<Multiply<Expression>, Multiply<Expression, Exponent<Expression>>>::Specialize(simplifiedMultiply); exprCase != nullptr) {
+    if (auto exprCase = Match<Multiply<Multiply<Expression>, Multiply<Expression, Exponent<Expression>>>>(simplifiedMultiply)) {
         if (exprCase->GetMostSigOp().GetLeastSigOp().Equals(exprCase->GetLeastSigOp().GetLeastSigOp().GetMostSigOp())) {
-            return std::make_unique<Multiply<Expression>>(
+            return Multiply<Expression> {
                 *(Multiply<Expression> { exprCase->GetMostSigOp().GetMostSigOp(), exprCase->GetLeastSigOp().GetMostSigOp() }.Simplify()),
                 Exponent<Expression> { exprCase->GetMostSigOp().GetLeastSigOp(),
-                    *(Add<Expression> { exprCase->GetLeastSigOp().GetLeastSigOp().GetLeastSigOp(), Real { 1.0 } }.Simplify()) });
+                    *(Add<Expression> { exprCase->GetLeastSigOp().GetLeastSigOp().GetLeastSigOp(), Real { 1.0 } }.Simplify()) } }
+                .Simplify();
         }
     }
 
-    if (auto exprCase = Multiply<Multiply<Expression>, Multiply<Exponent<Expression>, Expression>>::Specialize(simplifiedMultiply); exprCase != nullptr) {
+    if (auto exprCase = Match<Multiply<Multiply<Expression>, Multiply<Exponent<Expression>, Expression>>>(simplifiedMultiply)) {
         if (exprCase->GetMostSigOp().GetLeastSigOp().Equals(exprCase->GetLeastSigOp().GetMostSigOp().GetMostSigOp())) {
-            return std::make_unique<Multiply<Expression>>(
+            return Multiply<Expression> {
                 *(Multiply<Expression> { exprCase->GetMostSigOp().GetMostSigOp(), exprCase->GetLeastSigOp().GetLeastSigOp() }.Simplify()),
                 Exponent<Expression> { exprCase->GetMostSigOp().GetLeastSigOp(),
-                    *(Add<Expression> { exprCase->GetLeastSigOp().GetMostSigOp().GetLeastSigOp(), Real { 1.0 } }.Simplify()) });
+                    *(Add<Expression> { exprCase->GetLeastSigOp().GetMostSigOp().GetLeastSigOp(), Real { 1.0 } }.Simplify()) } }
+                .Simplify();
         }
     }
 
-    if (auto exprCase = Multiply<Multiply<Expression, Exponent<Expression>>, Multiply<Expression>>::Specialize(simplifiedMultiply); exprCase != nullptr) {
+    if (auto exprCase = Match<Multiply<Multiply<Expression, Exponent<Expression>>, Multiply<Expression>>>(simplifiedMultiply)) {
         if (exprCase->GetMostSigOp().GetLeastSigOp().GetMostSigOp().Equals(exprCase->GetLeastSigOp().GetLeastSigOp())) {
-            return std::make_unique<Multiply<Expression>>(
+            return Multiply<Expression> {
                 *(Multiply<Expression> { exprCase->GetMostSigOp().GetMostSigOp(), exprCase->GetLeastSigOp().GetLeastSigOp() }.Simplify()),
                 Exponent<Expression> { exprCase->GetLeastSigOp().GetLeastSigOp(),
-                    *(Add<Expression> { exprCase->GetMostSigOp().GetLeastSigOp().GetLeastSigOp(), Real { 1.0 } }.Simplify()) });
+                    *(Add<Expression> { exprCase->GetMostSigOp().GetLeastSigOp().GetLeastSigOp(), Real { 1.0 } }.Simplify()) } }
+                .Simplify();
         }
     }
 
     // a*x^n*x^m
-    if (auto exprCase = Multiply<Multiply<Expression, Exponent<Expression>>, Exponent<Expression>>::Specialize(simplifiedMultiply); exprCase != nullptr) {
+    if (auto exprCase = Match<Multiply<Multiply<Expression, Exponent<Expression>>, Exponent<Expression>>>(simplifiedMultiply)) {
         if (exprCase->GetMostSigOp().GetLeastSigOp().GetMostSigOp().Equals(exprCase->GetLeastSigOp().GetLeastSigOp())) {
-            return std::make_unique<Multiply<Expression>>(
+            return Multiply<Expression> {
                 exprCase->GetMostSigOp().GetMostSigOp(),
                 Exponent<Expression> { exprCase->GetMostSigOp().GetLeastSigOp().GetMostSigOp(),
-                    *(Add<Expression> { exprCase->GetLeastSigOp().GetMostSigOp(), exprCase->GetMostSigOp().GetLeastSigOp().GetLeastSigOp() }.Simplify()) });
+                    *(Add<Expression> { exprCase->GetLeastSigOp().GetMostSigOp(), exprCase->GetMostSigOp().GetLeastSigOp().GetLeastSigOp() }.Simplify()) } }
+                .Simplify();
         }
     }
 
     // a*x^n*b*x^m
-    if (auto exprCase = Multiply<Multiply<Expression, Exponent<Expression>>, Multiply<Expression, Exponent<Expression>>>::Specialize(simplifiedMultiply); exprCase != nullptr) {
+    if (auto exprCase = Match<Multiply<Multiply<Expression, Exponent<Expression>>, Multiply<Expression, Exponent<Expression>>>>(simplifiedMultiply)) {
         if (exprCase->GetMostSigOp().GetLeastSigOp().GetMostSigOp().Equals(exprCase->GetLeastSigOp().GetLeastSigOp().GetMostSigOp())) {
-            return std::make_unique<Multiply<Expression>>(
+            return Multiply<Expression> {
                 *(Multiply<Expression> { exprCase->GetMostSigOp().GetMostSigOp(), exprCase->GetLeastSigOp().GetMostSigOp() }.Simplify()),
                 Exponent<Expression> { exprCase->GetMostSigOp().GetLeastSigOp().GetMostSigOp(),
-                    *(Add<Expression> { exprCase->GetLeastSigOp().GetLeastSigOp().GetLeastSigOp(), exprCase->GetMostSigOp().GetLeastSigOp().GetLeastSigOp() }.Simplify()) });
+                    *(Add<Expression> { exprCase->GetLeastSigOp().GetLeastSigOp().GetLeastSigOp(), exprCase->GetMostSigOp().GetLeastSigOp().GetLeastSigOp() }.Simplify()) } }
+                .Simplify();
         }
     }
 
-    //    if (auto negate = Multiply<Real, Negate<Subtract<Expression>>>::Specialize(simplifiedMultiply); negate != nullptr){
+    //    if (auto negate = Match<Multiply<Real, Negate<Subtract<Expression>>>>(simplifiedMultiply)){
     //        return Add{Multiply{negate->GetMostSigOp(), negate->GetLeastSigOp().GetOperand().GetMostSigOp()},
     //                   Multiply{negate->GetMostSigOp(), negate->GetLeastSigOp().GetOperand().GetLeastSigOp()}}.Simplify();
     //    }
 
     // multiply add like terms
-    std::vector<std::unique_ptr<Expression>> multiplies;
-    std::vector<std::unique_ptr<Expression>> vals;
+    // Factors are bucketed by their base, so combining n factors takes expected linear time.
+    std::vector<std::shared_ptr<const Expression>> multiplies;
     simplifiedMultiply.Flatten(multiplies);
-    for (const auto& multiplicand : multiplies) {
-        size_t i = 0;
-        if (auto real = Real::Specialize(*multiplicand); real != nullptr) {
-            for (; i < vals.size(); i++) {
-                if (auto valI = Real::Specialize(*vals[i]); valI != nullptr) {
-                    vals[i] = Real { valI->GetValue() * real->GetValue() }.Generalize();
-                    break;
-                }
-            }
-            if (i >= vals.size()) {
-                // check to make sure it is one thing only
-                vals.push_back(multiplicand->Generalize());
-            }
-            continue;
-        }
-        // single i
-        if (auto img = Imaginary::Specialize(*multiplicand); img != nullptr) {
-            for (; i < vals.size(); i++) {
-                if (auto valI = Exponent<Imaginary, Expression>::Specialize(*vals[i]); valI != nullptr) {
-                    vals[i] = Exponent<Expression> { Imaginary {}, *(Add<Expression> { valI->GetLeastSigOp(), Real { 1.0 } }.Simplify()) }.Generalize();
-                    break;
-                }
-            }
-            if (i >= vals.size()) {
-                // check to make sure it is one thing only
-                vals.push_back(Exponent<Expression> { Imaginary {}, Real { 1.0 } }.Generalize());
-            }
-            continue;
-        }
-        // i^n
-        if (auto img = Exponent<Imaginary, Expression>::Specialize(*multiplicand); img != nullptr) {
-            for (; i < vals.size(); i++) {
-                if (auto valI = Exponent<Imaginary, Expression>::Specialize(*vals[i]); valI != nullptr) {
-                    vals[i] = Exponent<Expression> { Imaginary {}, *(Add<Expression> { valI->GetLeastSigOp(), img->GetLeastSigOp() }.Simplify()) }.Generalize();
-                    break;
-                }
-            }
-            if (i >= vals.size()) {
-                // check to make sure it is one thing only
-                // vals.push_back(Multiply<Expression> { img->GetMostSigOp(), Imaginary {} }.Generalize());
-                vals.push_back(img->Generalize());
-            }
-            continue;
+
+    std::vector<std::unique_ptr<Expression>> vals;
+    std::vector<std::unique_ptr<Expression>> bases;
+    std::vector<std::unique_ptr<Expression>> powers;
+    std::unordered_map<const Expression*, std::size_t, ExpressionHash, ExpressionEqual> baseIndices;
+    std::optional<std::size_t> constantIndex;
+
+    const auto addLikeFactor = [&](const Expression& base, const Expression& power) {
+        if (const auto it = baseIndices.find(&base); it != baseIndices.end()) {
+            powers[it->second] = Add<Expression> { *powers[it->second], power }.Simplify();
+            return;
         }
-        // expr^n
-        if (auto expr = Exponent<Expression, Expression>::Specialize(*multiplicand); expr != nullptr) {
-            for (; i < vals.size(); i++) {
-                if (auto valI = Exponent<Expression, Expression>::Specialize(*vals[i]); valI != nullptr) {
-                    if (valI->GetMostSigOp().Equals(expr->GetMostSigOp())) {
-                        vals[i] = Exponent<Expression> { valI->GetMostSigOp(), *(Add<Expression> { valI->GetLeastSigOp(), expr->GetLeastSigOp() }.Simplify()) }.Generalize();
-                        break;
-                    }
-                }
-            }
-            if (i >= vals.size()) {
-                // check to make sure it is one thing only
-                // vals.push_back(Multiply<Expression> { img->GetMostSigOp(), Imaginary {} }.Generalize());
-                vals.push_back(expr->Generalize());
+
+        baseIndices.emplace(bases.emplace_back(base.Generalize()).get(), vals.size());
+        powers.push_back(power.Generalize());
+        vals.emplace_back(nullptr);
+    };
+
+    for (const auto& multiplicand : multiplies) {
+        if (auto real = Match<Real>(*multiplicand)) {
+            if (constantIndex) {
+                vals[*constantIndex] = Real { Match<Real>(*vals[*constantIndex])->GetValue() * real->GetValue() }.Generalize();
+            } else {
+                constantIndex = vals.size();
+                vals.push_back(real->Generalize());
+                bases.emplace_back(nullptr);
+                powers.emplace_back(nullptr);
             }
-            continue;
+        } else if (auto expr = Match<Exponent<Expression, Expression>>(*multiplicand)) {
+            // i^n and expr^n
+            addLikeFactor(expr->GetMostSigOp(), expr->GetLeastSigOp());
+        } else {
+            // single i and single expr
+            addLikeFactor(*multiplicand, Real { 1.0 });
         }
-        // single expr
-        if (auto expr = Expression::Specialize(*multiplicand); expr != nullptr) {
-            for (; i < vals.size(); i++) {
-                if (auto valI = Exponent<Expression, Expression>::Specialize(*vals[i]); valI != nullptr) {
-                    if (valI->GetMostSigOp().Equals(*expr)) {
-                        vals[i] = Exponent<Expression> { valI->GetMostSigOp(), *(Add<Expression> { valI->GetLeastSigOp(), Real { 1.0 } }.Simplify()) }.Generalize();
-                        break;
-                    }
-                }
-            }
-            if (i >= vals.size()) {
-                // check to make sure it is one thing only
-                vals.push_back(Exponent<Expression> { *expr, Real { 1.0 } }.Generalize());
-            }
-            continue;
+    }
+
+    for (std::size_t i = 0; i < vals.size(); ++i) {
+        if (bases[i] != nullptr) {
+            vals[i] = Exponent<Expression> { *bases[i], *powers[i] }.Simplify();
         }
     }
 
     // makes all expr^1 into expr
     for (auto& val : vals) {
-        if (auto exp = Exponent<Expression, Real>::Specialize(*val); exp != nullptr) {
+        if (auto exp = Match<Exponent<Expression, Real>>(*val)) {
             if (exp->GetLeastSigOp().GetValue() == 1.0) {
                 val = exp->GetMostSigOp().Generalize();
             }
         }
-        if (auto mul = Multiply<Real, Expression>::Specialize(*val); mul != nullptr) {
+        if (auto mul = Match<Multiply<Real, Expression>>(*val)) {
             if (mul->GetMostSigOp().GetValue() == 1.0) {
                 val = mul->GetLeastSigOp().Generalize();
             }
         }
     }
 
-    return BuildFromVector<Multiply>(vals);
-
-    // return simplifiedMultiply.Copy();
-}
-
-auto Multiply<Expression>::Simplify(tf::Subflow& subflow) const -> std::unique_ptr<Expression>
-{
-    std::unique_ptr<Expression> simplifiedMultiplicand, simplifiedMultiplier;
-
-    tf::Task leftSimplifyTask = subflow.emplace([this, &simplifiedMultiplicand](tf::Subflow& sbf) {
-        if (!mostSigOp) {
-            return;
+    if (auto vec = BuildFromVector<Multiply>(vals); vec != nullptr) {
+        // an unchanged product keeps its simplified operands
+        if (vec->Identical(simplifiedMultiply)) {
+            return simplifiedMultiply.Copy();
         }
 
-        simplifiedMultiplicand = mostSigOp->Simplify(sbf);
-    });
-
-    tf::Task rightSimplifyTask = subflow.emplace([this, &simplifiedMultiplier](tf::Subflow& sbf) {
-        if (!leastSigOp) {
-            return;
-        }
-
-        simplifiedMultiplier = leastSigOp->Simplify(sbf);
-    });
-
-    Multiply simplifiedMultiply;
-
-    // While this task isn't actually parallelized, it exists as a prerequisite for check possible cases in parallel
-    tf::Task simplifyTask = subflow.emplace([&simplifiedMultiply, &simplifiedMultiplicand, &simplifiedMultiplier](tf::Subflow&) {
-        if (simplifiedMultiplicand) {
-            simplifiedMultiply.SetMostSigOp(*simplifiedMultiplicand);
-        }
-
-        if (simplifiedMultiplier) {
-            simplifiedMultiply.SetLeastSigOp(*simplifiedMultiplier);
-        }
-    });
-
-    simplifyTask.succeed(leftSimplifyTask, rightSimplifyTask);
-
-    std::unique_ptr<Multiply<Real>> realCase;
-
-    tf::Task realCaseTask = subflow.emplace([&simplifiedMultiply, &realCase](tf::Subflow& sbf) {
-        realCase = Multiply<Real>::Specialize(simplifiedMultiply, sbf);
-    });
-
-    simplifyTask.precede(realCaseTask);
-
-    subflow.join();
-
-    if (realCase) {
-        const Real& multiplicand = realCase->GetMostSigOp();
-        const Real& multiplier = realCase->GetLeastSigOp();
-
-        return std::make_unique<Real>(multiplicand.GetValue() * multiplier.GetValue());
+        return vec;
     }
 
-    return simplifiedMultiply.Copy();
+    return std::move(vals.front());
+
+    // return simplifiedMultiply.Copy();
 }
 
 auto Multiply<Expression>::Specialize(const Expression& other) -> std::unique_ptr<Multiply<Expression, Expression>>
@@ -27,6 +27,13 @@ auto Real::Equals(const Expression& other) const -> bool
     return other.Is<Real>() && value == dynamic_cast<const Real&>(other).value;
 }
 
+auto Real::ComputeHash() const -> std::size_t
+{
+    // 0.0 and -0.0 compare equal, so they must hash alike.
+    const double normalized = value == 0.0 ? 0.0 : value;
+    return CombineHash(Expression::ComputeHash(), std::hash<double> {}(normalized));
+}
+
 auto Real::GetValue() const -> double
 {
     return value;
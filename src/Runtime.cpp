@@ -0,0 +1,130 @@
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "taskflow/taskflow.hpp"
+
+#include "Oasis/Runtime.hpp"
+
+namespace Oasis {
+
+namespace {
+
+    std::atomic<Runtime*> installedRuntime = nullptr;
+
+    // Simplifying a few hundred nodes takes roughly as long as scheduling a handful of tasks.
+    std::atomic<std::size_t> sequentialCutoff = 256;
+
+    // Pins each worker to a CPU as the worker starts.
+    class PinningWorkerInterface : public tf::WorkerInterface {
+    public:
+        PinningWorkerInterface(std::vector<std::size_t> cpus, std::shared_ptr<std::atomic<std::size_t>> failures)
+            : cpus(std::move(cpus))
+            , failures(std::move(failures))
+        {
+        }
+
+        void scheduler_prologue([[maybe_unused]] tf::Worker& worker) override
+        {
+#ifdef __linux__
+            // The constructor of Runtime rejects CPUs that do not fit in a cpu_set_t.
+            cpu_set_t set;
+            CPU_ZERO(&set);
+            CPU_SET(cpus[worker.id() % cpus.size()], &set);
+
+            if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+                failures->fetch_add(1, std::memory_order_relaxed);
+            }
+#endif
+        }
+
+        void scheduler_epilogue(tf::Worker&, std::exception_ptr) override { }
+
+    private:
+        std::vector<std::size_t> cpus;
+        std::shared_ptr<std::atomic<std::size_t>> failures;
+    };
+
+} // namespace
+
+Runtime::Runtime()
+    : Runtime(std::max(std::thread::hardware_concurrency(), 1U))
+{
+}
+
+Runtime::Runtime(std::size_t workers, std::vector<std::size_t> cpus)
+    : pinningFailures(std::make_shared<std::atomic<std::size_t>>(0))
+{
+    std::shared_ptr<tf::WorkerInterface> workerInterface;
+
+#ifdef __linux__
+    if (std::ranges::any_of(cpus, [](std::size_t cpu) { return cpu >= CPU_SETSIZE; })) {
+        throw std::invalid_argument("CPU index is out of range.");
+    }
+#endif
+
+    if (!cpus.empty()) {
+        workerInterface = std::make_shared<PinningWorkerInterface>(std::move(cpus), pinningFailures);
+    }
+
+    executor = std::make_unique<tf::Executor>(std::max<std::size_t>(workers, 1), std::move(workerInterface));
+}
+
+Runtime::~Runtime()
+{
+    Runtime* self = this;
+    installedRuntime.compare_exchange_strong(self, nullptr);
+}
+
+auto Runtime::Install(Runtime* runtime) -> Runtime*
+{
+    return installedRuntime.exchange(runtime);
+}
+
+auto Runtime::Current() -> Runtime&
+{
+    if (Runtime* runtime = installedRuntime.load(std::memory_order_acquire); runtime != nullptr) {
+        return *runtime;
+    }
+
+    return Default();
+}
+
+auto Runtime::Default() -> Runtime&
+{
+    static Runtime runtime;
+    return runtime;
+}
+
+auto Runtime::SetSequentialCutoff(std::size_t nodes) -> void
+{
+    sequentialCutoff.store(nodes, std::memory_order_relaxed);
+}
+
+auto Runtime::GetSequentialCutoff() -> std::size_t
+{
+    return sequentialCutoff.load(std::memory_order_relaxed);
+}
+
+auto Runtime::GetExecutor() -> tf::Executor&
+{
+    return *executor;
+}
+
+auto Runtime::GetWorkerCount() const -> std::size_t
+{
+    return executor->num_workers();
+}
+
+auto Runtime::GetPinningFailures() const -> std::size_t
+{
+    return pinningFailures->load(std::memory_order_relaxed);
+}
+
+} // Oasis
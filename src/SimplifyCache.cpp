@@ -0,0 +1,185 @@
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include "Oasis/ExpressionArena.hpp"
+#include "Oasis/SimplifyCache.hpp"
+
+namespace Oasis {
+
+namespace {
+
+    std::atomic<std::shared_ptr<SimplifyCache>> activeCache;
+
+    // Whether a cache is installed, so that Simplify does not touch the shared pointer otherwise.
+    std::atomic<bool> cacheInstalled = false;
+
+    // The number of calls to Simplify in progress on this thread.
+    thread_local std::size_t simplifyDepth = 0;
+
+    // A rough per-node footprint: the node itself and the control block of the shared pointer
+    // that owns it.
+    constexpr std::size_t NodeSizeEstimate = 128;
+
+    auto EstimateSize(const Expression& expression) -> std::size_t
+    {
+        // Shared subexpressions are counted once per use, so saturate rather than overflow.
+        const std::size_t nodes = expression.NodeCount();
+
+        if (nodes > std::numeric_limits<std::size_t>::max() / NodeSizeEstimate) {
+            return std::numeric_limits<std::size_t>::max();
+        }
+
+        return nodes * NodeSizeEstimate;
+    }
+
+    // Arena nodes must never be retained by the cache, so while any arena is alive, entries are
+    // deep-copied to the heap. Otherwise, copying only the root and sharing its operands suffices.
+    auto Retain(const Expression& expression) -> std::shared_ptr<const Expression>
+    {
+        if (ExpressionArena::InUse()) {
+            return ExpressionArena::Promote(expression);
+        }
+
+        return expression.Copy();
+    }
+
+} // namespace
+
+SimplifyCache::SimplifyCache(std::size_t maxEntries, std::size_t maxBytes)
+    : maxEntries(maxEntries)
+    , maxBytes(maxBytes)
+{
+}
+
+SimplifyCache::Scope::Scope()
+{
+    ++simplifyDepth;
+}
+
+SimplifyCache::Scope::~Scope()
+{
+    --simplifyDepth;
+}
+
+auto SimplifyCache::Install(std::shared_ptr<SimplifyCache> cache) -> std::shared_ptr<SimplifyCache>
+{
+    cacheInstalled.store(cache != nullptr, std::memory_order_relaxed);
+    return activeCache.exchange(std::move(cache));
+}
+
+auto SimplifyCache::Active() -> std::shared_ptr<SimplifyCache>
+{
+    if (!cacheInstalled.load(std::memory_order_relaxed)) {
+        return nullptr;
+    }
+
+    return activeCache.load(std::memory_order_acquire);
+}
+
+auto SimplifyCache::Find(const Expression& expression) -> std::unique_ptr<Expression>
+{
+    // Hash outside of the lock, since hashing a large expression for the first time is not free.
+    [[maybe_unused]] const std::size_t hash = expression.Hash();
+
+    std::lock_guard lock { mutex };
+
+    const auto it = index.find(&expression);
+
+    if (it == index.end()) {
+        ++misses;
+        return nullptr;
+    }
+
+    ++hits;
+    entries.splice(entries.begin(), entries, it->second);
+    return it->second->simplified->Copy();
+}
+
+auto SimplifyCache::Insert(const Expression& expression, const Expression& simplified) -> void
+{
+    // Promoting an entry copies it in full, so inner calls to Simplify leave recording to the
+    // outermost one while an arena is alive.
+    if (simplifyDepth > 1 && ExpressionArena::InUse()) {
+        return;
+    }
+
+    const std::size_t expressionBytes = EstimateSize(expression);
+    const std::size_t simplifiedBytes = EstimateSize(simplified);
+
+    if (expressionBytes > maxBytes || simplifiedBytes > maxBytes - expressionBytes || maxEntries == 0) {
+        return;
+    }
+
+    const std::size_t bytes = expressionBytes + simplifiedBytes;
+
+    Entry entry { .expression = Retain(expression), .simplified = Retain(simplified), .bytes = bytes };
+    [[maybe_unused]] const std::size_t hash = entry.expression->Hash();
+
+    std::lock_guard lock { mutex };
+
+    if (index.contains(entry.expression.get())) {
+        return;
+    }
+
+    entries.push_front(std::move(entry));
+    index.emplace(entries.front().expression.get(), entries.begin());
+    bytesUsed += bytes;
+
+    Evict();
+}
+
+auto SimplifyCache::Evict() -> void
+{
+    while (entries.size() > maxEntries || bytesUsed > maxBytes) {
+        const Entry& last = entries.back();
+        bytesUsed -= last.bytes;
+        index.erase(last.expression.get());
+        entries.pop_back();
+        ++evictions;
+    }
+}
+
+auto SimplifyCache::Size() const -> std::size_t
+{
+    std::lock_guard lock { mutex };
+    return entries.size();
+}
+
+auto SimplifyCache::BytesUsed() const -> std::size_t
+{
+    std::lock_guard lock { mutex };
+    return bytesUsed;
+}
+
+auto SimplifyCache::Hits() const -> std::size_t
+{
+    std::lock_guard lock { mutex };
+    return hits;
+}
+
+auto SimplifyCache::Misses() const -> std::size_t
+{
+    std::lock_guard lock { mutex };
+    return misses;
+}
+
+auto SimplifyCache::Evictions() const -> std::size_t
+{
+    std::lock_guard lock { mutex };
+    return evictions;
+}
+
+auto SimplifyCache::Clear() -> void
+{
+    std::lock_guard lock { mutex };
+    index.clear();
+    entries.clear();
+    bytesUsed = 0;
+    hits = 0;
+    misses = 0;
+    evictions = 0;
+}
+
+} // Oasis
@@ -21,7 +21,7 @@ Subtract<Expression>::Subtract(const Expression& minuend, const Expression& subt
 {
 }
 
-auto Subtract<Expression>::Simplify() const -> std::unique_ptr<Expression>
+auto Subtract<Expression>::SimplifyImpl() const -> std::unique_ptr<Expression>
 {
     const auto simplifiedMinuend = mostSigOp ? mostSigOp->Simplify() : nullptr;
     const auto simplifiedSubtrahend = leastSigOp ? leastSigOp->Simplify() : nullptr;
@@ -81,7 +81,7 @@ auto Subtract<Expression>::Simplify() const -> std::unique_ptr<Expression>
         if (logCase->GetMostSigOp().GetMostSigOp().Equals(logCase->GetLeastSigOp().GetMostSigOp())) {
             const IExpression auto& base = logCase->GetMostSigOp().GetMostSigOp();
             const IExpression auto& argument = Divide({ logCase->GetMostSigOp().GetLeastSigOp(), logCase->GetLeastSigOp().GetLeastSigOp() });
-            return std::make_unique<Log<>>(base, argument);
+            return Log<> { base, argument }.Simplify();
         }
     }
 
@@ -103,61 +103,6 @@ auto Subtract<Expression>::Simplify() const -> std::unique_ptr<Expression>
     }
 }
 
-auto Subtract<Expression>::Simplify(tf::Subflow& subflow) const -> std::unique_ptr<Expression>
-{
-    std::unique_ptr<Expression> simplifiedMinuend, simplifiedSubtrahend;
-
-    tf::Task leftSimplifyTask = subflow.emplace([this, &simplifiedMinuend](tf::Subflow& sbf) {
-        if (!mostSigOp) {
-            return;
-        }
-
-        simplifiedMinuend = mostSigOp->Simplify(sbf);
-    });
-
-    tf::Task rightSimplifyTask = subflow.emplace([this, &simplifiedSubtrahend](tf::Subflow& sbf) {
-        if (!leastSigOp) {
-            return;
-        }
-
-        simplifiedSubtrahend = leastSigOp->Simplify(sbf);
-    });
-
-    Subtract simplifiedSubtract;
-
-    // While this task isn't actually parallelized, it exists as a prerequisite for check possible cases in parallel
-    tf::Task simplifyTask = subflow.emplace([&simplifiedSubtract, &simplifiedMinuend, &simplifiedSubtrahend](tf::Subflow&) {
-        if (simplifiedMinuend) {
-            simplifiedSubtract.SetMostSigOp(*simplifiedMinuend);
-        }
-
-        if (simplifiedSubtrahend) {
-            simplifiedSubtract.SetLeastSigOp(*simplifiedSubtrahend);
-        }
-    });
-
-    simplifyTask.succeed(leftSimplifyTask, rightSimplifyTask);
-
-    std::unique_ptr<Subtract<Real>> realCase;
-
-    tf::Task realCaseTask = subflow.emplace([&simplifiedSubtract, &realCase](tf::Subflow& sbf) {
-        realCase = Subtract<Real>::Specialize(simplifiedSubtract, sbf);
-    });
-
-    simplifyTask.precede(realCaseTask);
-
-    subflow.join();
-
-    if (realCase) {
-        const Real& minuend = realCase->GetMostSigOp();
-        const Real& subtrahend = realCase->GetLeastSigOp();
-
-        return std::make_unique<Real>(minuend.GetValue() - subtrahend.GetValue());
-    }
-
-    return simplifiedSubtract.Copy();
-}
-
 auto Subtract<Expression>::Specialize(const Expression& other) -> std::unique_ptr<Subtract<Expression, Expression>>
 {
     if (!other.Is<Oasis::Subtract>()) {
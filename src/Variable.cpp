@@ -22,6 +22,11 @@ auto Variable::Equals(const Expression& other) const -> bool
     return other.Is<Variable>() && name == dynamic_cast<const Variable&>(other).name;
 }
 
+auto Variable::ComputeHash() const -> std::size_t
+{
+    return CombineHash(Expression::ComputeHash(), std::hash<std::string> {}(name));
+}
+
 auto Variable::GetName() const -> std::string
 {
     return name;
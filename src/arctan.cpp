@@ -5,7 +5,7 @@ namespace Oasis {
 
 ArcTan::ArcTan(const Expression& operand) : UnaryExpression(operand) {}
 
-auto ArcTan::Simplify() const -> std::unique_ptr<Expression> {
+auto ArcTan::SimplifyImpl() const -> std::unique_ptr<Expression> {
     auto simplifiedOperand = GetOperand().Simplify();
     if (auto realOperand = Real::Specialize(*simplifiedOperand)) {
         return std::make_unique<Real>(std::atan(realOperand->GetValue()));
@@ -13,7 +13,7 @@ auto ArcTan::Simplify() const -> std::unique_ptr<Expression> {
     return std::make_unique<ArcTan>(*simplifiedOperand);
 }
 
-auto ArcTan::Simplify(tf::Subflow& subflow) const -> std::unique_ptr<Expression> {
+auto ArcTan::SimplifyImpl(tf::Subflow& subflow) const -> std::unique_ptr<Expression> {
     std::unique_ptr<Expression> simplifiedOperand;
     subflow.emplace([this, &simplifiedOperand](tf::Subflow& sbf) {
         simplifiedOperand = GetOperand().Simplify(sbf);
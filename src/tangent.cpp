@@ -5,7 +5,7 @@ namespace Oasis {
 
 Tan::Tan(const Expression& operand) : UnaryExpression(operand) {}
 
-auto Tan::Simplify() const -> std::unique_ptr<Expression> {
+auto Tan::SimplifyImpl() const -> std::unique_ptr<Expression> {
     auto simplifiedOperand = GetOperand().Simplify();
     if (auto realOperand = Real::Specialize(*simplifiedOperand)) {
         return std::make_unique<Real>(std::tan(realOperand->GetValue()));
@@ -13,7 +13,7 @@ auto Tan::Simplify() const -> std::unique_ptr<Expression> {
     return std::make_unique<Tan>(*simplifiedOperand);
 }
 
-auto Tan::Simplify(tf::Subflow& subflow) const -> std::unique_ptr<Expression> {
+auto Tan::SimplifyImpl(tf::Subflow& subflow) const -> std::unique_ptr<Expression> {
     std::unique_ptr<Expression> simplifiedOperand;
     subflow.emplace([this, &simplifiedOperand](tf::Subflow& sbf) {
         simplifiedOperand = GetOperand().Simplify(sbf);
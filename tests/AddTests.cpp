@@ -6,6 +6,7 @@
 #include "Oasis/Add.hpp"
 #include "Oasis/Exponent.hpp"
 #include "Oasis/Imaginary.hpp"
+#include "Oasis/Log.hpp"
 #include "Oasis/Multiply.hpp"
 #include "Oasis/Real.hpp"
 #include "Oasis/Variable.hpp"
@@ -278,4 +279,49 @@ TEST_CASE("Variadic Add Constructor", "[Add]")
 
     const auto simplified = add.Simplify();
     REQUIRE(expected.Equals(*simplified));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Add Combines Many Like Terms", "[Add][Associativity]")
+{
+    std::vector<std::unique_ptr<Oasis::Expression>> terms;
+
+    for (int i = 0; i < 300; ++i) {
+        if (i % 2 == 0) {
+            terms.emplace_back(Oasis::Real { static_cast<double>(i) }.Copy());
+        } else {
+            terms.emplace_back(Oasis::Multiply { Oasis::Real { static_cast<double>(i) }, Oasis::Variable { "x" } }.Copy());
+        }
+    }
+
+    const auto add = Oasis::BuildFromVector<Oasis::Add>(terms);
+    const auto simplified = add->Simplify();
+
+    const Oasis::Add expected {
+        Oasis::Multiply {
+            Oasis::Real { 22500.0 },
+            Oasis::Variable { "x" } },
+        Oasis::Real { 22350.0 }
+    };
+
+    REQUIRE(expected.Equals(*simplified));
+}
+
+TEST_CASE("Add Keeps Terms Without Coefficients", "[Add]")
+{
+    const Oasis::Add<> add {
+        Oasis::Variable { "x" },
+        Oasis::Real { 2.0 },
+        Oasis::Log { Oasis::Real { 2.0 }, Oasis::Variable { "y" } },
+        Oasis::Variable { "x" }
+    };
+
+    const auto simplified = add.Simplify();
+
+    const Oasis::Add<> expected {
+        Oasis::Multiply { Oasis::Real { 2.0 }, Oasis::Variable { "x" } },
+        Oasis::Real { 2.0 },
+        Oasis::Log { Oasis::Real { 2.0 }, Oasis::Variable { "y" } }
+    };
+
+    REQUIRE(expected.Equals(*simplified));
+}
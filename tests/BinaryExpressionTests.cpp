@@ -4,6 +4,10 @@
 #include "catch2/catch_test_macros.hpp"
 
 #include "Oasis/Add.hpp"
+#include "Oasis/Divide.hpp"
+#include "Oasis/Exponent.hpp"
+#include "Oasis/FrozenExpression.hpp"
+#include "Oasis/Imaginary.hpp"
 #include "Oasis/Multiply.hpp"
 #include "Oasis/Real.hpp"
 #include "Oasis/Variable.hpp"
@@ -218,6 +222,58 @@ TEST_CASE("Equals follows associativity and commutativity")
         REQUIRE(add1.Equals(add2));
     }
 }
+
+TEST_CASE("Equals counts repeated operands")
+{
+    Oasis::Variable x { "x" };
+    Oasis::Variable y { "y" };
+
+    // (x + x) + y == (x + y) + x
+    SECTION("Same multiplicity")
+    {
+        Oasis::Add add1 { Oasis::Add { x, x }, y };
+        Oasis::Add add2 { Oasis::Add { x, y }, x };
+
+        REQUIRE(add1.Equals(add2));
+        REQUIRE(add2.Equals(add1));
+    }
+
+    // (x + x) + y != (x + y) + y
+    SECTION("Different multiplicity")
+    {
+        Oasis::Add add1 { Oasis::Add { x, x }, y };
+        Oasis::Add add2 { Oasis::Add { x, y }, y };
+
+        REQUIRE_FALSE(add1.Equals(add2));
+        REQUIRE_FALSE(add2.Equals(add1));
+    }
+
+    // (x + y) + x != (x + y) + (x + x)
+    SECTION("Different operand count")
+    {
+        Oasis::Add add1 { Oasis::Add { x, y }, x };
+        Oasis::Add add2 { Oasis::Add { x, y }, Oasis::Add { x, x } };
+
+        REQUIRE_FALSE(add1.Equals(add2));
+        REQUIRE_FALSE(add2.Equals(add1));
+    }
+}
+
+TEST_CASE("Identical follows operand order")
+{
+    Oasis::Variable x { "x" };
+    Oasis::Variable y { "y" };
+
+    const Oasis::Add add1 { Oasis::Add { x, y }, Oasis::Real { 1.0 } };
+    const Oasis::Add add2 { Oasis::Add { x, y }, Oasis::Real { 1.0 } };
+    const Oasis::Add add3 { Oasis::Add { y, x }, Oasis::Real { 1.0 } };
+
+    REQUIRE(add1.Identical(add2));
+    REQUIRE(add1.Equals(add3));
+    REQUIRE_FALSE(add1.Identical(add3));
+    REQUIRE_FALSE(add1.Identical(Oasis::Add { Oasis::Add { x, y }, Oasis::Real { 2.0 } }));
+}
+
 TEST_CASE("Substitute Binary", "[Substitute]")
 {
     Oasis::Add<Oasis::Multiply<Oasis::Real, Oasis::Variable>> before {
@@ -231,4 +287,145 @@ TEST_CASE("Substitute Binary", "[Substitute]")
                     auto after = before.Substitute(Oasis::Variable { "x" }, Oasis::Real { 4.0 }); // after should some std::unique_ptr<Expression> such that it equals 2(4) + 3(4)
                     Oasis::Real twenty {20};
     REQUIRE(after->Equals(*(twenty.Simplify())));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Simplify Marks Normal Form", "[Simplify]")
+{
+    const Oasis::Add add {
+        Oasis::Multiply { Oasis::Real { 2.0 }, Oasis::Variable { "x" } },
+        Oasis::Multiply { Oasis::Real { 3.0 }, Oasis::Variable { "x" } }
+    };
+
+    REQUIRE_FALSE(add.IsSimplified());
+
+    const auto simplified = add.Simplify();
+    REQUIRE(simplified->IsSimplified());
+    REQUIRE(simplified->Copy()->IsSimplified());
+
+    const auto resimplified = simplified->Simplify();
+    REQUIRE(resimplified->IsSimplified());
+    REQUIRE(resimplified->Equals(*simplified));
+}
+
+TEST_CASE("Simplify Returns Simplified Rule Results", "[Simplify]")
+{
+    // Rules simplify what they build, so 2x + -2x combines to 0 rather than 0 * x.
+    const Oasis::Add add {
+        Oasis::Multiply { Oasis::Real { 2.0 }, Oasis::Variable { "x" } },
+        Oasis::Multiply { Oasis::Real { -2.0 }, Oasis::Variable { "x" } }
+    };
+
+    const auto simplifiedAdd = add.Simplify();
+    REQUIRE(simplifiedAdd->IsSimplified());
+    REQUIRE(simplifiedAdd->Identical(*simplifiedAdd->Simplify()));
+
+    const Oasis::Multiply multiply { Oasis::Real { 1.0 }, add };
+    const auto simplified = multiply.Simplify();
+
+    REQUIRE(simplified->Equals(Oasis::Real { 0.0 }));
+}
+
+TEST_CASE("Simplify Returns Simplified Powers", "[Simplify]")
+{
+    // x * x^-1 combines to x^0, which is 1.
+    const Oasis::Multiply cancelled {
+        Oasis::Real { 1.0 },
+        Oasis::Multiply { Oasis::Variable { "x" }, Oasis::Exponent { Oasis::Variable { "x" }, Oasis::Real { -1.0 } } }
+    };
+
+    const auto simplifiedCancelled = cancelled.Simplify();
+    REQUIRE(simplifiedCancelled->Equals(Oasis::Real { 1.0 }));
+
+    // (x^2)^0.5 combines to x^1, which is x.
+    const Oasis::Multiply root {
+        Oasis::Real { 1.0 },
+        Oasis::Exponent { Oasis::Exponent { Oasis::Variable { "x" }, Oasis::Real { 2.0 } }, Oasis::Real { 0.5 } }
+    };
+
+    const auto simplifiedRoot = root.Simplify();
+    REQUIRE(simplifiedRoot->Equals(Oasis::Variable { "x" }));
+}
+
+TEST_CASE("Simplified Results Are Fixed Points", "[Simplify]")
+{
+    const Oasis::Variable x { "x" };
+    const Oasis::Variable y { "y" };
+    const Oasis::Variable z { "z" };
+
+    std::vector<std::unique_ptr<Oasis::Expression>> expressions;
+    expressions.push_back(Oasis::Divide {
+        Oasis::Multiply { Oasis::Real { 2.0 }, Oasis::Multiply { x, y } },
+        Oasis::Multiply { Oasis::Real { 4.0 }, Oasis::Multiply { x, z } } }
+            .Copy());
+    expressions.push_back(Oasis::Divide { x, Oasis::Multiply { x, Oasis::Multiply { y, z } } }.Copy());
+    expressions.push_back(Oasis::Add { Oasis::Add { x, y }, Oasis::Add { Oasis::Real { 3.0 }, z } }.Copy());
+    expressions.push_back(Oasis::Add { Oasis::Multiply { Oasis::Real { 2.0 }, x }, Oasis::Add { y, Oasis::Multiply { Oasis::Real { 3.0 }, x } } }.Copy());
+    expressions.push_back(Oasis::Multiply { Oasis::Multiply { x, y }, Oasis::Multiply { z, x } }.Copy());
+    expressions.push_back(Oasis::Exponent { Oasis::Imaginary {}, Oasis::Real { 3.0 } }.Copy());
+    expressions.push_back(Oasis::Exponent { Oasis::Multiply { Oasis::Real { -4.0 }, x }, Oasis::Real { 0.5 } }.Copy());
+
+    for (const auto& expression : expressions) {
+        const auto simplified = expression->Simplify();
+        REQUIRE(simplified->IsSimplified());
+
+        // Thawing a copy drops the normal-form flag, so simplifying it applies the rules again.
+        const auto thawed = Oasis::FrozenExpression::Freeze(*simplified).Thaw();
+        REQUIRE_FALSE(thawed->IsSimplified());
+
+        const auto resimplified = thawed->Simplify();
+        REQUIRE(resimplified->Equals(*simplified));
+    }
+}
+
+TEST_CASE("Add Returns Remaining Term", "[Simplify]")
+{
+    const Oasis::Variable x { "x" };
+    const Oasis::Variable y { "y" };
+
+    // x + 2y + -2y leaves the single term x.
+    const Oasis::Add single {
+        Oasis::Add { x, Oasis::Multiply { Oasis::Real { 2.0 }, y } },
+        Oasis::Multiply { Oasis::Real { -2.0 }, y }
+    };
+
+    const auto simplifiedSingle = single.Simplify();
+    REQUIRE(simplifiedSingle->Identical(x));
+
+    // 2x + 3 + -2x + -3 leaves no terms, which is 0.
+    const Oasis::Add none {
+        Oasis::Add { Oasis::Multiply { Oasis::Real { 2.0 }, x }, Oasis::Real { 3.0 } },
+        Oasis::Add { Oasis::Multiply { Oasis::Real { -2.0 }, x }, Oasis::Real { -3.0 } }
+    };
+
+    const auto simplifiedNone = none.Simplify();
+    REQUIRE(simplifiedNone->Identical(Oasis::Real { 0.0 }));
+}
+
+TEST_CASE("Setting Operands Clears Normal Form", "[Simplify]")
+{
+    const Oasis::Add add { Oasis::Variable { "x" }, Oasis::Variable { "y" } };
+    const auto simplified = add.Simplify();
+
+    auto& simplifiedAdd = dynamic_cast<Oasis::Add<Oasis::Expression>&>(*simplified);
+    REQUIRE(simplifiedAdd.IsSimplified());
+
+    simplifiedAdd.SetMostSigOp(Oasis::Real { 1.0 });
+    REQUIRE_FALSE(simplifiedAdd.IsSimplified());
+}
+
+TEST_CASE("Node Count", "[TreeManip]")
+{
+    Oasis::Add<Oasis::Expression> add {
+        Oasis::Multiply { Oasis::Real { 2.0 }, Oasis::Variable { "x" } },
+        Oasis::Real { 1.0 }
+    };
+
+    REQUIRE(add.NodeCount() == 5);
+    REQUIRE(add.Copy()->NodeCount() == 5);
+
+    add.SetLeastSigOp(Oasis::Variable { "y" });
+    REQUIRE(add.NodeCount() == 5);
+
+    add.SetMostSigOp(Oasis::Variable { "x" });
+    REQUIRE(add.NodeCount() == 3);
+}
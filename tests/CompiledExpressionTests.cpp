@@ -0,0 +1,434 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "Oasis/Add.hpp"
+#include "Oasis/CompiledExpression.hpp"
+#include "Oasis/Divide.hpp"
+#include "Oasis/Exponent.hpp"
+#include "Oasis/Imaginary.hpp"
+#include "Oasis/Log.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Negate.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Runtime.hpp"
+#include "Oasis/Subtract.hpp"
+#include "Oasis/Variable.hpp"
+
+TEST_CASE("Compiled Expression Evaluates", "[CompiledExpression]")
+{
+    const Oasis::Variable x { "x" };
+    const Oasis::Variable y { "y" };
+
+    // (3x^2 - y) / 2 + log_2(y) * -x
+    const Oasis::Add expression {
+        Oasis::Divide {
+            Oasis::Subtract { Oasis::Multiply { Oasis::Real { 3.0 }, Oasis::Exponent { x, Oasis::Real { 2.0 } } }, y },
+            Oasis::Real { 2.0 } },
+        Oasis::Multiply { Oasis::Log { Oasis::Real { 2.0 }, y }, Oasis::Negate { x } }
+    };
+
+    const Oasis::CompiledExpression compiled { expression, { "x", "y" } };
+
+    for (const double xValue : { -2.0, 0.5, 3.0 }) {
+        for (const double yValue : { 1.0, 4.0, 10.0 }) {
+            const double expected = (3 * xValue * xValue - yValue) / 2 + std::log2(yValue) * -xValue;
+            REQUIRE(std::abs(compiled.Evaluate(std::array { xValue, yValue }) - expected) < 1e-12);
+        }
+    }
+}
+
+TEST_CASE("Compiled Expression Binds Variables To Slots", "[CompiledExpression]")
+{
+    const Oasis::Subtract expression {
+        Oasis::Subtract { Oasis::Variable { "a" }, Oasis::Variable { "b" } },
+        Oasis::Variable { "c" }
+    };
+
+    const Oasis::CompiledExpression compiled { expression, { "c" } };
+
+    REQUIRE(compiled.GetVariables() == std::vector<std::string> { "c", "a", "b" });
+    REQUIRE(compiled.GetSlot("c") == 0);
+    REQUIRE(compiled.GetSlot("a") == 1);
+    REQUIRE(compiled.GetSlot("b") == 2);
+    REQUIRE(compiled.GetSlot("d") == std::nullopt);
+
+    REQUIRE(compiled.Evaluate(std::array { 1.0, 10.0, 4.0 }) == 5.0);
+}
+
+TEST_CASE("Compiled Expression Folds Constants", "[CompiledExpression]")
+{
+    const Oasis::Multiply expression {
+        Oasis::Add { Oasis::Real { 1.0 }, Oasis::Negate { Oasis::Real { 3.0 } } },
+        Oasis::Add { Oasis::Variable { "x" }, Oasis::Exponent { Oasis::Real { 2.0 }, Oasis::Real { 3.0 } } }
+    };
+
+    const Oasis::CompiledExpression compiled { expression };
+
+    // -2 * (x + 8)
+    REQUIRE(compiled.GetInstructions().size() == 5);
+    REQUIRE(compiled.GetConstants().size() == 2);
+    REQUIRE(compiled.Evaluate(std::array { 1.0 }) == -18.0);
+
+    const Oasis::CompiledExpression constant { Oasis::Divide { Oasis::Real { 1.0 }, Oasis::Real { 4.0 } } };
+    REQUIRE(constant.GetInstructions().size() == 1);
+    REQUIRE(constant.GetVariables().empty());
+    REQUIRE(constant.Evaluate({}) == 0.25);
+}
+
+TEST_CASE("Compiled Expression Rejects Non-Numeric Expressions", "[CompiledExpression]")
+{
+    REQUIRE_THROWS_AS(Oasis::CompiledExpression { Oasis::Imaginary {} }, std::invalid_argument);
+    REQUIRE_THROWS_AS(Oasis::CompiledExpression(Oasis::Add { Oasis::Variable { "x" }, Oasis::Imaginary {} }), std::invalid_argument);
+}
+
+TEST_CASE("Compiled Expression Evaluates Many Points", "[CompiledExpression]")
+{
+    const Oasis::Variable x { "x" };
+    const Oasis::Variable y { "y" };
+
+    // Covers every kernel, including the special cased powers and constant operands on either side.
+    const Oasis::Add expression {
+        Oasis::Add {
+            Oasis::Add { Oasis::Exponent { x, Oasis::Real { 2.0 } }, Oasis::Exponent { y, Oasis::Real { 3.0 } } },
+            Oasis::Add { Oasis::Exponent { x, Oasis::Real { 0.5 } }, Oasis::Exponent { y, Oasis::Real { -1.0 } } } },
+        Oasis::Add {
+            Oasis::Add {
+                Oasis::Exponent { x, y },
+                Oasis::Multiply {
+                    Oasis::Exponent { Oasis::Real { 2.0 }, x },
+                    Oasis::Add { Oasis::Exponent { x, Oasis::Real { 1.0 } }, Oasis::Exponent { y, Oasis::Real { 0.0 } } } } },
+            Oasis::Subtract {
+                Oasis::Add { Oasis::Log { Oasis::Real { 10.0 }, x }, Oasis::Log { x, y } },
+                Oasis::Divide { Oasis::Negate { x }, Oasis::Subtract { Oasis::Real { 1.0 }, y } } } }
+    };
+
+    const Oasis::CompiledExpression compiled { expression, { "x", "y" } };
+
+    // Not a multiple of the block size, so the last block is partial.
+    constexpr std::size_t points = 1000;
+    std::vector<double> xs(points), ys(points), results(points);
+
+    for (std::size_t i = 0; i < points; ++i) {
+        xs[i] = 1.5 + static_cast<double>(i) * 0.01;
+        ys[i] = 2.0 + static_cast<double>(i % 17) * 0.1;
+    }
+
+    compiled.EvaluateMany(std::array<std::span<const double>, 2> { xs, ys }, results);
+
+    for (std::size_t i = 0; i < points; ++i) {
+        REQUIRE(results[i] == compiled.Evaluate(std::array { xs[i], ys[i] }));
+    }
+
+    // The result of the program is a constant or a variable, not an intermediate result.
+    std::vector<double> constants(points);
+    Oasis::CompiledExpression { Oasis::Real { 4.0 } }.EvaluateMany({}, constants);
+    REQUIRE(std::ranges::all_of(constants, [](double value) { return value == 4.0; }));
+
+    std::vector<double> identity(points);
+    Oasis::CompiledExpression { x }.EvaluateMany(std::array<std::span<const double>, 1> { xs }, identity);
+    REQUIRE(identity == xs);
+}
+
+TEST_CASE("Compiled Expression Evaluates Many Edge Values Like Evaluate", "[CompiledExpression]")
+{
+    const Oasis::Variable x { "x" };
+    constexpr double inf = std::numeric_limits<double>::infinity();
+    constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+
+    const std::vector<double> xs { -inf, -2.5, -1.0, -0.0, 0.0, 1e-310, 0.1, 1.0, 3.0, 1e300, inf, nan };
+
+    const auto same = [](double lhs, double rhs) {
+        return (std::isnan(lhs) && std::isnan(rhs)) || (lhs == rhs && std::signbit(lhs) == std::signbit(rhs));
+    };
+
+    for (const double power : { 0.0, 1.0, 2.0, 3.0, 0.5, -1.0, -0.5 }) {
+        const Oasis::CompiledExpression compiled { Oasis::Exponent { x, Oasis::Real { power } }, { "x" } };
+        std::vector<double> results(xs.size());
+        compiled.EvaluateMany(std::array<std::span<const double>, 1> { xs }, results);
+
+        for (std::size_t i = 0; i < xs.size(); ++i) {
+            REQUIRE(same(results[i], compiled.Evaluate(std::array { xs[i] })));
+        }
+    }
+
+    for (const double base : { 2.0, 3.0, 10.0, 0.5 }) {
+        const Oasis::CompiledExpression compiled { Oasis::Log { Oasis::Real { base }, x }, { "x" } };
+        std::vector<double> results(xs.size());
+        compiled.EvaluateMany(std::array<std::span<const double>, 1> { xs }, results);
+
+        for (std::size_t i = 0; i < xs.size(); ++i) {
+            REQUIRE(same(results[i], compiled.Evaluate(std::array { xs[i] })));
+        }
+    }
+}
+
+TEST_CASE("Compiled Expression Evaluates Grids", "[CompiledExpression][Async]")
+{
+    // x * y - log_2(x)
+    const Oasis::Subtract expression {
+        Oasis::Multiply { Oasis::Variable { "x" }, Oasis::Variable { "y" } },
+        Oasis::Log { Oasis::Real { 2.0 }, Oasis::Variable { "x" } }
+    };
+
+    const Oasis::CompiledExpression compiled { expression, { "x", "y" } };
+
+    // Spans several chunks, and the last one is partial.
+    const std::array axes {
+        Oasis::CompiledExpression::Axis { .start = 1.0, .step = 0.5, .count = 300 },
+        Oasis::CompiledExpression::Axis { .start = -2.0, .step = 0.25, .count = 301 }
+    };
+
+    Oasis::Runtime runtime { 4 };
+    std::vector<double> results(300 * 301);
+    compiled.EvaluateGrid(axes, results, runtime);
+
+    double sum = 0.0;
+
+    for (std::size_t i = 0; i < 300; ++i) {
+        for (std::size_t j = 0; j < 301; ++j) {
+            const double x = 1.0 + static_cast<double>(i) * 0.5;
+            const double y = -2.0 + static_cast<double>(j) * 0.25;
+            const double value = results[i * 301 + j];
+            const double expected = compiled.Evaluate(std::array { x, y });
+            REQUIRE(std::abs(value - expected) <= 1e-12 * std::abs(expected));
+            sum += value;
+        }
+    }
+
+    const auto reduction = compiled.ReduceGrid(axes, runtime);
+    REQUIRE(std::abs(reduction.sum - sum) <= 1e-9 * std::abs(sum));
+    REQUIRE(reduction.min == std::ranges::min(results));
+    REQUIRE(reduction.max == std::ranges::max(results));
+
+    // Empty grids reduce to the identity.
+    const std::array empty { axes[0], Oasis::CompiledExpression::Axis { .start = 0.0, .step = 1.0, .count = 0 } };
+    const auto none = compiled.ReduceGrid(empty, runtime);
+    REQUIRE(none.sum == 0.0);
+    REQUIRE(none.min == std::numeric_limits<double>::infinity());
+    REQUIRE(none.max == -std::numeric_limits<double>::infinity());
+
+    REQUIRE_THROWS_AS(compiled.EvaluateGrid(std::span { axes }.first(1), results, runtime), std::invalid_argument);
+    REQUIRE_THROWS_AS(compiled.EvaluateGrid(axes, std::span { results }.first(10), runtime), std::invalid_argument);
+}
+
+TEST_CASE("Compiled Expression Differentiates In Forward Mode", "[CompiledExpression]")
+{
+    const Oasis::Variable x { "x" };
+    const Oasis::Variable y { "y" };
+
+    // x^2 * y + log_2(x) / y - x^y
+    const Oasis::Subtract expression {
+        Oasis::Add {
+            Oasis::Multiply { Oasis::Exponent { x, Oasis::Real { 2.0 } }, y },
+            Oasis::Divide { Oasis::Log { Oasis::Real { 2.0 }, x }, y } },
+        Oasis::Exponent { x, y }
+    };
+
+    const Oasis::CompiledExpression compiled { expression, { "x", "y" } };
+
+    const double xValue = 1.5;
+    const double yValue = 2.5;
+    const std::array values { xValue, yValue };
+
+    const double value = xValue * xValue * yValue + std::log2(xValue) / yValue - std::pow(xValue, yValue);
+    const double dx = 2 * xValue * yValue + 1 / (xValue * std::log(2.0) * yValue) - yValue * std::pow(xValue, yValue - 1);
+    const double dy = xValue * xValue - std::log2(xValue) / (yValue * yValue) - std::pow(xValue, yValue) * std::log(xValue);
+
+    const auto dualX = compiled.EvaluateDual(values, std::array { 1.0, 0.0 });
+    REQUIRE(std::abs(dualX.value - value) < 1e-12);
+    REQUIRE(std::abs(dualX.derivative - dx) < 1e-12);
+
+    const auto dualY = compiled.EvaluateDual(values, std::array { 0.0, 1.0 });
+    REQUIRE(std::abs(dualY.derivative - dy) < 1e-12);
+
+    // Several directions at once, including a non-unit one.
+    std::array<double, 3> derivatives {};
+    const double result = compiled.EvaluateDual(values, std::array { 1.0, 0.0, 0.0, 1.0, 0.5, -2.0 }, derivatives);
+    REQUIRE(std::abs(result - value) < 1e-12);
+    REQUIRE(std::abs(derivatives[0] - dx) < 1e-12);
+    REQUIRE(std::abs(derivatives[1] - dy) < 1e-12);
+    REQUIRE(std::abs(derivatives[2] - (0.5 * dx - 2.0 * dy)) < 1e-12);
+}
+
+TEST_CASE("Compiled Expression Differentiates Constant Powers Of Negative Bases", "[CompiledExpression]")
+{
+    // (x^3 - log_x(4)) at x = -2, where log_x(4) is NaN but x^3 is not.
+    const Oasis::CompiledExpression cube { Oasis::Exponent { Oasis::Variable { "x" }, Oasis::Real { 3.0 } } };
+    const auto dual = cube.EvaluateDual(std::array { -2.0 }, std::array { 1.0 });
+    REQUIRE(dual.value == -8.0);
+    REQUIRE(dual.derivative == 12.0);
+
+    const Oasis::CompiledExpression log { Oasis::Log { Oasis::Real { 10.0 }, Oasis::Variable { "x" } } };
+    const auto logDual = log.EvaluateDual(std::array { 100.0 }, std::array { 1.0 });
+    REQUIRE(std::abs(logDual.value - 2.0) < 1e-12);
+    REQUIRE(std::abs(logDual.derivative - 1.0 / (100.0 * std::log(10.0))) < 1e-12);
+}
+
+TEST_CASE("Compiled Expression Gradient Matches Differentiate", "[CompiledExpression]")
+{
+    const Oasis::Variable x { "x" };
+    const Oasis::Variable y { "y" };
+    const Oasis::Variable z { "z" };
+
+    // 3x^2 * y - x * z / y + z^3
+    const Oasis::Add expression {
+        Oasis::Subtract {
+            Oasis::Multiply { Oasis::Multiply { Oasis::Real { 3.0 }, Oasis::Exponent { x, Oasis::Real { 2.0 } } }, y },
+            Oasis::Divide { Oasis::Multiply { x, z }, y } },
+        Oasis::Exponent { z, Oasis::Real { 3.0 } }
+    };
+
+    const Oasis::CompiledExpression compiled { expression, { "x", "y", "z" } };
+    const std::array values { 1.5, -2.0, 0.75 };
+
+    std::array<double, 3> gradient {};
+    const double value = compiled.EvaluateGradient(values, gradient);
+    REQUIRE(std::abs(value - compiled.Evaluate(values)) < 1e-12);
+
+    for (const auto& [slot, variable] : { std::pair { 0, x }, std::pair { 1, y }, std::pair { 2, z } }) {
+        const auto derivative = expression.Differentiate(variable);
+        const Oasis::CompiledExpression compiledDerivative { *derivative, { "x", "y", "z" } };
+        REQUIRE(std::abs(gradient[slot] - compiledDerivative.Evaluate(values)) < 1e-9);
+    }
+}
+
+TEST_CASE("Compiled Expression Gradient Matches Forward Mode", "[CompiledExpression]")
+{
+    const Oasis::Variable x { "x" };
+    const Oasis::Variable y { "y" };
+
+    // log_x(y) * x^y - -(y / x) + log_2(x * x)
+    const Oasis::Add expression {
+        Oasis::Subtract {
+            Oasis::Multiply { Oasis::Log { x, y }, Oasis::Exponent { x, y } },
+            Oasis::Negate { Oasis::Divide { y, x } } },
+        Oasis::Log { Oasis::Real { 2.0 }, Oasis::Multiply { x, x } }
+    };
+
+    const Oasis::CompiledExpression compiled { expression, { "x", "y" } };
+    const std::array values { 2.5, 1.5 };
+
+    std::array<double, 2> gradient {};
+    std::array<double, 2> derivatives {};
+    const double value = compiled.EvaluateGradient(values, gradient);
+    REQUIRE(value == compiled.EvaluateDual(values, std::array { 1.0, 0.0, 0.0, 1.0 }, derivatives));
+    REQUIRE(std::abs(gradient[0] - derivatives[0]) < 1e-12);
+    REQUIRE(std::abs(gradient[1] - derivatives[1]) < 1e-12);
+
+    // Constant powers of negative bases stay finite.
+    const Oasis::CompiledExpression cube { Oasis::Exponent { x, Oasis::Real { 3.0 } } };
+    std::array<double, 1> cubeGradient {};
+    REQUIRE(cube.EvaluateGradient(std::array { -2.0 }, cubeGradient) == -8.0);
+    REQUIRE(cubeGradient[0] == 12.0);
+}
+
+TEST_CASE("Compiled Expression Shares Repeated Subexpressions", "[CompiledExpression]")
+{
+    const Oasis::Variable x { "x" };
+    const Oasis::Variable y { "y" };
+    const Oasis::Add g { Oasis::Multiply { x, y }, Oasis::Real { 1.0 } };
+
+    // (g * x - y * g) / g^2, where g = xy + 1
+    const Oasis::Divide expression {
+        Oasis::Subtract { Oasis::Multiply { g, x }, Oasis::Multiply { y, g } },
+        Oasis::Exponent { g, Oasis::Real { 2.0 } }
+    };
+
+    const Oasis::CompiledExpression compiled { expression, { "x", "y" } };
+    const auto instructions = compiled.GetInstructions();
+    const auto count = [&](Oasis::CompiledExpression::OpCode opCode) {
+        return std::ranges::count_if(instructions, [opCode](const auto& instruction) { return instruction.opCode == opCode; });
+    };
+
+    REQUIRE(compiled.GetTemporaryCount() == 1);
+    REQUIRE(count(Oasis::CompiledExpression::OpCode::Store) == 1);
+    REQUIRE(count(Oasis::CompiledExpression::OpCode::Load) == 2);
+    REQUIRE(count(Oasis::CompiledExpression::OpCode::Add) == 1);
+
+    const std::array values { 1.5, -0.25 };
+    const double gValue = 1.5 * -0.25 + 1.0;
+    const double expected = (gValue * 1.5 + 0.25 * gValue) / (gValue * gValue);
+    REQUIRE(std::abs(compiled.Evaluate(values) - expected) < 1e-12);
+
+    const std::array xs { 1.5, 2.0, -3.0 };
+    const std::array ys { -0.25, 0.5, 4.0 };
+    std::array<double, 3> results {};
+    compiled.EvaluateMany(std::array<std::span<const double>, 2> { xs, ys }, results);
+
+    for (std::size_t i = 0; i < xs.size(); ++i) {
+        REQUIRE(results[i] == compiled.Evaluate(std::array { xs[i], ys[i] }));
+    }
+
+    std::array<double, 2> gradient {};
+    std::array<double, 2> derivatives {};
+    REQUIRE(compiled.EvaluateGradient(values, gradient) == compiled.Evaluate(values));
+    REQUIRE(compiled.EvaluateDual(values, std::array { 1.0, 0.0, 0.0, 1.0 }, derivatives) == compiled.Evaluate(values));
+
+    // The expression is (x - y) / g.
+    const std::array expectedGradient { 1.0 / gValue - (1.5 + 0.25) * -0.25 / (gValue * gValue), -1.0 / gValue - (1.5 + 0.25) * 1.5 / (gValue * gValue) };
+
+    for (std::size_t slot = 0; slot < expectedGradient.size(); ++slot) {
+        REQUIRE(std::abs(gradient[slot] - expectedGradient[slot]) < 1e-9);
+        REQUIRE(std::abs(derivatives[slot] - expectedGradient[slot]) < 1e-9);
+    }
+
+    // Repeated constant subexpressions are folded rather than stored.
+    const Oasis::Multiply six { Oasis::Real { 2.0 }, Oasis::Real { 3.0 } };
+    const Oasis::CompiledExpression folded { Oasis::Add { Oasis::Multiply { six, x }, six } };
+    REQUIRE(folded.GetTemporaryCount() == 0);
+    REQUIRE(folded.Evaluate(std::array { 2.0 }) == 18.0);
+
+    // Regrouping a product changes how it rounds, so equal but differently grouped products are
+    // not shared.
+    const Oasis::Variable z { "z" };
+    const Oasis::Add regrouped { Oasis::Multiply { x, Oasis::Multiply { y, z } }, Oasis::Multiply { Oasis::Multiply { z, x }, y } };
+    const Oasis::CompiledExpression unshared { regrouped, { "x", "y", "z" } };
+    REQUIRE(unshared.GetTemporaryCount() == 0);
+    REQUIRE(unshared.Evaluate(std::array { 0.1, 0.7, 0.3 }) == 0.1 * (0.7 * 0.3) + (0.3 * 0.1) * 0.7);
+}
+
+TEST_CASE("Compiled Expression Compiles Several Expressions Together", "[CompiledExpression]")
+{
+    const Oasis::Variable x { "x" };
+    const Oasis::Variable y { "y" };
+
+    // f = x / (x^2 + y), along with its partial derivatives
+    const Oasis::Add sum { Oasis::Exponent { x, Oasis::Real { 2.0 } }, y };
+    const Oasis::Divide f { x, sum };
+    const Oasis::Divide dfdx { Oasis::Subtract { sum, Oasis::Multiply { Oasis::Real { 2.0 }, Oasis::Multiply { x, x } } }, Oasis::Multiply { sum, sum } };
+    const Oasis::Negate dfdy { Oasis::Divide { x, Oasis::Multiply { sum, sum } } };
+
+    const std::array<const Oasis::Expression*, 3> expressions { &f, &dfdx, &dfdy };
+    const Oasis::CompiledExpression compiled { expressions, { "x", "y" } };
+    REQUIRE(compiled.GetOutputCount() == 3);
+
+    std::size_t separateSize = 0;
+    const std::array values { 1.25, 3.0 };
+    std::array<double, 3> outputs {};
+    compiled.Evaluate(values, outputs);
+
+    for (std::size_t i = 0; i < expressions.size(); ++i) {
+        const Oasis::CompiledExpression separate { *expressions[i], { "x", "y" } };
+        separateSize += separate.GetInstructions().size();
+        REQUIRE(std::abs(outputs[i] - separate.Evaluate(values)) < 1e-12);
+    }
+
+    REQUIRE(compiled.GetInstructions().size() < separateSize);
+    REQUIRE(compiled.Evaluate(values) == outputs[0]);
+
+    std::array<double, 2> gradient {};
+    REQUIRE(compiled.EvaluateGradient(values, gradient) == outputs[0]);
+    REQUIRE(std::abs(gradient[0] - outputs[1]) < 1e-9);
+    REQUIRE(std::abs(gradient[1] - outputs[2]) < 1e-9);
+
+    std::array<double, 2> wrongSize {};
+    REQUIRE_THROWS_AS(compiled.Evaluate(values, wrongSize), std::invalid_argument);
+    REQUIRE_THROWS_AS(Oasis::CompiledExpression(std::span<const Oasis::Expression* const> {}), std::invalid_argument);
+}
@@ -0,0 +1,134 @@
+#include <thread>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "Oasis/Add.hpp"
+#include "Oasis/ExpressionArena.hpp"
+#include "Oasis/ExpressionStore.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Variable.hpp"
+
+TEST_CASE("Arena Allocates Nodes", "[ExpressionArena]")
+{
+    REQUIRE(Oasis::ExpressionArena::Current() == nullptr);
+
+    Oasis::ExpressionArena arena;
+    REQUIRE(Oasis::ExpressionArena::Current() == &arena);
+
+    const auto node = Oasis::Real { 1.0 }.Copy();
+    REQUIRE(arena.BytesAllocated() >= sizeof(Oasis::Real));
+}
+
+TEST_CASE("Arena Evaluate Promotes Result", "[ExpressionArena]")
+{
+    const Oasis::Add add {
+        Oasis::Multiply { Oasis::Real { 2.0 }, Oasis::Variable { "x" } },
+        Oasis::Multiply { Oasis::Real { 3.0 }, Oasis::Variable { "x" } }
+    };
+
+    std::unique_ptr<Oasis::Expression> simplified;
+
+    {
+        Oasis::ExpressionArena arena;
+        simplified = arena.Evaluate([&] { return add.Simplify(); });
+        REQUIRE(arena.BytesAllocated() > 0);
+    }
+
+    REQUIRE(Oasis::ExpressionArena::Current() == nullptr);
+
+    const Oasis::Multiply expected { Oasis::Real { 5.0 }, Oasis::Variable { "x" } };
+    REQUIRE(simplified->Equals(expected));
+}
+
+TEST_CASE("Arena Frees Heap Nodes", "[ExpressionArena]")
+{
+    auto node = Oasis::Variable { "x" }.Copy();
+
+    Oasis::ExpressionArena arena;
+    node.reset();
+
+    REQUIRE(arena.BytesAllocated() == 0);
+}
+
+TEST_CASE("Arenas Nest", "[ExpressionArena]")
+{
+    Oasis::ExpressionArena outer;
+
+    {
+        Oasis::ExpressionArena inner;
+        REQUIRE(Oasis::ExpressionArena::Current() == &inner);
+
+        const auto node = Oasis::Real { 1.0 }.Copy();
+        REQUIRE(inner.BytesAllocated() > 0);
+        REQUIRE(outer.BytesAllocated() == 0);
+    }
+
+    REQUIRE(Oasis::ExpressionArena::Current() == &outer);
+}
+
+TEST_CASE("Interned Nodes Are Not Placed In Arena", "[ExpressionArena]")
+{
+    Oasis::ExpressionStore store;
+    std::shared_ptr<const Oasis::Expression> interned;
+
+    {
+        Oasis::ExpressionArena arena;
+        const auto add = Oasis::Add { Oasis::Variable { "x" }, Oasis::Real { 2.0 } }.Copy();
+        const std::size_t before = arena.BytesAllocated();
+
+        interned = store.Intern(*add);
+        REQUIRE(arena.BytesAllocated() == before);
+    }
+
+    // Reuse the memory the arena released, then check the interned nodes are intact.
+    Oasis::ExpressionArena arena;
+    const Oasis::Add expected { Oasis::Variable { "x" }, Oasis::Real { 2.0 } };
+    const auto copy = expected.Copy();
+
+    REQUIRE(interned->Equals(expected));
+    REQUIRE(store.Intern(*copy) == interned);
+    REQUIRE(store.Size() == 3);
+}
+
+TEST_CASE("Arena Nodes Are Released With Arena", "[ExpressionArena]")
+{
+    std::size_t firstBytes = 0;
+
+    {
+        Oasis::ExpressionArena arena;
+        const auto node = Oasis::Variable { "x" }.Copy();
+        firstBytes = arena.BytesAllocated();
+    }
+
+    REQUIRE(Oasis::ExpressionArena::Current() == nullptr);
+
+    // A fresh arena starts empty and its nodes are independent of the previous arena's.
+    Oasis::ExpressionArena arena;
+    REQUIRE(arena.BytesAllocated() == 0);
+
+    const auto node = Oasis::Variable { "y" }.Copy();
+    REQUIRE(arena.BytesAllocated() == firstBytes);
+    REQUIRE(node->Equals(Oasis::Variable { "y" }));
+
+    const auto promoted = Oasis::ExpressionArena::Promote(*node);
+    REQUIRE(arena.BytesAllocated() == firstBytes);
+    REQUIRE(promoted->Equals(Oasis::Variable { "y" }));
+}
+
+TEST_CASE("Nodes Are Freed On Other Threads", "[ExpressionArena]")
+{
+    auto heapNode = Oasis::Variable { "x" }.Copy();
+
+    Oasis::ExpressionArena arena;
+    auto arenaNode = Oasis::Variable { "y" }.Copy();
+    const std::size_t before = arena.BytesAllocated();
+
+    // The other thread has no arena of its own, so it finds the arena node among this thread's.
+    std::thread { [&] {
+        heapNode.reset();
+        arenaNode.reset();
+    } }.join();
+
+    REQUIRE(arena.BytesAllocated() == before);
+}
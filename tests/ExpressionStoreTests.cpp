@@ -0,0 +1,70 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "Oasis/Add.hpp"
+#include "Oasis/ExpressionStore.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Negate.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Undefined.hpp"
+#include "Oasis/Variable.hpp"
+
+TEST_CASE("Copy Shares Operands", "[ExpressionStore]")
+{
+    const Oasis::Add<Oasis::Expression> add {
+        Oasis::Multiply { Oasis::Real { 2.0 }, Oasis::Variable { "x" } },
+        Oasis::Variable { "y" }
+    };
+
+    const auto copy = add.Copy();
+    const auto& copiedAdd = dynamic_cast<const Oasis::Add<Oasis::Expression>&>(*copy);
+
+    REQUIRE(&copiedAdd.GetMostSigOp() == &add.GetMostSigOp());
+    REQUIRE(&copiedAdd.GetLeastSigOp() == &add.GetLeastSigOp());
+    REQUIRE(copy->Equals(add));
+}
+
+TEST_CASE("Generalize Shares Operands", "[ExpressionStore]")
+{
+    const Oasis::Negate negate { Oasis::Variable { "x" } };
+    const auto generalized = negate.Generalize();
+    const auto& generalizedNegate = dynamic_cast<const Oasis::Negate<Oasis::Expression>&>(*generalized);
+
+    REQUIRE(generalizedNegate.GetOperand().Is<Oasis::Variable>());
+    REQUIRE(&generalizedNegate.GetOperand() == &negate.GetOperand());
+}
+
+TEST_CASE("Intern Deduplicates Identical Subtrees", "[ExpressionStore]")
+{
+    Oasis::ExpressionStore store;
+
+    const Oasis::Multiply<Oasis::Expression> expr {
+        Oasis::Add { Oasis::Variable { "x" }, Oasis::Real { 1.0 } },
+        Oasis::Add { Oasis::Variable { "x" }, Oasis::Real { 1.0 } }
+    };
+
+    const auto interned = store.Intern(expr);
+    const auto& multiply = dynamic_cast<const Oasis::Multiply<Oasis::Expression>&>(*interned);
+
+    REQUIRE(interned->Equals(expr));
+    REQUIRE(&multiply.GetMostSigOp() == &multiply.GetLeastSigOp());
+
+    // x, 1, x + 1, and (x + 1) * (x + 1)
+    REQUIRE(store.Size() == 4);
+
+    const auto reinterned = store.Intern(*expr.Copy());
+    REQUIRE(reinterned == interned);
+    REQUIRE(store.Size() == 4);
+}
+
+TEST_CASE("Intern Distinguishes Leaf Values", "[ExpressionStore]")
+{
+    Oasis::ExpressionStore store;
+
+    REQUIRE(store.Intern(Oasis::Real { 1.0 }) == store.Intern(Oasis::Real { 1.0 }));
+    REQUIRE(store.Intern(Oasis::Real { 1.0 }) != store.Intern(Oasis::Real { 2.0 }));
+    REQUIRE(store.Intern(Oasis::Variable { "x" }) != store.Intern(Oasis::Variable { "y" }));
+    REQUIRE(store.Intern(Oasis::Undefined {}) != store.Intern(Oasis::Undefined {}));
+
+    store.Clear();
+    REQUIRE(store.Size() == 0);
+}
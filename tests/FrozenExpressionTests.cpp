@@ -0,0 +1,272 @@
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+#include "catch2/matchers/catch_matchers_floating_point.hpp"
+
+#include "Oasis/Add.hpp"
+#include "Oasis/Derivative.hpp"
+#include "Oasis/Divide.hpp"
+#include "Oasis/Exponent.hpp"
+#include "Oasis/FrozenExpression.hpp"
+#include "Oasis/Imaginary.hpp"
+#include "Oasis/Integral.hpp"
+#include "Oasis/Log.hpp"
+#include "Oasis/Matrix.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Negate.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Subtract.hpp"
+#include "Oasis/Variable.hpp"
+
+TEST_CASE("Frozen Expressions Thaw to Equal Expressions", "[FrozenExpression]")
+{
+    Oasis::MatrixXXD values(2, 2);
+    values << 1.0, 0.1, -2.5, 1e-300;
+
+    const Oasis::Add expression {
+        Oasis::Subtract {
+            Oasis::Multiply { Oasis::Real { 0.1 }, Oasis::Variable { "x" } },
+            Oasis::Divide { Oasis::Imaginary {}, Oasis::Matrix { values } } },
+        Oasis::Add {
+            Oasis::Exponent { Oasis::Log { Oasis::Real { 10.0 }, Oasis::Variable { "y" } }, Oasis::Negate { Oasis::Variable { "x" } } },
+            Oasis::Add {
+                Oasis::Derivative { Oasis::Variable { "z" }, Oasis::Variable { "x" } },
+                Oasis::Integral { Oasis::Variable { "z" }, Oasis::Variable { "x" } } } }
+    };
+
+    const auto frozen = Oasis::FrozenExpression::Freeze(expression);
+
+    REQUIRE(frozen.GetNodeCount() == expression.NodeCount());
+    REQUIRE(frozen.GetVariableCount() == 3);
+    REQUIRE(frozen.GetType(frozen.GetRoot()) == Oasis::ExpressionType::Add);
+
+    const auto thawed = frozen.Thaw();
+    REQUIRE(thawed->Equals(expression));
+    REQUIRE(thawed->Hash() == expression.Hash());
+    REQUIRE(Oasis::FrozenExpression::Freeze(*thawed).Hash() == frozen.Hash());
+}
+
+TEST_CASE("Frozen Expressions Are Traversed in Postorder", "[FrozenExpression]")
+{
+    const Oasis::Subtract expression { Oasis::Variable { "x" }, Oasis::Real { 2.0 } };
+    const auto frozen = Oasis::FrozenExpression::Freeze(expression);
+
+    REQUIRE(frozen.GetNodeCount() == 3);
+
+    const std::uint32_t root = frozen.GetRoot();
+    const std::uint32_t minuend = frozen.GetChild(root, 0);
+    const std::uint32_t subtrahend = frozen.GetChild(root, 1);
+
+    REQUIRE(minuend < root);
+    REQUIRE(subtrahend < root);
+    REQUIRE(frozen.GetName(minuend) == "x");
+    REQUIRE(frozen.GetValue(subtrahend) == 2.0);
+    REQUIRE(frozen.GetChild(minuend, 0) == Oasis::FrozenExpression::npos);
+}
+
+TEST_CASE("Frozen Expressions Store Shared Operands Once", "[FrozenExpression]")
+{
+    Oasis::Multiply<> product;
+    product.SetLeastSigOp(Oasis::Add<> { Oasis::Variable { "x" }, Oasis::Real { 1.0 } });
+    product.mostSigOp = product.leastSigOp;
+
+    const auto frozen = Oasis::FrozenExpression::Freeze(product);
+    REQUIRE(frozen.GetNodeCount() == 4);
+
+    const auto thawed = frozen.Thaw();
+    const auto& thawedProduct = static_cast<const Oasis::Multiply<>&>(*thawed);
+    REQUIRE(&thawedProduct.GetMostSigOp() == &thawedProduct.GetLeastSigOp());
+    REQUIRE(thawed->Equals(product));
+}
+
+TEST_CASE("Frozen Expressions Compare Like Expressions", "[FrozenExpression]")
+{
+    const Oasis::Add first { Oasis::Add { Oasis::Variable { "x" }, Oasis::Real { 1.0 } }, Oasis::Variable { "y" } };
+    const Oasis::Add regrouped { Oasis::Variable { "x" }, Oasis::Add { Oasis::Real { 1.0 }, Oasis::Variable { "y" } } };
+    const Oasis::Subtract difference { Oasis::Variable { "x" }, Oasis::Real { 1.0 } };
+    const Oasis::Subtract swapped { Oasis::Real { 1.0 }, Oasis::Variable { "x" } };
+
+    const std::array<const Oasis::Expression*, 4> expressions { &first, &regrouped, &difference, &swapped };
+
+    for (const auto* lhs : expressions) {
+        for (const auto* rhs : expressions) {
+            const auto frozenLhs = Oasis::FrozenExpression::Freeze(*lhs);
+            const auto frozenRhs = Oasis::FrozenExpression::Freeze(*rhs);
+
+            REQUIRE(frozenLhs.Equals(frozenRhs) == lhs->Equals(*rhs));
+
+            if (lhs->Equals(*rhs)) {
+                REQUIRE(frozenLhs.Hash() == frozenRhs.Hash());
+            }
+
+            REQUIRE(frozenLhs.StructurallyEquivalent(frozenRhs) == lhs->StructurallyEquivalent(*rhs));
+        }
+    }
+}
+
+TEST_CASE("Frozen Expressions Evaluate in Place", "[FrozenExpression]")
+{
+    const Oasis::Add expression {
+        Oasis::Divide { Oasis::Exponent { Oasis::Variable { "x" }, Oasis::Real { 2.0 } }, Oasis::Variable { "y" } },
+        Oasis::Subtract { Oasis::Log { Oasis::Real { 2.0 }, Oasis::Variable { "x" } }, Oasis::Negate { Oasis::Variable { "y" } } }
+    };
+
+    const auto frozen = Oasis::FrozenExpression::Freeze(expression);
+
+    REQUIRE(frozen.GetVariable(0) == "x");
+    REQUIRE(frozen.GetVariable(1) == "y");
+    REQUIRE_THAT(frozen.Evaluate(std::array { 8.0, 4.0 }), Catch::Matchers::WithinRel(8.0 * 8.0 / 4.0 + 3.0 + 4.0));
+    REQUIRE_THROWS_AS(frozen.Evaluate(std::array { 8.0 }), std::invalid_argument);
+
+    const auto imaginary = Oasis::FrozenExpression::Freeze(Oasis::Add { Oasis::Imaginary {}, Oasis::Real { 1.0 } });
+    REQUIRE_THROWS_AS(imaginary.Evaluate({}), std::invalid_argument);
+}
+
+TEST_CASE("Frozen Expressions Are Viewed in Place", "[FrozenExpression]")
+{
+    const Oasis::Multiply expression { Oasis::Variable { "x" }, Oasis::Real { 0.1 } };
+    const auto frozen = Oasis::FrozenExpression::Freeze(expression);
+
+    // Words rather than bytes, so that the copy is aligned like a mapped file.
+    const auto bytes = frozen.GetBytes();
+    std::vector<std::uint64_t> buffer(bytes.size() / sizeof(std::uint64_t));
+    std::memcpy(buffer.data(), bytes.data(), bytes.size());
+
+    const auto viewed = Oasis::FrozenExpression::FromBytes(std::as_bytes(std::span { buffer }));
+
+    REQUIRE(viewed.GetBytes().data() == reinterpret_cast<const std::byte*>(buffer.data()));
+    REQUIRE(viewed.Equals(frozen));
+    REQUIRE(viewed.Hash() == frozen.Hash());
+    REQUIRE(viewed.Evaluate(std::array { 5.0 }) == 5.0 * 0.1);
+    REQUIRE(viewed.Thaw()->Equals(expression));
+}
+
+TEST_CASE("Frozen Expressions Reject Malformed Buffers", "[FrozenExpression]")
+{
+    const Oasis::Multiply expression { Oasis::Variable { "x" }, Oasis::Real { 0.1 } };
+    const auto frozen = Oasis::FrozenExpression::Freeze(expression);
+    const auto bytes = frozen.GetBytes();
+
+    const auto view = [](const std::vector<std::uint64_t>& buffer, const std::size_t size) {
+        return Oasis::FrozenExpression::FromBytes(std::as_bytes(std::span { buffer }).first(size));
+    };
+
+    std::vector<std::uint64_t> buffer(bytes.size() / sizeof(std::uint64_t));
+    std::memcpy(buffer.data(), bytes.data(), bytes.size());
+
+    for (std::size_t size = 0; size < bytes.size(); size += 4) {
+        REQUIRE_THROWS_AS(view(buffer, size), std::invalid_argument);
+    }
+
+    REQUIRE_THROWS_AS(Oasis::FrozenExpression::FromBytes(std::as_bytes(std::span { buffer }).subspan(4)), std::invalid_argument);
+
+    auto badMagic = buffer;
+    reinterpret_cast<char*>(badMagic.data())[0] = 'X';
+    REQUIRE_THROWS_AS(view(badMagic, bytes.size()), std::invalid_argument);
+
+    // The root is the last node, and an operand that does not precede its parent is rejected.
+    const std::uint32_t root = frozen.GetRoot();
+    const std::size_t firstOffset = 32 + 8 * frozen.GetNodeCount() + 8 * 1;
+
+    auto cyclic = buffer;
+    std::memcpy(reinterpret_cast<std::byte*>(cyclic.data()) + firstOffset + 4 * root, &root, sizeof root);
+    REQUIRE_THROWS_AS(view(cyclic, bytes.size()), std::invalid_argument);
+
+    // The hashes follow the header.
+    auto badHash = buffer;
+    badHash[4] ^= 1;
+    REQUIRE_THROWS_AS(view(badHash, bytes.size()), std::invalid_argument);
+}
+
+TEST_CASE("Frozen Expressions Reject Deep Buffers", "[FrozenExpression]")
+{
+    // A chain of negations of a variable is one node taller than it has negations.
+    const auto chain = [](const int negations) {
+        std::shared_ptr<const Oasis::Expression> expression = std::make_shared<Oasis::Variable>("x");
+
+        for (int i = 0; i < negations; ++i) {
+            auto negated = std::make_shared<Oasis::Negate<Oasis::Expression>>();
+            negated->SetOperand(expression);
+            expression = std::move(negated);
+        }
+
+        return expression;
+    };
+
+    const auto tallest = chain(4095);
+    const auto frozen = Oasis::FrozenExpression::Freeze(*tallest);
+    REQUIRE(frozen.GetNodeCount() == 4096);
+
+    std::vector<std::uint64_t> buffer(frozen.GetBytes().size() / sizeof(std::uint64_t));
+    std::memcpy(buffer.data(), frozen.GetBytes().data(), frozen.GetBytes().size());
+    REQUIRE(Oasis::FrozenExpression::FromBytes(std::as_bytes(std::span { buffer })).Equals(frozen));
+
+    // Freezing checks the buffer it writes like any other.
+    const auto tooTall = chain(4096);
+    REQUIRE_THROWS_AS(Oasis::FrozenExpression::Freeze(*tooTall), std::invalid_argument);
+}
+
+TEST_CASE("Frozen Expressions Hash Alike on Every Platform", "[FrozenExpression]")
+{
+    const Oasis::Add expression { Oasis::Variable { "x" }, Oasis::Real { 1.0 } };
+    REQUIRE(Oasis::FrozenExpression::Freeze(expression).Hash() == 0x3c9ee9cbddb17432ULL);
+
+    const auto zero = Oasis::FrozenExpression::Freeze(Oasis::Real { 0.0 });
+    const auto negativeZero = Oasis::FrozenExpression::Freeze(Oasis::Real { -0.0 });
+    REQUIRE(zero.Equals(negativeZero));
+    REQUIRE(zero.Hash() == negativeZero.Hash());
+}
+
+TEST_CASE("Frozen Expressions Compare Shared Operands Once", "[FrozenExpression]")
+{
+    // Doubling a sum 60 times describes a sum of 2^61 variables in 63 nodes.
+    Oasis::Add<> sum { Oasis::Variable { "x" }, Oasis::Variable { "x" } };
+
+    for (int i = 0; i < 60; ++i) {
+        Oasis::Add<> doubled;
+        doubled.mostSigOp = sum.Copy();
+        doubled.leastSigOp = doubled.mostSigOp;
+        sum = std::move(doubled);
+    }
+
+    Oasis::Add<> lhs;
+    lhs.mostSigOp = sum.Copy();
+    lhs.SetLeastSigOp(Oasis::Variable { "y" });
+
+    Oasis::Add<> rhs;
+    rhs.SetMostSigOp(Oasis::Variable { "y" });
+    rhs.leastSigOp = lhs.mostSigOp;
+
+    Oasis::Add<> unequal;
+    unequal.mostSigOp = lhs.mostSigOp;
+    unequal.SetLeastSigOp(Oasis::Variable { "z" });
+
+    const auto frozenLhs = Oasis::FrozenExpression::Freeze(lhs);
+    const auto frozenRhs = Oasis::FrozenExpression::Freeze(rhs);
+    const auto frozenUnequal = Oasis::FrozenExpression::Freeze(unequal);
+
+    REQUIRE(frozenLhs.GetNodeCount() == 65);
+    REQUIRE(frozenLhs.Equals(Oasis::FrozenExpression::Freeze(lhs)));
+    REQUIRE(frozenLhs.Equals(frozenRhs));
+    REQUIRE(!frozenLhs.Equals(frozenUnequal));
+    REQUIRE(frozenLhs.StructurallyEquivalent(frozenUnequal));
+}
+
+TEST_CASE("Frozen Expressions Keep Missing Operands", "[FrozenExpression]")
+{
+    Oasis::Add<> missing;
+    missing.SetMostSigOp(Oasis::Real { 1.0 });
+
+    const auto frozen = Oasis::FrozenExpression::Freeze(missing);
+    REQUIRE(frozen.GetChild(frozen.GetRoot(), 1) == Oasis::FrozenExpression::npos);
+    REQUIRE_THROWS_AS(frozen.Evaluate({}), std::invalid_argument);
+
+    const auto thawed = frozen.Thaw();
+    const auto& thawedAdd = static_cast<const Oasis::Add<>&>(*thawed);
+    REQUIRE(thawedAdd.HasMostSigOp());
+    REQUIRE(!thawedAdd.HasLeastSigOp());
+}
@@ -0,0 +1,84 @@
+#include <unordered_map>
+#include <unordered_set>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "Oasis/Add.hpp"
+#include "Oasis/Divide.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Negate.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Subtract.hpp"
+#include "Oasis/Variable.hpp"
+
+TEST_CASE("Equal Expressions Hash Alike", "[Hash]")
+{
+    const Oasis::Add<Oasis::Expression> add {
+        Oasis::Multiply { Oasis::Real { 2.0 }, Oasis::Variable { "x" } },
+        Oasis::Variable { "y" }
+    };
+
+    const auto copy = add.Copy();
+    REQUIRE(add.Hash() == copy->Hash());
+    REQUIRE(add.Hash() == add.Generalize()->Hash());
+    REQUIRE(std::hash<Oasis::Expression> {}(add) == add.Hash());
+
+    REQUIRE(Oasis::Real { 0.0 }.Hash() == Oasis::Real { -0.0 }.Hash());
+}
+
+TEST_CASE("Commutative Hash Ignores Operand Order", "[Hash]")
+{
+    const Oasis::Add<Oasis::Variable, Oasis::Real> add { Oasis::Variable { "x" }, Oasis::Real { 1.0 } };
+    const Oasis::Add<Oasis::Real, Oasis::Variable> swapped { Oasis::Real { 1.0 }, Oasis::Variable { "x" } };
+    REQUIRE(add.Hash() == swapped.Hash());
+
+    const Oasis::Subtract<Oasis::Variable, Oasis::Real> subtract { Oasis::Variable { "x" }, Oasis::Real { 1.0 } };
+    const Oasis::Subtract<Oasis::Real, Oasis::Variable> swappedSubtract { Oasis::Real { 1.0 }, Oasis::Variable { "x" } };
+    REQUIRE(subtract.Hash() != swappedSubtract.Hash());
+}
+
+TEST_CASE("Associative Hash Ignores Grouping", "[Hash]")
+{
+    const Oasis::Multiply<Oasis::Expression> left {
+        Oasis::Multiply { Oasis::Variable { "x" }, Oasis::Variable { "y" } },
+        Oasis::Variable { "z" }
+    };
+
+    const Oasis::Multiply<Oasis::Expression> right {
+        Oasis::Variable { "x" },
+        Oasis::Multiply { Oasis::Variable { "z" }, Oasis::Variable { "y" } }
+    };
+
+    REQUIRE(left.Hash() == right.Hash());
+    REQUIRE(left.Equals(right));
+}
+
+TEST_CASE("Hash Distinguishes Different Expressions", "[Hash]")
+{
+    REQUIRE(Oasis::Real { 1.0 }.Hash() != Oasis::Real { 2.0 }.Hash());
+    REQUIRE(Oasis::Variable { "x" }.Hash() != Oasis::Variable { "y" }.Hash());
+    REQUIRE(Oasis::Negate { Oasis::Variable { "x" } }.Hash() != Oasis::Variable { "x" }.Hash());
+
+    const Oasis::Divide<Oasis::Variable> divide { Oasis::Variable { "x" }, Oasis::Variable { "y" } };
+    const Oasis::Multiply<Oasis::Variable> multiply { Oasis::Variable { "x" }, Oasis::Variable { "y" } };
+    REQUIRE(divide.Hash() != multiply.Hash());
+    REQUIRE_FALSE(divide.Equals(multiply));
+}
+
+TEST_CASE("Expressions As Unordered Keys", "[Hash]")
+{
+    std::unordered_map<std::unique_ptr<Oasis::Expression>, int, Oasis::ExpressionHash, Oasis::ExpressionEqual> counts;
+
+    counts[Oasis::Add { Oasis::Variable { "x" }, Oasis::Real { 1.0 } }.Copy()] += 1;
+    counts[Oasis::Add { Oasis::Real { 1.0 }, Oasis::Variable { "x" } }.Copy()] += 1;
+    counts[Oasis::Variable { "x" }.Copy()] += 1;
+
+    REQUIRE(counts.size() == 2);
+    REQUIRE(counts[Oasis::Variable { "x" }.Copy()] == 1);
+
+    std::unordered_set<const Oasis::Expression*, Oasis::ExpressionHash, Oasis::ExpressionEqual> seen;
+    const Oasis::Real one { 1.0 };
+    const Oasis::Real anotherOne { 1.0 };
+    seen.insert(&one);
+    REQUIRE(seen.contains(&anotherOne));
+}
@@ -178,4 +178,125 @@ TEST_CASE("Solve Matrix", "[Linear]")
     auto x = Oasis::SolveLinearSystems(A);
     REQUIRE_THAT(x(0), Catch::Matchers::WithinAbs(-4.0, EPSILON));
     REQUIRE_THAT(x(1), Catch::Matchers::WithinAbs(4.5, EPSILON));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Sparse Construction Matches Dense Construction", "[Linear]")
+{
+    Oasis::Add add1 { // 4x + 7y + 2
+        Oasis::Add {
+            Oasis::Multiply { Oasis::Real { 4.0 }, Oasis::Variable { "x" } },
+            Oasis::Multiply { Oasis::Real { 7.0 }, Oasis::Variable { "y" } } },
+        Oasis::Real { 2.0 }
+    };
+    Oasis::Add add2 { // z + 3y + 3
+        Oasis::Add {
+            Oasis::Variable { "z" },
+            Oasis::Multiply { Oasis::Variable { "y" }, Oasis::Real { 3.0 } } },
+        Oasis::Real { 3.0 }
+    };
+    Oasis::Multiply add3 { Oasis::Real { -2.0 }, Oasis::Variable { "x" } }; // -2x
+
+    std::vector<std::unique_ptr<Oasis::Expression>> exprs;
+    exprs.push_back(add1.Generalize());
+    exprs.push_back(add2.Generalize());
+    exprs.push_back(add3.Generalize());
+
+    auto [dense, denseVars] = Oasis::ConstructMatrices(exprs);
+    auto [sparse, sparseVars] = Oasis::ConstructSparseMatrices(exprs);
+
+    REQUIRE(denseVars == sparseVars);
+    REQUIRE(denseVars == std::map<std::string, Eigen::Index> { { "x", 0 }, { "y", 1 }, { "z", 2 } });
+    REQUIRE(sparse.first.nonZeros() == 5);
+    REQUIRE(Oasis::MatrixXXD(sparse.first) == dense.first);
+    REQUIRE(sparse.second == dense.second);
+
+    Oasis::MatrixXXD expected(3, 3);
+    expected << 4, 7, 0, 0, 3, 1, -2, 0, 0;
+    REQUIRE(dense.first == expected);
+
+    Oasis::Matrix1D expectedConstants(3);
+    expectedConstants << -2.0, -3.0, 0.0;
+    REQUIRE(dense.second == expectedConstants);
+}
+
+TEST_CASE("Linear Construction Rejects More Variables Than Equations", "[Linear]")
+{
+    Oasis::Add add { Oasis::Variable { "x" }, Oasis::Variable { "y" } };
+
+    std::vector<std::unique_ptr<Oasis::Expression>> exprs;
+    exprs.push_back(add.Generalize());
+
+    REQUIRE_THROWS_AS(Oasis::ConstructMatrices(exprs), std::invalid_argument);
+    REQUIRE_THROWS_AS(Oasis::ConstructSparseMatrices(exprs), std::invalid_argument);
+}
+
+TEST_CASE("Linear Solve Large Sparse System", "[Linear]")
+{
+    // -1.5 x_{i-1} + 4 x_i - 0.5 x_{i+1} + c_i = 0, with c_i chosen so that x_i = (i % 7) - 3.
+    constexpr int size = 1000;
+
+    const auto solution = [](int i) { return static_cast<double>(i % 7 - 3); };
+    const auto name = [](int i) { return "x" + std::to_string(i); };
+
+    std::vector<std::unique_ptr<Oasis::Expression>> exprs;
+
+    for (int i = 0; i < size; ++i) {
+        double value = 4.0 * solution(i);
+        std::unique_ptr<Oasis::Expression> equation = std::make_unique<Oasis::Multiply<Oasis::Real, Oasis::Variable>>(Oasis::Real { 4.0 }, Oasis::Variable { name(i) });
+
+        if (i > 0) {
+            value += -1.5 * solution(i - 1);
+            equation = std::make_unique<Oasis::Add<>>(*equation, Oasis::Multiply { Oasis::Real { -1.5 }, Oasis::Variable { name(i - 1) } });
+        }
+
+        if (i + 1 < size) {
+            value += -0.5 * solution(i + 1);
+            equation = std::make_unique<Oasis::Add<>>(*equation, Oasis::Multiply { Oasis::Real { -0.5 }, Oasis::Variable { name(i + 1) } });
+        }
+
+        exprs.push_back(std::make_unique<Oasis::Add<>>(*equation, Oasis::Real { -value }));
+    }
+
+    auto sparse = Oasis::ConstructSparseMatrices(exprs);
+    REQUIRE(sparse.first.first.nonZeros() == 3 * size - 2);
+
+    auto result = Oasis::SolveLinearSystems(exprs);
+
+    REQUIRE(result.size() == size);
+
+    for (int i = 0; i < size; ++i) {
+        REQUIRE_THAT(result.at(name(i)), Catch::Matchers::WithinAbs(solution(i), EPSILON));
+    }
+}
+
+TEST_CASE("Linear Solve Reports Singular Systems", "[Linear]")
+{
+    // x + y - 1 = 0 and 2x + 2y - 2 = 0, which is solved densely.
+    std::vector<std::unique_ptr<Oasis::Expression>> dense;
+    dense.push_back(std::make_unique<Oasis::Add<>>(Oasis::Add { Oasis::Variable { "x" }, Oasis::Variable { "y" } }, Oasis::Real { -1.0 }));
+    dense.push_back(std::make_unique<Oasis::Add<>>(
+        Oasis::Add { Oasis::Multiply { Oasis::Real { 2.0 }, Oasis::Variable { "x" } }, Oasis::Multiply { Oasis::Real { 2.0 }, Oasis::Variable { "y" } } },
+        Oasis::Real { -2.0 }));
+
+    REQUIRE(Oasis::SolveLinearSystems(dense).empty());
+
+    // x_i + x_{i+1} - 1 = 0 around a cycle of even length, which is solved sparsely.
+    constexpr int size = 64;
+
+    const auto name = [](int i) { return "x" + std::to_string(i); };
+
+    std::vector<std::unique_ptr<Oasis::Expression>> sparse;
+
+    for (int i = 0; i < size; ++i) {
+        sparse.push_back(std::make_unique<Oasis::Add<>>(Oasis::Add { Oasis::Variable { name(i) }, Oasis::Variable { name((i + 1) % size) } }, Oasis::Real { -1.0 }));
+    }
+
+    REQUIRE(Oasis::SolveLinearSystems(sparse).empty());
+
+    // The same matrices solved directly.
+    auto denseSystem = Oasis::ConstructMatrices(dense);
+    REQUIRE(Oasis::SolveLinearSystems(denseSystem.first.first, denseSystem.first.second).size() == 0);
+
+    auto sparseSystem = Oasis::ConstructSparseMatrices(sparse);
+    REQUIRE(Oasis::SolveLinearSystems(sparseSystem.first.first, sparseSystem.first.second).size() == 0);
+}
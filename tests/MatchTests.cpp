@@ -0,0 +1,67 @@
+#include "catch2/catch_test_macros.hpp"
+
+#include "Oasis/Add.hpp"
+#include "Oasis/Divide.hpp"
+#include "Oasis/Exponent.hpp"
+#include "Oasis/Match.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Negate.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Variable.hpp"
+
+TEST_CASE("Match Leaf Patterns", "[Match]")
+{
+    const Oasis::Real real { 2.0 };
+
+    REQUIRE(Oasis::Match<Oasis::Real>(real) == &real);
+    REQUIRE(Oasis::Match<Oasis::Variable>(real) == nullptr);
+    REQUIRE(Oasis::Match<Oasis::Expression>(real) == &real);
+}
+
+TEST_CASE("Match Borrows Operands", "[Match]")
+{
+    const Oasis::Multiply<Oasis::Expression> multiply { Oasis::Real { 2.0 }, Oasis::Variable { "x" } };
+
+    const auto match = Oasis::Match<Oasis::Multiply<Oasis::Real, Oasis::Variable>>(multiply);
+    REQUIRE(match);
+    REQUIRE(match->GetMostSigOp().GetValue() == 2.0);
+    REQUIRE(match->GetLeastSigOp().GetName() == "x");
+    REQUIRE(&match->GetMostSigOp() == &multiply.GetMostSigOp());
+    REQUIRE(&match->GetExpression() == &multiply);
+
+    REQUIRE_FALSE(Oasis::Match<Oasis::Multiply<Oasis::Real>>(multiply));
+    REQUIRE_FALSE(Oasis::Match<Oasis::Add<Oasis::Real, Oasis::Variable>>(multiply));
+}
+
+TEST_CASE("Match Considers Commutative Property", "[Match]")
+{
+    const Oasis::Multiply<Oasis::Expression> multiply { Oasis::Variable { "x" }, Oasis::Real { 2.0 } };
+
+    const auto match = Oasis::Match<Oasis::Multiply<Oasis::Real, Oasis::Variable>>(multiply);
+    REQUIRE(match);
+    REQUIRE(match->GetMostSigOp().GetValue() == 2.0);
+    REQUIRE(Oasis::Multiply { Oasis::Real { 2.0 }, Oasis::Variable { "x" } }.Equals(*match->Generalize()));
+
+    const Oasis::Divide<Oasis::Expression> divide { Oasis::Variable { "x" }, Oasis::Real { 2.0 } };
+    REQUIRE_FALSE(Oasis::Match<Oasis::Divide<Oasis::Real, Oasis::Variable>>(divide));
+}
+
+TEST_CASE("Match Nested Patterns", "[Match]")
+{
+    const Oasis::Add<Oasis::Expression> add {
+        Oasis::Variable { "y" },
+        Oasis::Multiply { Oasis::Real { 3.0 }, Oasis::Exponent { Oasis::Variable { "x" }, Oasis::Real { 2.0 } } }
+    };
+
+    const auto match = Oasis::Match<Oasis::Add<Oasis::Multiply<Oasis::Real, Oasis::Exponent<Oasis::Variable, Oasis::Real>>, Oasis::Variable>>(add);
+    REQUIRE(match);
+    REQUIRE(match->GetMostSigOp().GetMostSigOp().GetValue() == 3.0);
+    REQUIRE(match->GetMostSigOp().GetLeastSigOp().GetMostSigOp().GetName() == "x");
+    REQUIRE(match->GetLeastSigOp().GetName() == "y");
+
+    const Oasis::Negate negate { Oasis::Variable { "x" } };
+    const auto negateMatch = Oasis::Match<Oasis::Negate<Oasis::Variable>>(negate);
+    REQUIRE(negateMatch);
+    REQUIRE(negateMatch->GetOperand().GetName() == "x");
+    REQUIRE_FALSE(Oasis::Match<Oasis::Negate<Oasis::Real>>(negate));
+}
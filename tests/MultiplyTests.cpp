@@ -9,6 +9,7 @@
 #include "Oasis/Imaginary.hpp"
 #include "Oasis/Multiply.hpp"
 #include "Oasis/Real.hpp"
+#include "Oasis/Variable.hpp"
 
 TEST_CASE("Multiplication", "[Multiply]")
 {
@@ -141,4 +142,27 @@ TEST_CASE("Variadic Multiply Constructor", "[Multiply]")
 
     const auto simplified = multiply.Simplify();
     REQUIRE(expected.Equals(*simplified));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Multiply Combines Many Like Factors", "[Multiply][Associativity]")
+{
+    std::vector<std::unique_ptr<Oasis::Expression>> factors;
+
+    for (int i = 0; i < 300; ++i) {
+        factors.emplace_back(Oasis::Exponent { Oasis::Variable { i % 2 == 0 ? "y" : "x" }, Oasis::Real { static_cast<double>(i) } }.Copy());
+    }
+
+    const auto multiply = Oasis::BuildFromVector<Oasis::Multiply>(factors);
+    const auto simplified = multiply->Simplify();
+
+    const Oasis::Multiply expected {
+        Oasis::Exponent {
+            Oasis::Variable { "x" },
+            Oasis::Real { 22500.0 } },
+        Oasis::Exponent {
+            Oasis::Variable { "y" },
+            Oasis::Real { 22350.0 } }
+    };
+
+    REQUIRE(expected.Equals(*simplified));
+}
@@ -0,0 +1,200 @@
+#include <random>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "Oasis/Add.hpp"
+#include "Oasis/Divide.hpp"
+#include "Oasis/Exponent.hpp"
+#include "Oasis/Log.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Negate.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Runtime.hpp"
+#include "Oasis/Subtract.hpp"
+#include "Oasis/Variable.hpp"
+
+namespace {
+
+// Forces every node onto the parallel path for the lifetime of the guard.
+class ParallelEverywhere {
+public:
+    ParallelEverywhere()
+        : cutoff(Oasis::Runtime::GetSequentialCutoff())
+    {
+        Oasis::Runtime::SetSequentialCutoff(0);
+    }
+
+    ~ParallelEverywhere()
+    {
+        Oasis::Runtime::SetSequentialCutoff(cutoff);
+    }
+
+private:
+    std::size_t cutoff;
+};
+
+auto RandomExpression(std::mt19937& rng, int depth) -> std::unique_ptr<Oasis::Expression>
+{
+    std::uniform_int_distribution<int> pick { 0, depth > 0 ? 9 : 3 };
+
+    switch (const int choice = pick(rng)) {
+    case 0:
+    case 1:
+        return Oasis::Real { static_cast<double>(choice + 1) }.Copy();
+    case 2:
+        return Oasis::Variable { "x" }.Copy();
+    case 3:
+        return Oasis::Variable { "y" }.Copy();
+    default:
+        break;
+    }
+
+    const auto mostSigOp = RandomExpression(rng, depth - 1);
+    const auto leastSigOp = RandomExpression(rng, depth - 1);
+
+    switch (pick(rng) % 6) {
+    case 0:
+        return Oasis::Add<Oasis::Expression> { *mostSigOp, *leastSigOp }.Copy();
+    case 1:
+        return Oasis::Subtract<Oasis::Expression> { *mostSigOp, *leastSigOp }.Copy();
+    case 2:
+        return Oasis::Multiply<Oasis::Expression> { *mostSigOp, *leastSigOp }.Copy();
+    case 3:
+        return Oasis::Divide<Oasis::Expression> { *mostSigOp, *leastSigOp }.Copy();
+    case 4:
+        return Oasis::Exponent<Oasis::Expression> { *mostSigOp, *leastSigOp }.Copy();
+    default:
+        return Oasis::Negate<Oasis::Expression> { *mostSigOp }.Copy();
+    }
+}
+
+auto RequireParity(const Oasis::Expression& expression) -> void
+{
+    const auto sequential = expression.Simplify();
+    const auto parallel = expression.SimplifyAsync();
+
+    REQUIRE((sequential == nullptr) == (parallel == nullptr));
+
+    if (sequential != nullptr) {
+        REQUIRE(parallel->Equals(*sequential));
+    }
+}
+
+} // namespace
+
+TEST_CASE("Parallel Simplify Matches Rules", "[Async][Parity]")
+{
+    const ParallelEverywhere parallel;
+
+    const Oasis::Variable x { "x" };
+    const Oasis::Variable y { "y" };
+
+    // Like terms
+    RequireParity(Oasis::Add { x, x });
+    RequireParity(Oasis::Add { Oasis::Multiply { Oasis::Real { 2.0 }, x }, Oasis::Multiply { Oasis::Real { 3.0 }, x } });
+    RequireParity(Oasis::Subtract { Oasis::Multiply { Oasis::Real { 5.0 }, x }, x });
+
+    // Products and powers
+    RequireParity(Oasis::Multiply { x, x });
+    RequireParity(Oasis::Multiply { Oasis::Exponent { x, Oasis::Real { 2.0 } }, x });
+    RequireParity(Oasis::Multiply { Oasis::Real { 0.0 }, y });
+    RequireParity(Oasis::Exponent { Oasis::Exponent { x, Oasis::Real { 2.0 } }, Oasis::Real { 3.0 } });
+    RequireParity(Oasis::Exponent { x, Oasis::Real { 0.0 } });
+
+    // Quotients
+    RequireParity(Oasis::Divide { Oasis::Multiply { Oasis::Real { 4.0 }, x }, Oasis::Real { 2.0 } });
+    RequireParity(Oasis::Divide { x, x });
+    RequireParity(Oasis::Divide { Oasis::Exponent { x, Oasis::Real { 3.0 } }, x });
+
+    // Logarithms
+    RequireParity(Oasis::Log { x, x });
+    RequireParity(Oasis::Log { Oasis::Real { 2.0 }, Oasis::Real { 8.0 } });
+    RequireParity(Oasis::Log { x, Oasis::Exponent { x, y } });
+
+    // Negation
+    RequireParity(Oasis::Negate { Oasis::Add { x, Oasis::Real { 1.0 } } });
+}
+
+TEST_CASE("Parallel Simplify Matches Random Expressions", "[Async][Parity]")
+{
+    const ParallelEverywhere parallel;
+
+    std::mt19937 rng { 20261017 };
+
+    for (int i = 0; i < 500; ++i) {
+        const auto expression = RandomExpression(rng, 4);
+        RequireParity(*expression);
+    }
+}
+
+TEST_CASE("Parallel Simplify Matches Large Sums", "[Async][Parity]")
+{
+    const ParallelEverywhere parallel;
+
+    std::vector<std::unique_ptr<Oasis::Expression>> ops;
+
+    for (int i = 0; i < 256; ++i) {
+        ops.emplace_back(Oasis::Multiply { Oasis::Real { static_cast<double>(i) }, Oasis::Variable { i % 2 == 0 ? "x" : "y" } }.Copy());
+    }
+
+    RequireParity(*Oasis::BuildFromVector<Oasis::Add>(ops));
+    RequireParity(*Oasis::BuildFromVector<Oasis::Multiply>(ops));
+}
+
+TEST_CASE("Simplify Many Matches Simplify", "[Async][Parity]")
+{
+    std::mt19937 rng { 20261018 };
+
+    std::vector<std::unique_ptr<Oasis::Expression>> owned;
+
+    for (int i = 0; i < 200; ++i) {
+        owned.emplace_back(RandomExpression(rng, 4));
+    }
+
+    std::vector<const Oasis::Expression*> batch;
+
+    for (const auto& expression : owned) {
+        batch.push_back(expression.get());
+    }
+
+    // Duplicates and gaps
+    batch.push_back(owned.front().get());
+    batch.push_back(nullptr);
+    batch.push_back(owned.back().get());
+
+    for (const std::size_t cutoff : { 0, 8, 256 }) {
+        const std::size_t previous = Oasis::Runtime::GetSequentialCutoff();
+        Oasis::Runtime::SetSequentialCutoff(cutoff);
+        const auto results = Oasis::SimplifyMany(batch);
+        Oasis::Runtime::SetSequentialCutoff(previous);
+
+        REQUIRE(results.size() == batch.size());
+
+        for (std::size_t i = 0; i < batch.size(); ++i) {
+            if (batch[i] == nullptr) {
+                REQUIRE(results[i] == nullptr);
+                continue;
+            }
+
+            const auto expected = batch[i]->Simplify();
+            REQUIRE((expected == nullptr) == (results[i] == nullptr));
+
+            if (expected != nullptr) {
+                REQUIRE(results[i]->Identical(*expected));
+            }
+        }
+    }
+}
+
+TEST_CASE("Simplify Many Keeps Operand Order", "[Async]")
+{
+    const Oasis::Add xy { Oasis::Variable { "x" }, Oasis::Variable { "y" } };
+    const Oasis::Add yx { Oasis::Variable { "y" }, Oasis::Variable { "x" } };
+
+    const std::vector<const Oasis::Expression*> batch { &xy, &yx };
+    const auto results = Oasis::SimplifyMany(batch);
+
+    REQUIRE(results.size() == 2);
+    REQUIRE(results[0]->Identical(*xy.Simplify()));
+    REQUIRE(results[1]->Identical(*yx.Simplify()));
+}
@@ -0,0 +1,85 @@
+#include <limits>
+#include <stdexcept>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "Oasis/Add.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Runtime.hpp"
+#include "Oasis/Variable.hpp"
+
+TEST_CASE("Default Runtime Is Current", "[Runtime]")
+{
+    REQUIRE(&Oasis::Runtime::Current() == &Oasis::Runtime::Default());
+    REQUIRE(Oasis::Runtime::Default().GetWorkerCount() >= 1);
+}
+
+TEST_CASE("Runtime Has Requested Workers", "[Runtime]")
+{
+    Oasis::Runtime runtime { 2 };
+    REQUIRE(runtime.GetWorkerCount() == 2);
+
+    Oasis::Runtime pinned { 1, { 0 } };
+    REQUIRE(pinned.GetWorkerCount() == 1);
+}
+
+#ifdef __linux__
+TEST_CASE("Runtime Rejects Out Of Range CPUs", "[Runtime]")
+{
+    REQUIRE_THROWS_AS(Oasis::Runtime(1, { std::numeric_limits<std::size_t>::max() }), std::invalid_argument);
+}
+#endif
+
+TEST_CASE("Installed Runtime Is Used By Async APIs", "[Runtime][Async]")
+{
+    const Oasis::Add add { Oasis::Real { 1.0 }, Oasis::Real { 2.0 } };
+
+    {
+        Oasis::Runtime runtime { 2 };
+        REQUIRE(Oasis::Runtime::Install(&runtime) == nullptr);
+        REQUIRE(&Oasis::Runtime::Current() == &runtime);
+
+        const auto simplified = add.SimplifyAsync();
+        REQUIRE(simplified->Equals(Oasis::Real { 3.0 }));
+        REQUIRE(add.StructurallyEquivalentAsync(add));
+    }
+
+    REQUIRE(&Oasis::Runtime::Current() == &Oasis::Runtime::Default());
+}
+
+TEST_CASE("Async APIs Accept A Runtime", "[Runtime][Async]")
+{
+    Oasis::Runtime runtime { 1, { 0 } };
+
+    const Oasis::Add add { Oasis::Real { 2.0 }, Oasis::Real { 3.0 } };
+    const auto simplified = add.SimplifyAsync(runtime);
+
+    REQUIRE(simplified->Equals(Oasis::Real { 5.0 }));
+    REQUIRE(add.StructurallyEquivalentAsync(add, runtime));
+}
+
+TEST_CASE("Sequential Cutoff", "[Runtime][Async]")
+{
+    std::vector<std::unique_ptr<Oasis::Expression>> ops;
+
+    for (int i = 0; i < 64; ++i) {
+        ops.emplace_back(Oasis::Multiply { Oasis::Real { static_cast<double>(i) }, Oasis::Variable { i % 2 == 0 ? "x" : "y" } }.Copy());
+    }
+
+    const auto sum = Oasis::BuildFromVector<Oasis::Add>(ops);
+    const auto expected = sum->Simplify();
+
+    const std::size_t cutoff = Oasis::Runtime::GetSequentialCutoff();
+
+    for (const std::size_t nodes : { std::size_t { 0 }, std::size_t { 16 }, sum->NodeCount() + 1 }) {
+        Oasis::Runtime::SetSequentialCutoff(nodes);
+        REQUIRE(sum->StructurallyEquivalentAsync(*sum));
+        REQUIRE_FALSE(sum->StructurallyEquivalentAsync(*expected));
+    }
+
+    Oasis::Runtime::SetSequentialCutoff(sum->NodeCount() + 1);
+    REQUIRE(sum->SimplifyAsync()->Equals(*expected));
+
+    Oasis::Runtime::SetSequentialCutoff(cutoff);
+}
@@ -0,0 +1,132 @@
+#include <vector>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "Oasis/Add.hpp"
+#include "Oasis/Derivative.hpp"
+#include "Oasis/Divide.hpp"
+#include "Oasis/Exponent.hpp"
+#include "Oasis/FrozenExpression.hpp"
+#include "Oasis/Imaginary.hpp"
+#include "Oasis/Integral.hpp"
+#include "Oasis/Log.hpp"
+#include "Oasis/Matrix.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Negate.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/Serialization.hpp"
+#include "Oasis/Subtract.hpp"
+#include "Oasis/Undefined.hpp"
+#include "Oasis/Variable.hpp"
+
+namespace {
+
+// Records the address of every expression it is handed, in visiting order.
+class RecordingVisitor final : public Oasis::SerializationVisitor {
+public:
+    void Serialize(const Oasis::Real& real) override { Record(real); }
+    void Serialize(const Oasis::Imaginary& imaginary) override { Record(imaginary); }
+    void Serialize(const Oasis::Matrix& matrix) override { Record(matrix); }
+    void Serialize(const Oasis::Variable& variable) override { Record(variable); }
+    void Serialize(const Oasis::Undefined& undefined) override { Record(undefined); }
+    void Serialize(const Oasis::Add<>& add) override { VisitBinary(add); }
+    void Serialize(const Oasis::Subtract<>& subtract) override { VisitBinary(subtract); }
+    void Serialize(const Oasis::Multiply<>& multiply) override { VisitBinary(multiply); }
+    void Serialize(const Oasis::Divide<>& divide) override { VisitBinary(divide); }
+    void Serialize(const Oasis::Exponent<>& exponent) override { VisitBinary(exponent); }
+    void Serialize(const Oasis::Log<>& log) override { VisitBinary(log); }
+    void Serialize(const Oasis::Derivative<>& derivative) override { VisitBinary(derivative); }
+    void Serialize(const Oasis::Integral<>& integral) override { VisitBinary(integral); }
+
+    void Serialize(const Oasis::Negate<Oasis::Expression>& negate) override
+    {
+        Record(negate);
+        negate.GetOperand().Serialize(*this);
+    }
+
+    std::vector<const Oasis::Expression*> visited;
+    std::vector<Oasis::ExpressionType> types;
+
+private:
+    void Record(const Oasis::Expression& expression)
+    {
+        visited.push_back(&expression);
+        types.push_back(expression.GetType());
+    }
+
+    template <typename T>
+    void VisitBinary(const T& expression)
+    {
+        Record(expression);
+        expression.GetMostSigOp().Serialize(*this);
+        expression.GetLeastSigOp().Serialize(*this);
+    }
+};
+
+}
+
+TEST_CASE("Serialization Visits Expressions In Place", "[Serialization]")
+{
+    // 2 * x + -log_2(y), with every node generalized
+    const Oasis::Real two { 2.0 };
+    const Oasis::Variable x { "x" };
+    const Oasis::Variable y { "y" };
+    const Oasis::Multiply<> product { static_cast<const Oasis::Expression&>(two), static_cast<const Oasis::Expression&>(x) };
+    const Oasis::Log<> log { static_cast<const Oasis::Expression&>(two), static_cast<const Oasis::Expression&>(y) };
+    const Oasis::Negate<Oasis::Expression> negation { static_cast<const Oasis::Expression&>(log) };
+    const Oasis::Add<> expression { static_cast<const Oasis::Expression&>(product), static_cast<const Oasis::Expression&>(negation) };
+
+    RecordingVisitor visitor;
+    expression.Serialize(visitor);
+
+    // Pre-order, matching GetChild.
+    std::vector<const Oasis::Expression*> expected { &expression };
+
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        for (std::size_t child = 2; child-- > 0;) {
+            if (const Oasis::Expression* op = expected[i]->GetChild(child)) {
+                expected.insert(expected.begin() + static_cast<std::ptrdiff_t>(i) + 1, op);
+            }
+        }
+    }
+
+    REQUIRE(visitor.visited == expected);
+}
+
+TEST_CASE("Serialization Shares Operands Of Specialized Expressions", "[Serialization]")
+{
+    const Oasis::Add<Oasis::Real, Oasis::Variable> add { Oasis::Real { 1.0 }, Oasis::Variable { "x" } };
+    const Oasis::Negate<Oasis::Variable> negate { Oasis::Variable { "y" } };
+
+    RecordingVisitor visitor;
+    add.Serialize(visitor);
+    negate.Serialize(visitor);
+
+    REQUIRE(visitor.visited.size() == 5);
+    REQUIRE(visitor.visited[1] == &add.GetMostSigOp());
+    REQUIRE(visitor.visited[2] == &add.GetLeastSigOp());
+    REQUIRE(visitor.visited[4] == &negate.GetOperand());
+}
+
+TEST_CASE("Serialization Visits Frozen Expressions Like Thawed Ones", "[Serialization]")
+{
+    const Oasis::Add expression {
+        Oasis::Multiply { Oasis::Real { 2.0 }, Oasis::Variable { "x" } },
+        Oasis::Negate { Oasis::Log { Oasis::Real { 2.0 }, Oasis::Variable { "y" } } }
+    };
+    const auto frozen = Oasis::FrozenExpression::Freeze(expression);
+
+    RecordingVisitor thawedVisitor;
+    frozen.Thaw()->Serialize(thawedVisitor);
+
+    RecordingVisitor frozenVisitor;
+    frozen.Serialize(frozenVisitor);
+
+    REQUIRE(frozenVisitor.types == thawedVisitor.types);
+
+    const auto leaf = Oasis::FrozenExpression::Freeze(Oasis::Variable { "x" });
+    RecordingVisitor leafVisitor;
+    leaf.Serialize(leafVisitor);
+
+    REQUIRE(leafVisitor.types == std::vector { Oasis::ExpressionType::Variable });
+}
@@ -0,0 +1,170 @@
+#include <memory>
+
+#include "catch2/catch_test_macros.hpp"
+
+#include "Oasis/Add.hpp"
+#include "Oasis/ExpressionArena.hpp"
+#include "Oasis/Multiply.hpp"
+#include "Oasis/Real.hpp"
+#include "Oasis/SimplifyCache.hpp"
+#include "Oasis/Variable.hpp"
+
+TEST_CASE("Simplify Cache Is Opt In", "[SimplifyCache]")
+{
+    REQUIRE(Oasis::SimplifyCache::Active() == nullptr);
+
+    const auto cache = std::make_shared<Oasis::SimplifyCache>();
+    const Oasis::Add add { Oasis::Real { 1.0 }, Oasis::Real { 2.0 } };
+    const auto simplified = add.Simplify();
+
+    REQUIRE(cache->Size() == 0);
+    REQUIRE(cache->Misses() == 0);
+}
+
+TEST_CASE("Simplify Cache Hits Repeated Expressions", "[SimplifyCache]")
+{
+    const auto cache = std::make_shared<Oasis::SimplifyCache>();
+    Oasis::SimplifyCache::Install(cache);
+
+    const Oasis::Add add {
+        Oasis::Multiply { Oasis::Real { 2.0 }, Oasis::Variable { "x" } },
+        Oasis::Multiply { Oasis::Real { 3.0 }, Oasis::Variable { "x" } }
+    };
+
+    const auto first = add.Simplify();
+    const std::size_t hits = cache->Hits();
+    REQUIRE(cache->Size() > 0);
+    REQUIRE(cache->Misses() > 0);
+
+    const auto second = add.Simplify();
+    REQUIRE(cache->Hits() == hits + 1);
+
+    const Oasis::Multiply expected { Oasis::Real { 5.0 }, Oasis::Variable { "x" } };
+    REQUIRE(first->Equals(expected));
+    REQUIRE(second->Equals(expected));
+
+    const auto async = add.SimplifyAsync();
+    REQUIRE(async->Equals(expected));
+    REQUIRE(cache->Hits() == hits + 2);
+
+    Oasis::SimplifyCache::Install(nullptr);
+}
+
+TEST_CASE("Simplify Cache Evicts Least Recently Used", "[SimplifyCache]")
+{
+    const auto cache = std::make_shared<Oasis::SimplifyCache>(2);
+    Oasis::SimplifyCache::Install(cache);
+
+    const Oasis::Add first { Oasis::Real { 1.0 }, Oasis::Real { 2.0 } };
+    const Oasis::Add second { Oasis::Real { 3.0 }, Oasis::Real { 4.0 } };
+    const Oasis::Add third { Oasis::Real { 5.0 }, Oasis::Real { 6.0 } };
+
+    const auto a = first.Simplify();
+    const auto b = second.Simplify();
+    const auto c = first.Simplify();
+    const auto d = third.Simplify();
+
+    REQUIRE(cache->Size() == 2);
+    REQUIRE(cache->Evictions() == 1);
+    REQUIRE(cache->Find(first) != nullptr);
+    REQUIRE(cache->Find(second) == nullptr);
+    REQUIRE(cache->Find(third) != nullptr);
+
+    Oasis::SimplifyCache::Install(nullptr);
+}
+
+TEST_CASE("Simplify Cache Respects Memory Limit", "[SimplifyCache]")
+{
+    const auto cache = std::make_shared<Oasis::SimplifyCache>(1024, 1);
+    Oasis::SimplifyCache::Install(cache);
+
+    const Oasis::Add add { Oasis::Real { 1.0 }, Oasis::Real { 2.0 } };
+    const auto simplified = add.Simplify();
+
+    REQUIRE(cache->Size() == 0);
+    REQUIRE(cache->BytesUsed() == 0);
+
+    Oasis::SimplifyCache::Install(nullptr);
+}
+
+TEST_CASE("Simplify Cache Outlives Arenas", "[SimplifyCache][ExpressionArena]")
+{
+    const auto cache = std::make_shared<Oasis::SimplifyCache>();
+    Oasis::SimplifyCache::Install(cache);
+
+    const Oasis::Add add { Oasis::Variable { "x" }, Oasis::Variable { "x" } };
+
+    {
+        Oasis::ExpressionArena arena;
+        const auto simplified = add.Copy()->Simplify();
+        REQUIRE(cache->Size() > 0);
+    }
+
+    const auto cached = cache->Find(add);
+    REQUIRE(cached != nullptr);
+
+    const Oasis::Multiply expected { Oasis::Real { 2.0 }, Oasis::Variable { "x" } };
+    REQUIRE(cached->Equals(expected));
+
+    Oasis::SimplifyCache::Install(nullptr);
+}
+
+TEST_CASE("Simplify Cache Records Outermost Results In Arenas", "[SimplifyCache][ExpressionArena]")
+{
+    const auto cache = std::make_shared<Oasis::SimplifyCache>();
+    Oasis::SimplifyCache::Install(cache);
+
+    const Oasis::Add inner { Oasis::Variable { "x" }, Oasis::Variable { "x" } };
+    const Oasis::Multiply outer { Oasis::Variable { "y" }, inner };
+
+    {
+        Oasis::ExpressionArena arena;
+        const auto simplified = outer.Copy()->Simplify();
+    }
+
+    REQUIRE(cache->Size() == 1);
+    REQUIRE(cache->Find(outer) != nullptr);
+    REQUIRE(cache->Find(inner) == nullptr);
+
+    Oasis::SimplifyCache::Install(nullptr);
+}
+
+TEST_CASE("Simplify Cache Is Kept Alive While Installed", "[SimplifyCache]")
+{
+    std::weak_ptr<Oasis::SimplifyCache> installed;
+
+    {
+        const auto cache = std::make_shared<Oasis::SimplifyCache>();
+        installed = cache;
+        Oasis::SimplifyCache::Install(cache);
+    }
+
+    REQUIRE(Oasis::SimplifyCache::Active() == installed.lock());
+
+    // A cache obtained from Active outlives its uninstallation.
+    const auto active = Oasis::SimplifyCache::Active();
+    REQUIRE(Oasis::SimplifyCache::Install(nullptr) == active);
+    REQUIRE(Oasis::SimplifyCache::Active() == nullptr);
+    REQUIRE(active->Size() == 0);
+
+    REQUIRE(!installed.expired());
+}
+
+TEST_CASE("Simplify Cache Distinguishes Operand Order", "[SimplifyCache]")
+{
+    const Oasis::Add xy { Oasis::Variable { "x" }, Oasis::Variable { "y" } };
+    const Oasis::Add yx { Oasis::Variable { "y" }, Oasis::Variable { "x" } };
+    const auto expected = yx.Simplify();
+
+    const auto cache = std::make_shared<Oasis::SimplifyCache>();
+    Oasis::SimplifyCache::Install(cache);
+
+    const auto first = xy.Simplify();
+    const std::size_t hits = cache->Hits();
+
+    const auto second = yx.Simplify();
+    REQUIRE(cache->Hits() == hits);
+    REQUIRE(second->Identical(*expected));
+
+    Oasis::SimplifyCache::Install(nullptr);
+}